@@ -291,11 +291,40 @@ struct GraphEditorPanel::PluginComponent final : public Component,
         g.setColour (boxColour);
         g.fillRect (boxArea.toFloat());
 
+        if (panel.areNodeTimingsShown())
+            paintTimingInfo (g, boxArea.removeFromBottom (timingInfoHeight));
+
         g.setColour (findColour (TextEditor::textColourId));
         g.setFont (font);
         g.drawFittedText (getName(), boxArea, Justification::centred, 2);
     }
 
+    void paintTimingInfo (Graphics& g, Rectangle<int> area)
+    {
+        auto text = String ("-");
+
+        if (timingInfo.has_value() && timingInfo->numBlocks > 0)
+        {
+            const auto load = jlimit (0.0, 1.0, timingInfo->averageLoad);
+
+            g.setColour (Colours::green.interpolatedWith (Colours::red, (float) jmin (1.0, load * 4.0)).withAlpha (0.6f));
+            g.fillRect (area.withWidth (roundToInt (area.getWidth() * load)));
+
+            text = String (timingInfo->averageMilliseconds, 2) + " / "
+                 + String (timingInfo->maxMilliseconds, 2) + " ms";
+        }
+
+        g.setColour (findColour (TextEditor::textColourId).withAlpha (0.8f));
+        g.setFont (Font (11.0f));
+        g.drawFittedText (text, area, Justification::centred, 1);
+    }
+
+    void setTimingInfo (std::optional<AudioProcessorGraph::NodeTimingInfo> newInfo)
+    {
+        timingInfo = newInfo;
+        repaint();
+    }
+
     void resized() override
     {
         if (auto f = graph.graph.getNodeForId (pluginID))
@@ -357,6 +386,9 @@ struct GraphEditorPanel::PluginComponent final : public Component,
         if (textWidth > 300)
             h = 100;
 
+        if (panel.areNodeTimingsShown())
+            h += timingInfoHeight;
+
         setSize (w, h);
         setName (processor.getName() + formatSuffix);
 
@@ -549,6 +581,8 @@ struct GraphEditorPanel::PluginComponent final : public Component,
     DropShadowEffect shadow;
     std::unique_ptr<PopupMenu> menu;
     std::unique_ptr<FileChooser> fileChooser;
+    std::optional<AudioProcessorGraph::NodeTimingInfo> timingInfo;
+    static constexpr int timingInfoHeight = 14;
     const String formatSuffix = getFormatSuffix (getProcessor());
 };
 
@@ -749,6 +783,41 @@ struct GraphEditorPanel::ConnectorComponent final : public Component,
 };
 
 
+//==============================================================================
+/*  While this exists, the graph times each of its nodes, and the results are displayed
+    underneath each node's name.
+    The measurements are restarted after each update, so the figures shown are the average
+    and worst-case times for each node over the last half-second.
+*/
+struct GraphEditorPanel::NodeTimingUpdater final : private Timer
+{
+    explicit NodeTimingUpdater (GraphEditorPanel& p)  : panel (p)
+    {
+        panel.graph.graph.setNodeTimingEnabled (true);
+        startTimer (500);
+    }
+
+    ~NodeTimingUpdater() override
+    {
+        stopTimer();
+        panel.graph.graph.setNodeTimingEnabled (false);
+    }
+
+    void timerCallback() override
+    {
+        auto& audioGraph = panel.graph.graph;
+
+        for (auto* fc : panel.nodes)
+            fc->setTimingInfo (audioGraph.getNodeTimingInfo (fc->pluginID));
+
+        audioGraph.resetNodeTimingInfo();
+    }
+
+    GraphEditorPanel& panel;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (NodeTimingUpdater)
+};
+
 //==============================================================================
 GraphEditorPanel::GraphEditorPanel (PluginGraph& g)  : graph (g)
 {
@@ -759,6 +828,7 @@ GraphEditorPanel::GraphEditorPanel (PluginGraph& g)  : graph (g)
 GraphEditorPanel::~GraphEditorPanel()
 {
     graph.removeChangeListener (this);
+    nodeTimingUpdater = nullptr;
     draggingConnector = nullptr;
     nodes.clear();
     connectors.clear();
@@ -901,6 +971,22 @@ void GraphEditorPanel::showPopupMenu (Point<int> mousePos)
     }
 }
 
+void GraphEditorPanel::setNodeTimingsShown (bool shouldBeShown)
+{
+    if (shouldBeShown == areNodeTimingsShown())
+        return;
+
+    if (shouldBeShown)
+        nodeTimingUpdater = std::make_unique<NodeTimingUpdater> (*this);
+    else
+        nodeTimingUpdater = nullptr;
+
+    for (auto* fc : nodes)
+        fc->setTimingInfo ({});
+
+    updateComponents();
+}
+
 void GraphEditorPanel::beginConnectorDrag (AudioProcessorGraph::NodeAndChannel source,
                                            AudioProcessorGraph::NodeAndChannel dest,
                                            const MouseEvent& e)
@@ -1212,6 +1298,8 @@ GraphDocumentComponent::GraphDocumentComponent (AudioPluginFormatManager& fm,
 {
     init();
 
+    setNodeTimingsShown (getAppProperties().getUserSettings()->getBoolValue ("showNodeTimings", false));
+
     deviceManager.addChangeListener (graphPanel.get());
     deviceManager.addAudioCallback (&graphPlayer);
     deviceManager.addMidiInputDeviceCallback ({}, &graphPlayer.getMidiMessageCollector());
@@ -1375,6 +1463,12 @@ void GraphDocumentComponent::setDoublePrecision (bool doublePrecision)
     graphPlayer.setDoublePrecisionProcessing (doublePrecision);
 }
 
+void GraphDocumentComponent::setNodeTimingsShown (bool shouldBeShown)
+{
+    if (graphPanel != nullptr)
+        graphPanel->setNodeTimingsShown (shouldBeShown);
+}
+
 bool GraphDocumentComponent::closeAnyOpenPluginWindows()
 {
     return graphPanel->graph.closeAnyOpenPluginWindows();
@@ -59,6 +59,10 @@ public:
     //==============================================================================
     void showPopupMenu (Point<int> position);
 
+    //==============================================================================
+    void setNodeTimingsShown (bool shouldBeShown);
+    bool areNodeTimingsShown() const noexcept       { return nodeTimingUpdater != nullptr; }
+
     //==============================================================================
     void beginConnectorDrag (AudioProcessorGraph::NodeAndChannel source,
                              AudioProcessorGraph::NodeAndChannel dest,
@@ -73,11 +77,13 @@ private:
     struct PluginComponent;
     struct ConnectorComponent;
     struct PinComponent;
+    struct NodeTimingUpdater;
 
     OwnedArray<PluginComponent> nodes;
     OwnedArray<ConnectorComponent> connectors;
     std::unique_ptr<ConnectorComponent> draggingConnector;
     std::unique_ptr<PopupMenu> menu;
+    std::unique_ptr<NodeTimingUpdater> nodeTimingUpdater;
 
     PluginComponent* getComponentForPlugin (AudioProcessorGraph::NodeID) const;
     ConnectorComponent* getComponentForConnection (const AudioProcessorGraph::Connection&) const;
@@ -113,6 +119,7 @@ public:
     //==============================================================================
     void createNewPlugin (const PluginDescriptionAndPreference&, Point<int> position);
     void setDoublePrecision (bool doublePrecision);
+    void setNodeTimingsShown (bool shouldBeShown);
     bool closeAnyOpenPluginWindows();
 
     //==============================================================================
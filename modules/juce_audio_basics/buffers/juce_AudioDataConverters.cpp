@@ -450,6 +450,658 @@ void AudioDataConverters::deinterleaveSamples (const float* source, float** dest
                                     numSamples);
 }
 
+//==============================================================================
+namespace VectorisedConversionHelpers
+{
+    using PackedFormat   = AudioData::VectorisedConversion::PackedFormat;
+    using InstructionSet = AudioData::VectorisedConversion::InstructionSet;
+
+    static int getBytesPerSample (PackedFormat format) noexcept
+    {
+        switch (format)
+        {
+            case PackedFormat::int16Bit:    return 2;
+            case PackedFormat::int24Bit:    return 3;
+            case PackedFormat::int32Bit:
+            case PackedFormat::float32Bit:  return 4;
+            case PackedFormat::unsupported: break;
+        }
+
+        return 0;
+    }
+
+    /*  Describes how to gather four samples into the 32-bit lanes of a vector with byte
+        shuffles. Each sample's bytes end up at the top of its lane, so that shorter formats
+        are scaled to the full 32-bit range in the same way that getAsInt32() does it. If the
+        four samples span more than 16 bytes, they're fetched with two loads of two samples.
+    */
+    struct GatherPlan
+    {
+        bool prepare (PackedFormat format, bool bigEndian, int strideInSamples) noexcept
+        {
+            bytesPerSample = getBytesPerSample (format);
+            stride = bytesPerSample * strideInSamples;
+            isFloat = format == PackedFormat::float32Bit;
+
+            if (bytesPerSample == 0 || strideInSamples <= 0)
+                return false;
+
+            if (3 * stride + bytesPerSample <= 16)
+                samplesPerLoad = 4;
+            else if (stride + bytesPerSample <= 16)
+                samplesPerLoad = 2;
+            else
+                return false;
+
+            for (int i = 0; i < 16; ++i)
+                masks[0][i] = masks[1][i] = 0x80;
+
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                for (int i = 0; i < bytesPerSample; ++i)
+                {
+                    const auto sourceByte = (lane % samplesPerLoad) * stride + (bigEndian ? bytesPerSample - 1 - i : i);
+                    masks[lane / samplesPerLoad][lane * 4 + 4 - bytesPerSample + i] = (uint8) sourceByte;
+                }
+            }
+
+            return true;
+        }
+
+        // The number of bytes that are read when a group of four samples is fetched
+        int getNumBytesRead() const noexcept        { return samplesPerLoad == 4 ? 16 : 2 * stride + 16; }
+
+        // The number of samples that can be fetched in blocks of blockSize without
+        // reading beyond the end of the last sample
+        int getNumSafeSamples (int numSamples, int blockSize) const noexcept
+        {
+            const auto extent = (int64) (numSamples - 1) * stride + bytesPerSample;
+            auto num = numSamples - numSamples % blockSize;
+
+            while (num > 0 && (int64) (num - 4) * stride + getNumBytesRead() > extent)
+                num -= blockSize;
+
+            return num;
+        }
+
+        alignas (16) uint8 masks[2][16];
+        int bytesPerSample = 0, stride = 0, samplesPerLoad = 0;
+        bool isFloat = false;
+    };
+
+    /*  Describes how to pack four 32-bit lanes into consecutive samples with a byte shuffle,
+        keeping the top bytes of each lane in the same way that setAsInt32() does it.
+    */
+    struct PackPlan
+    {
+        bool prepare (PackedFormat packedFormat, bool bigEndian) noexcept
+        {
+            format = packedFormat;
+            bytesPerSample = getBytesPerSample (format);
+
+            if (bytesPerSample == 0)
+                return false;
+
+            for (int i = 0; i < 16; ++i)
+                mask[i] = 0x80;
+
+            for (int i = 0; i < 4 * bytesPerSample; ++i)
+            {
+                const auto byteInSample = i % bytesPerSample;
+                mask[i] = (uint8) ((i / bytesPerSample) * 4 + 4 - bytesPerSample
+                                     + (bigEndian ? bytesPerSample - 1 - byteInSample : byteInSample));
+            }
+
+            return true;
+        }
+
+        alignas (16) uint8 mask[16];
+        PackedFormat format = PackedFormat::unsupported;
+        int bytesPerSample = 0;
+    };
+
+    //==============================================================================
+    static inline uint32 nextDitherState (uint32 s) noexcept
+    {
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+        return s;
+    }
+
+    // The reference version of the dither kernels, which the vectorised ones must match exactly
+    static void ditherScalar (uint32* state, const float* source, int32* dest, int numSamples, float scale, int shift) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto& s = state[i % AudioData::TPDFDither::numLanes];
+            s = nextDitherState (s);
+
+            const auto noise = (float) ((int32) (int16) (s & 0xffff) + ((int32) s >> 16)) * (1.0f / 65536.0f);
+            const auto value = jlimit (-scale, scale - 1.0f, source[i] * scale + noise);
+            dest[i] = (int32) ((uint32) roundToInt (value) << shift);
+        }
+    }
+
+    static void ditherBlocksScalar (uint32* state, const float* source, int32* dest, int numBlocks, float scale, int shift) noexcept
+    {
+        ditherScalar (state, source, dest, numBlocks * AudioData::TPDFDither::numLanes, scale, shift);
+    }
+
+    //==============================================================================
+    struct Kernels
+    {
+        InstructionSet instructionSet;
+        int (*gather) (const GatherPlan&, const uint8*, void*, bool toFloat, int numSamples) noexcept;
+        int (*pack) (const PackPlan&, const void* const*, bool fromFloat, int numChannels, uint8*, int numSamples) noexcept;
+        void (*ditherBlocks) (uint32*, const float*, int32*, int numBlocks, float scale, int shift) noexcept;
+    };
+
+    static int gatherNone (const GatherPlan&, const uint8*, void*, bool, int) noexcept                 { return 0; }
+    static int packNone (const PackPlan&, const void* const*, bool, int, uint8*, int) noexcept         { return 0; }
+
+    static constexpr Kernels scalarKernels { InstructionSet::none, gatherNone, packNone, ditherBlocksScalar };
+
+    //==============================================================================
+   #if JUCE_USE_SSE_INTRINSICS
+    #if JUCE_GCC || JUCE_CLANG
+     #define JUCE_VECTORISED_CONVERSION_TARGET(instructionSet)  __attribute__ ((target (instructionSet)))
+    #else
+     #define JUCE_VECTORISED_CONVERSION_TARGET(instructionSet)
+    #endif
+
+    static inline void storeBytes (uint8* dest, __m128i v, int numBytes) noexcept
+    {
+        if (numBytes == 16)
+        {
+            _mm_storeu_si128 ((__m128i*) dest, v);
+            return;
+        }
+
+        _mm_storel_epi64 ((__m128i*) dest, v);
+
+        if (numBytes == 12)
+        {
+            const auto top = _mm_cvtsi128_si32 (_mm_srli_si128 (v, 8));
+            memcpy (dest + 8, &top, 4);
+        }
+    }
+
+    static void ditherBlocksSse2 (uint32* state, const float* source, int32* dest, int numBlocks, float scale, int shift) noexcept
+    {
+        __m128i states[] = { _mm_loadu_si128 ((const __m128i*) state), _mm_loadu_si128 ((const __m128i*) (state + 4)) };
+        const auto scaleVec = _mm_set1_ps (scale), minVec = _mm_set1_ps (-scale), maxVec = _mm_set1_ps (scale - 1.0f);
+        const auto noiseScale = _mm_set1_ps (1.0f / 65536.0f);
+        const auto shiftCount = _mm_cvtsi32_si128 (shift);
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            for (auto& s : states)
+            {
+                s = _mm_xor_si128 (s, _mm_slli_epi32 (s, 13));
+                s = _mm_xor_si128 (s, _mm_srli_epi32 (s, 17));
+                s = _mm_xor_si128 (s, _mm_slli_epi32 (s, 5));
+
+                const auto noise = _mm_mul_ps (_mm_cvtepi32_ps (_mm_add_epi32 (_mm_srai_epi32 (_mm_slli_epi32 (s, 16), 16),
+                                                                               _mm_srai_epi32 (s, 16))),
+                                               noiseScale);
+
+                const auto value = _mm_add_ps (_mm_mul_ps (_mm_loadu_ps (source), scaleVec), noise);
+                const auto clipped = _mm_min_ps (_mm_max_ps (value, minVec), maxVec);
+                _mm_storeu_si128 ((__m128i*) dest, _mm_sll_epi32 (_mm_cvtps_epi32 (clipped), shiftCount));
+
+                source += 4;
+                dest += 4;
+            }
+        }
+
+        _mm_storeu_si128 ((__m128i*) state, states[0]);
+        _mm_storeu_si128 ((__m128i*) (state + 4), states[1]);
+    }
+
+    //==============================================================================
+    JUCE_VECTORISED_CONVERSION_TARGET ("ssse3")
+    static inline __m128i gatherFourSsse3 (const uint8* source, int secondLoadOffset, __m128i mask0, __m128i mask1) noexcept
+    {
+        const auto v = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) source), mask0);
+
+        if (secondLoadOffset == 0)
+            return v;
+
+        return _mm_or_si128 (v, _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) (source + secondLoadOffset)), mask1));
+    }
+
+    JUCE_VECTORISED_CONVERSION_TARGET ("ssse3")
+    static int gatherSsse3 (const GatherPlan& plan, const uint8* source, void* dest, bool toFloat, int numSamples) noexcept
+    {
+        const auto numToDo = plan.getNumSafeSamples (numSamples, 4);
+        const auto mask0 = _mm_load_si128 ((const __m128i*) plan.masks[0]);
+        const auto mask1 = _mm_load_si128 ((const __m128i*) plan.masks[1]);
+        const auto secondLoadOffset = plan.samplesPerLoad == 2 ? 2 * plan.stride : 0;
+        const auto scale = _mm_set1_ps ((float) (1.0 / 2147483648.0));
+
+        if (toFloat && ! plan.isFloat)
+        {
+            for (int i = 0; i < numToDo; i += 4, source += 4 * plan.stride)
+                _mm_storeu_ps (static_cast<float*> (dest) + i,
+                               _mm_mul_ps (_mm_cvtepi32_ps (gatherFourSsse3 (source, secondLoadOffset, mask0, mask1)), scale));
+        }
+        else
+        {
+            for (int i = 0; i < numToDo; i += 4, source += 4 * plan.stride)
+                _mm_storeu_si128 ((__m128i*) (static_cast<int32*> (dest) + i),
+                                  gatherFourSsse3 (source, secondLoadOffset, mask0, mask1));
+        }
+
+        return numToDo;
+    }
+
+    JUCE_VECTORISED_CONVERSION_TARGET ("ssse3")
+    static inline __m128i loadLanesSsse3 (const PackPlan& plan, const void* source, bool fromFloat) noexcept
+    {
+        if (! fromFloat)
+        {
+            const auto v = _mm_loadu_si128 ((const __m128i*) source);
+
+            if (plan.format == PackedFormat::float32Bit)
+                return _mm_castps_si128 (_mm_mul_ps (_mm_cvtepi32_ps (v), _mm_set1_ps ((float) (1.0 / 2147483648.0))));
+
+            return v;
+        }
+
+        const auto v = _mm_loadu_ps ((const float*) source);
+
+        if (plan.format == PackedFormat::float32Bit)
+            return _mm_castps_si128 (v);
+
+        // Float32::getAsInt32() scales in double precision, so this has to as well
+        const auto clipped = _mm_min_ps (_mm_max_ps (v, _mm_set1_ps (-1.0f)), _mm_set1_ps (1.0f));
+        const auto scale = _mm_set1_pd ((double) std::numeric_limits<int32>::max());
+        const auto low  = _mm_cvtpd_epi32 (_mm_mul_pd (_mm_cvtps_pd (clipped), scale));
+        const auto high = _mm_cvtpd_epi32 (_mm_mul_pd (_mm_cvtps_pd (_mm_movehl_ps (clipped, clipped)), scale));
+
+        return _mm_unpacklo_epi64 (low, high);
+    }
+
+    JUCE_VECTORISED_CONVERSION_TARGET ("ssse3")
+    static int packSsse3 (const PackPlan& plan, const void* const* sources, bool fromFloat, int numChannels, uint8* dest, int numSamples) noexcept
+    {
+        const auto mask = _mm_load_si128 ((const __m128i*) plan.mask);
+        const auto numBytes = 4 * plan.bytesPerSample;
+        const auto numToDo = numSamples & ~3;
+
+        if (numChannels == 1)
+        {
+            for (int i = 0; i < numToDo; i += 4, dest += numBytes)
+                storeBytes (dest, _mm_shuffle_epi8 (loadLanesSsse3 (plan, addBytesToPointer (sources[0], 4 * i), fromFloat), mask), numBytes);
+
+            return numToDo;
+        }
+
+        if (numChannels == 2)
+        {
+            for (int i = 0; i < numToDo; i += 4, dest += 2 * numBytes)
+            {
+                const auto left  = loadLanesSsse3 (plan, addBytesToPointer (sources[0], 4 * i), fromFloat);
+                const auto right = loadLanesSsse3 (plan, addBytesToPointer (sources[1], 4 * i), fromFloat);
+
+                storeBytes (dest,            _mm_shuffle_epi8 (_mm_unpacklo_epi32 (left, right), mask), numBytes);
+                storeBytes (dest + numBytes, _mm_shuffle_epi8 (_mm_unpackhi_epi32 (left, right), mask), numBytes);
+            }
+
+            return numToDo;
+        }
+
+        return 0;
+    }
+
+    //==============================================================================
+    JUCE_VECTORISED_CONVERSION_TARGET ("avx2")
+    static inline __m256i loadPairAvx2 (const uint8* source, int offset) noexcept
+    {
+        return _mm256_inserti128_si256 (_mm256_castsi128_si256 (_mm_loadu_si128 ((const __m128i*) source)),
+                                        _mm_loadu_si128 ((const __m128i*) (source + offset)), 1);
+    }
+
+    JUCE_VECTORISED_CONVERSION_TARGET ("avx2")
+    static inline __m256i gatherEightAvx2 (const uint8* source, int groupSize, int secondLoadOffset, __m256i mask0, __m256i mask1) noexcept
+    {
+        const auto v = _mm256_shuffle_epi8 (loadPairAvx2 (source, groupSize), mask0);
+
+        if (secondLoadOffset == 0)
+            return v;
+
+        return _mm256_or_si256 (v, _mm256_shuffle_epi8 (loadPairAvx2 (source + secondLoadOffset, groupSize), mask1));
+    }
+
+    JUCE_VECTORISED_CONVERSION_TARGET ("avx2")
+    static int gatherAvx2 (const GatherPlan& plan, const uint8* source, void* dest, bool toFloat, int numSamples) noexcept
+    {
+        const auto numToDo = plan.getNumSafeSamples (numSamples, 8);
+        const auto mask0 = _mm256_broadcastsi128_si256 (_mm_load_si128 ((const __m128i*) plan.masks[0]));
+        const auto mask1 = _mm256_broadcastsi128_si256 (_mm_load_si128 ((const __m128i*) plan.masks[1]));
+        const auto secondLoadOffset = plan.samplesPerLoad == 2 ? 2 * plan.stride : 0;
+        const auto groupSize = 4 * plan.stride;
+        const auto scale = _mm256_set1_ps ((float) (1.0 / 2147483648.0));
+
+        if (toFloat && ! plan.isFloat)
+        {
+            for (int i = 0; i < numToDo; i += 8, source += 2 * groupSize)
+                _mm256_storeu_ps (static_cast<float*> (dest) + i,
+                                  _mm256_mul_ps (_mm256_cvtepi32_ps (gatherEightAvx2 (source, groupSize, secondLoadOffset, mask0, mask1)), scale));
+        }
+        else
+        {
+            for (int i = 0; i < numToDo; i += 8, source += 2 * groupSize)
+                _mm256_storeu_si256 ((__m256i*) (static_cast<int32*> (dest) + i),
+                                     gatherEightAvx2 (source, groupSize, secondLoadOffset, mask0, mask1));
+        }
+
+        return numToDo + gatherSsse3 (plan, source, static_cast<char*> (dest) + 4 * numToDo, toFloat, numSamples - numToDo);
+    }
+
+    static constexpr Kernels ssse3Kernels { InstructionSet::ssse3, gatherSsse3, packSsse3, ditherBlocksSse2 };
+    static constexpr Kernels avx2Kernels  { InstructionSet::avx2,  gatherAvx2,  packSsse3, ditherBlocksSse2 };
+
+    #undef JUCE_VECTORISED_CONVERSION_TARGET
+   #endif
+
+    //==============================================================================
+   #if JUCE_ARM && JUCE_64BIT
+    static inline void storeBytes (uint8* dest, uint8x16_t v, int numBytes) noexcept
+    {
+        if (numBytes == 16)
+        {
+            vst1q_u8 (dest, v);
+            return;
+        }
+
+        vst1_u8 (dest, vget_low_u8 (v));
+
+        if (numBytes == 12)
+        {
+            const auto top = vgetq_lane_u32 (vreinterpretq_u32_u8 (v), 2);
+            memcpy (dest + 8, &top, 4);
+        }
+    }
+
+    static void ditherBlocksNeon (uint32* state, const float* source, int32* dest, int numBlocks, float scale, int shift) noexcept
+    {
+        uint32x4_t states[] = { vld1q_u32 (state), vld1q_u32 (state + 4) };
+        const auto minVec = vdupq_n_f32 (-scale), maxVec = vdupq_n_f32 (scale - 1.0f);
+        const auto shiftVec = vdupq_n_s32 (shift);
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            for (auto& s : states)
+            {
+                s = veorq_u32 (s, vshlq_n_u32 (s, 13));
+                s = veorq_u32 (s, vshrq_n_u32 (s, 17));
+                s = veorq_u32 (s, vshlq_n_u32 (s, 5));
+
+                const auto bits = vreinterpretq_s32_u32 (s);
+                const auto noise = vmulq_n_f32 (vcvtq_f32_s32 (vaddq_s32 (vshrq_n_s32 (vshlq_n_s32 (bits, 16), 16),
+                                                                          vshrq_n_s32 (bits, 16))),
+                                                1.0f / 65536.0f);
+
+                const auto value = vaddq_f32 (vmulq_n_f32 (vld1q_f32 (source), scale), noise);
+                const auto clipped = vminq_f32 (vmaxq_f32 (value, minVec), maxVec);
+                vst1q_s32 (dest, vshlq_s32 (vcvtnq_s32_f32 (clipped), shiftVec));
+
+                source += 4;
+                dest += 4;
+            }
+        }
+
+        vst1q_u32 (state, states[0]);
+        vst1q_u32 (state + 4, states[1]);
+    }
+
+    static inline int32x4_t gatherFourNeon (const uint8* source, int secondLoadOffset, uint8x16_t mask0, uint8x16_t mask1) noexcept
+    {
+        auto v = vqtbl1q_u8 (vld1q_u8 (source), mask0);
+
+        if (secondLoadOffset != 0)
+            v = vorrq_u8 (v, vqtbl1q_u8 (vld1q_u8 (source + secondLoadOffset), mask1));
+
+        return vreinterpretq_s32_u8 (v);
+    }
+
+    static int gatherNeon (const GatherPlan& plan, const uint8* source, void* dest, bool toFloat, int numSamples) noexcept
+    {
+        const auto numToDo = plan.getNumSafeSamples (numSamples, 4);
+        const auto mask0 = vld1q_u8 (plan.masks[0]);
+        const auto mask1 = vld1q_u8 (plan.masks[1]);
+        const auto secondLoadOffset = plan.samplesPerLoad == 2 ? 2 * plan.stride : 0;
+
+        if (toFloat && ! plan.isFloat)
+        {
+            for (int i = 0; i < numToDo; i += 4, source += 4 * plan.stride)
+                vst1q_f32 (static_cast<float*> (dest) + i,
+                           vmulq_n_f32 (vcvtq_f32_s32 (gatherFourNeon (source, secondLoadOffset, mask0, mask1)), (float) (1.0 / 2147483648.0)));
+        }
+        else
+        {
+            for (int i = 0; i < numToDo; i += 4, source += 4 * plan.stride)
+                vst1q_s32 (static_cast<int32*> (dest) + i, gatherFourNeon (source, secondLoadOffset, mask0, mask1));
+        }
+
+        return numToDo;
+    }
+
+    static inline int32x4_t loadLanesNeon (const PackPlan& plan, const void* source, bool fromFloat) noexcept
+    {
+        if (! fromFloat)
+        {
+            const auto v = vld1q_s32 ((const int32*) source);
+
+            if (plan.format == PackedFormat::float32Bit)
+                return vreinterpretq_s32_f32 (vmulq_n_f32 (vcvtq_f32_s32 (v), (float) (1.0 / 2147483648.0)));
+
+            return v;
+        }
+
+        const auto v = vld1q_f32 ((const float*) source);
+
+        if (plan.format == PackedFormat::float32Bit)
+            return vreinterpretq_s32_f32 (v);
+
+        // Float32::getAsInt32() scales in double precision, so this has to as well
+        const auto clipped = vminq_f32 (vmaxq_f32 (v, vdupq_n_f32 (-1.0f)), vdupq_n_f32 (1.0f));
+        const auto scale = (double) std::numeric_limits<int32>::max();
+        const auto low  = vcvtnq_s64_f64 (vmulq_n_f64 (vcvt_f64_f32 (vget_low_f32 (clipped)), scale));
+        const auto high = vcvtnq_s64_f64 (vmulq_n_f64 (vcvt_high_f64_f32 (clipped), scale));
+
+        return vcombine_s32 (vmovn_s64 (low), vmovn_s64 (high));
+    }
+
+    static int packNeon (const PackPlan& plan, const void* const* sources, bool fromFloat, int numChannels, uint8* dest, int numSamples) noexcept
+    {
+        const auto mask = vld1q_u8 (plan.mask);
+        const auto numBytes = 4 * plan.bytesPerSample;
+        const auto numToDo = numSamples & ~3;
+
+        if (numChannels == 1)
+        {
+            for (int i = 0; i < numToDo; i += 4, dest += numBytes)
+                storeBytes (dest, vqtbl1q_u8 (vreinterpretq_u8_s32 (loadLanesNeon (plan, addBytesToPointer (sources[0], 4 * i), fromFloat)), mask), numBytes);
+
+            return numToDo;
+        }
+
+        if (numChannels == 2)
+        {
+            for (int i = 0; i < numToDo; i += 4, dest += 2 * numBytes)
+            {
+                const auto left  = loadLanesNeon (plan, addBytesToPointer (sources[0], 4 * i), fromFloat);
+                const auto right = loadLanesNeon (plan, addBytesToPointer (sources[1], 4 * i), fromFloat);
+
+                storeBytes (dest,            vqtbl1q_u8 (vreinterpretq_u8_s32 (vzip1q_s32 (left, right)), mask), numBytes);
+                storeBytes (dest + numBytes, vqtbl1q_u8 (vreinterpretq_u8_s32 (vzip2q_s32 (left, right)), mask), numBytes);
+            }
+
+            return numToDo;
+        }
+
+        return 0;
+    }
+
+    static constexpr Kernels neonKernels { InstructionSet::neon, gatherNeon, packNeon, ditherBlocksNeon };
+   #endif
+
+    //==============================================================================
+    static const Kernels* getKernelsFor (InstructionSet instructionSet) noexcept
+    {
+        switch (instructionSet)
+        {
+           #if JUCE_USE_SSE_INTRINSICS
+            case InstructionSet::ssse3:  return SystemStats::hasSSSE3() ? &ssse3Kernels : nullptr;
+            case InstructionSet::avx2:   return SystemStats::hasSSSE3() && SystemStats::hasAVX2() ? &avx2Kernels : nullptr;
+           #else
+            case InstructionSet::ssse3:
+            case InstructionSet::avx2:   return nullptr;
+           #endif
+
+           #if JUCE_ARM && JUCE_64BIT
+            case InstructionSet::neon:   return &neonKernels;
+           #else
+            case InstructionSet::neon:   return nullptr;
+           #endif
+
+            case InstructionSet::none:   break;
+        }
+
+        return &scalarKernels;
+    }
+
+    static const Kernels* getBestKernels() noexcept
+    {
+        for (auto instructionSet : { InstructionSet::avx2, InstructionSet::ssse3, InstructionSet::neon })
+            if (auto* kernels = getKernelsFor (instructionSet))
+                return kernels;
+
+        return &scalarKernels;
+    }
+
+    static std::atomic<const Kernels*>& getCurrentKernels() noexcept
+    {
+        static std::atomic<const Kernels*> current { getBestKernels() };
+        return current;
+    }
+
+    static const Kernels& getKernels() noexcept
+    {
+        return *getCurrentKernels().load (std::memory_order_relaxed);
+    }
+
+    static int convertToPacked (PackedFormat destFormat, bool destIsBigEndian, const void* const* sources, bool fromFloat,
+                                int numChannels, void* dest, int numSamples) noexcept
+    {
+        PackPlan plan;
+
+        if (numSamples <= 0 || ! plan.prepare (destFormat, destIsBigEndian))
+            return 0;
+
+        return getKernels().pack (plan, sources, fromFloat, numChannels, static_cast<uint8*> (dest), numSamples);
+    }
+
+    static int convertFromPacked (PackedFormat sourceFormat, bool sourceIsBigEndian, const void* source, int sourceStride,
+                                  void* dest, bool toFloat, int numSamples) noexcept
+    {
+        GatherPlan plan;
+
+        if (numSamples <= 0 || ! plan.prepare (sourceFormat, sourceIsBigEndian, sourceStride))
+            return 0;
+
+        return getKernels().gather (plan, static_cast<const uint8*> (source), dest, toFloat, numSamples);
+    }
+}
+
+int AudioData::VectorisedConversion::packedToInt32 (PackedFormat sourceFormat, bool sourceIsBigEndian,
+                                                    const void* source, int sourceStride,
+                                                    int32* dest, int numSamples) noexcept
+{
+    if (sourceFormat == PackedFormat::float32Bit)
+        return 0;
+
+    return VectorisedConversionHelpers::convertFromPacked (sourceFormat, sourceIsBigEndian, source, sourceStride, dest, false, numSamples);
+}
+
+int AudioData::VectorisedConversion::packedToFloat (PackedFormat sourceFormat, bool sourceIsBigEndian,
+                                                    const void* source, int sourceStride,
+                                                    float* dest, int numSamples) noexcept
+{
+    return VectorisedConversionHelpers::convertFromPacked (sourceFormat, sourceIsBigEndian, source, sourceStride, dest, true, numSamples);
+}
+
+int AudioData::VectorisedConversion::int32ToPacked (PackedFormat destFormat, bool destIsBigEndian,
+                                                    const int32* const* sources, int numChannels,
+                                                    void* dest, int numSamples) noexcept
+{
+    return VectorisedConversionHelpers::convertToPacked (destFormat, destIsBigEndian, reinterpret_cast<const void* const*> (sources),
+                                                         false, numChannels, dest, numSamples);
+}
+
+int AudioData::VectorisedConversion::floatToPacked (PackedFormat destFormat, bool destIsBigEndian,
+                                                    const float* const* sources, int numChannels,
+                                                    void* dest, int numSamples) noexcept
+{
+    return VectorisedConversionHelpers::convertToPacked (destFormat, destIsBigEndian, reinterpret_cast<const void* const*> (sources),
+                                                         true, numChannels, dest, numSamples);
+}
+
+AudioData::VectorisedConversion::InstructionSet AudioData::VectorisedConversion::getInstructionSet() noexcept
+{
+    return VectorisedConversionHelpers::getKernels().instructionSet;
+}
+
+bool AudioData::VectorisedConversion::setInstructionSet (InstructionSet instructionSet) noexcept
+{
+    if (auto* kernels = VectorisedConversionHelpers::getKernelsFor (instructionSet))
+    {
+        VectorisedConversionHelpers::getCurrentKernels() = kernels;
+        return true;
+    }
+
+    return false;
+}
+
+bool AudioData::VectorisedConversion::isSupported (InstructionSet instructionSet) noexcept
+{
+    return VectorisedConversionHelpers::getKernelsFor (instructionSet) != nullptr;
+}
+
+//==============================================================================
+AudioData::TPDFDither::TPDFDither (uint32 seed) noexcept
+{
+    reset (seed);
+}
+
+void AudioData::TPDFDither::reset (uint32 seed) noexcept
+{
+    for (int i = 0; i < numLanes; ++i)
+    {
+        // spread the seed across the lanes, making sure none of them ends up stuck at zero
+        auto s = (seed + (uint32) i * 0x9e3779b9u) * 0x85ebca6bu;
+        s ^= s >> 13;
+        state[i] = s != 0 ? s : 0x2545f491u + (uint32) i;
+    }
+}
+
+void AudioData::TPDFDither::convertFloatToInt32 (const float* source, int32* dest, int numSamples, int bitDepth) noexcept
+{
+    jassert (bitDepth >= 2 && bitDepth <= 24);
+    bitDepth = jlimit (2, 24, bitDepth);
+
+    const auto scale = (float) (1 << (bitDepth - 1));
+    const auto numBlocks = jmax (0, numSamples) / numLanes;
+
+    VectorisedConversionHelpers::getKernels().ditherBlocks (state, source, dest, numBlocks, scale, 32 - bitDepth);
+
+    const auto numDone = numBlocks * numLanes;
+    VectorisedConversionHelpers::ditherScalar (state, source + numDone, dest + numDone, numSamples - numDone, scale, 32 - bitDepth);
+}
+
 //==============================================================================
 //==============================================================================
 #if JUCE_UNIT_TESTS
@@ -627,6 +1279,310 @@ public:
 
 static AudioConversionTests audioConversionUnitTests;
 
+//==============================================================================
+class AudioDataVectorisedConversionTests final : public UnitTest
+{
+public:
+    AudioDataVectorisedConversionTests()
+        : UnitTest ("Audio data vectorised conversion", UnitTestCategories::audio)
+    {}
+
+    using VectorisedConversion = AudioData::VectorisedConversion;
+    using InstructionSet = VectorisedConversion::InstructionSet;
+
+    static String getName (InstructionSet instructionSet)
+    {
+        switch (instructionSet)
+        {
+            case InstructionSet::ssse3: return "SSSE3";
+            case InstructionSet::avx2:  return "AVX2";
+            case InstructionSet::neon:  return "NEON";
+            case InstructionSet::none:  break;
+        }
+
+        return "scalar";
+    }
+
+    static Array<InstructionSet> getSupportedInstructionSets()
+    {
+        Array<InstructionSet> result;
+
+        for (auto instructionSet : { InstructionSet::none, InstructionSet::ssse3, InstructionSet::avx2, InstructionSet::neon })
+            if (VectorisedConversion::isSupported (instructionSet))
+                result.add (instructionSet);
+
+        return result;
+    }
+
+    template <typename SampleFormat>
+    static void fillWithRandomSamples (HeapBlock<char>& block, size_t numBytes, Random& r)
+    {
+        block.allocate (numBytes, false);
+
+        if constexpr (std::is_same_v<SampleFormat, AudioData::Float32>)
+        {
+            for (size_t i = 0; i < numBytes / sizeof (float); ++i)
+                reinterpret_cast<float*> (block.get())[i] = r.nextFloat() * 3.0f - 1.5f;
+        }
+        else
+        {
+            for (size_t i = 0; i < numBytes; ++i)
+                block[i] = (char) r.nextInt (256);
+        }
+    }
+
+    template <typename SampleFormat, typename Endianness>
+    void testDeinterleaving (Random& r)
+    {
+        using Source = AudioData::Pointer<SampleFormat, Endianness, AudioData::Interleaved, AudioData::Const>;
+        using IntDest = AudioData::Pointer<AudioData::Int32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::NonConst>;
+        using FloatDest = AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::NonConst>;
+
+        for (auto numChannels : { 1, 2, 3, 4, 6, 8 })
+        {
+            for (auto numSamples : { 1, 3, 8, 13, 100, 1031 })
+            {
+                HeapBlock<char> sourceData;
+                fillWithRandomSamples<SampleFormat> (sourceData, (size_t) (numChannels * numSamples * Source::getBytesPerSample()), r);
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    const Source source (sourceData + channel * Source::getBytesPerSample(), numChannels);
+                    std::vector<int32> ints ((size_t) numSamples), expectedInts ((size_t) numSamples);
+                    std::vector<float> floats ((size_t) numSamples), expectedFloats ((size_t) numSamples);
+
+                    auto s = source;
+
+                    for (int i = 0; i < numSamples; ++i, ++s)
+                    {
+                        expectedInts[(size_t) i] = s.getAsInt32();
+                        expectedFloats[(size_t) i] = s.getAsFloat();
+                    }
+
+                    IntDest (ints.data()).convertSamples (source, numSamples);
+                    FloatDest (floats.data()).convertSamples (source, numSamples);
+
+                    expect (ints == expectedInts);
+                    expect (memcmp (floats.data(), expectedFloats.data(), floats.size() * sizeof (float)) == 0);
+                }
+            }
+        }
+    }
+
+    template <typename SampleFormat, typename Endianness>
+    void testInterleaving (Random& r)
+    {
+        using Dest = AudioData::Pointer<SampleFormat, Endianness, AudioData::Interleaved, AudioData::NonConst>;
+        using IntSource = AudioData::Pointer<AudioData::Int32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::Const>;
+        using FloatSource = AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::Const>;
+
+        constexpr auto format = VectorisedConversion::getPackedFormat<SampleFormat>();
+
+        for (auto numSamples : { 1, 3, 8, 13, 100, 1031 })
+        {
+            std::vector<int32> ints[2];
+            std::vector<float> floats[2];
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    ints[channel].push_back (r.nextInt());
+                    floats[channel].push_back (r.nextFloat() * 3.0f - 1.5f);
+                }
+            }
+
+            const auto numBytes = (size_t) (2 * Dest::getBytesPerSample()) * (size_t) numSamples;
+            std::vector<char> result (numBytes), expected (numBytes);
+
+            // The kernels never convert fewer than four samples, so converting one sample at
+            // a time gives the reference results
+            const auto convertOneAtATime = [&] (auto sourceType, const auto& sources, int numChannels)
+            {
+                using SourceType = decltype (sourceType);
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    const Dest dest (expected.data() + channel * Dest::getBytesPerSample(), numChannels);
+
+                    for (int i = 0; i < numSamples; ++i)
+                        (dest + i).convertSamples (SourceType (sources[channel].data() + i), 1);
+                }
+            };
+
+            // A single channel, which goes through Pointer::convertSamples()
+            convertOneAtATime (IntSource (nullptr), ints, 1);
+            Dest (result.data(), 1).convertSamples (IntSource (ints[0].data()), numSamples);
+            expect (result == expected);
+
+            convertOneAtATime (FloatSource (nullptr), floats, 1);
+            Dest (result.data(), 1).convertSamples (FloatSource (floats[0].data()), numSamples);
+            expect (result == expected);
+
+            // A stereo pair, which is what the audio format writers use
+            const int32* intChannels[] = { ints[0].data(), ints[1].data() };
+            const float* floatChannels[] = { floats[0].data(), floats[1].data() };
+
+            convertOneAtATime (IntSource (nullptr), ints, 2);
+            auto numDone = VectorisedConversion::int32ToPacked (format, Dest::isBigEndian(), intChannels, 2, result.data(), numSamples);
+
+            for (int channel = 0; channel < 2; ++channel)
+                (Dest (result.data() + channel * Dest::getBytesPerSample(), 2) + numDone).convertSamples (IntSource (intChannels[channel] + numDone),
+                                                                                                   numSamples - numDone);
+
+            expect (result == expected);
+
+            convertOneAtATime (FloatSource (nullptr), floats, 2);
+            numDone = VectorisedConversion::floatToPacked (format, Dest::isBigEndian(), floatChannels, 2, result.data(), numSamples);
+
+            for (int channel = 0; channel < 2; ++channel)
+                (Dest (result.data() + channel * Dest::getBytesPerSample(), 2) + numDone).convertSamples (FloatSource (floatChannels[channel] + numDone),
+                                                                                                   numSamples - numDone);
+
+            expect (result == expected);
+        }
+    }
+
+    template <typename Endianness>
+    void testFormats (Random& r)
+    {
+        testDeinterleaving<AudioData::Int16,   Endianness> (r);
+        testDeinterleaving<AudioData::Int24,   Endianness> (r);
+        testDeinterleaving<AudioData::Int32,   Endianness> (r);
+        testDeinterleaving<AudioData::Float32, Endianness> (r);
+
+        testInterleaving<AudioData::Int16,   Endianness> (r);
+        testInterleaving<AudioData::Int24,   Endianness> (r);
+        testInterleaving<AudioData::Int32,   Endianness> (r);
+        testInterleaving<AudioData::Float32, Endianness> (r);
+    }
+
+    void testDither (Random& r)
+    {
+        constexpr int numSamples = 4099;
+        std::vector<float> source;
+
+        for (int i = 0; i < numSamples; ++i)
+            source.push_back (r.nextFloat() * 2.2f - 1.1f);
+
+        for (auto bitDepth : { 8, 16, 24 })
+        {
+            std::vector<int32> dest ((size_t) numSamples);
+            AudioData::TPDFDither dither (1234);
+
+            // Convert in uneven chunks to check that the state carries on between calls
+            for (int start = 0; start < numSamples;)
+            {
+                const auto num = jmin (numSamples - start, 1 + r.nextInt (100));
+                dither.convertFloatToInt32 (source.data() + start, dest.data() + start, num, bitDepth);
+                start += num;
+            }
+
+            const auto scale = (float) (1 << (bitDepth - 1));
+            const auto lowBits = (int32) ((1u << (32 - bitDepth)) - 1);
+            bool allQuantised = true, allWithinRange = true;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto quantised = dest[(size_t) i] >> (32 - bitDepth);
+                const auto target = jlimit (-scale, scale - 1.0f, source[(size_t) i] * scale);
+
+                allQuantised = allQuantised && (dest[(size_t) i] & lowBits) == 0;
+                allWithinRange = allWithinRange && std::abs ((float) quantised - target) <= 1.5f;
+            }
+
+            expect (allQuantised);
+            expect (allWithinRange);
+        }
+
+        // Silence should turn into low-level noise with no DC offset
+        std::vector<float> silence ((size_t) numSamples, 0.0f);
+        std::vector<int32> noise ((size_t) numSamples);
+        AudioData::TPDFDither (99).convertFloatToInt32 (silence.data(), noise.data(), numSamples, 16);
+
+        int64 total = 0;
+        int numNonZero = 0;
+
+        for (auto n : noise)
+        {
+            expect (std::abs (n >> 16) <= 1);
+            total += n >> 16;
+            numNonZero += n != 0 ? 1 : 0;
+        }
+
+        expect (numNonZero > numSamples / 4);
+        expect (std::abs ((double) total / numSamples) < 0.05);
+    }
+
+    static std::vector<int32> getDitheredSamples (const std::vector<float>& source)
+    {
+        std::vector<int32> result (source.size());
+        AudioData::TPDFDither dither;
+        dither.convertFloatToInt32 (source.data(), result.data(), (int) source.size(), 16);
+        return result;
+    }
+
+    void runBenchmark (Random& r)
+    {
+        using Source = AudioData::Pointer<AudioData::Int24, AudioData::LittleEndian, AudioData::Interleaved, AudioData::Const>;
+        using Dest = AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::NonConst>;
+
+        constexpr int numChannels = 2, numSamples = 1 << 16, numRepeats = 20;
+
+        HeapBlock<char> sourceData;
+        fillWithRandomSamples<AudioData::Int24> (sourceData, (size_t) (numChannels * numSamples * 3), r);
+        AudioBuffer<float> dest (numChannels, numSamples);
+
+        for (auto instructionSet : getSupportedInstructionSets())
+        {
+            VectorisedConversion::setInstructionSet (instructionSet);
+            const auto startTime = Time::getHighResolutionTicks();
+
+            for (int repeat = 0; repeat < numRepeats; ++repeat)
+                for (int channel = 0; channel < numChannels; ++channel)
+                    Dest (dest.getWritePointer (channel)).convertSamples (Source (sourceData + 3 * channel, numChannels), numSamples);
+
+            const auto seconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTime);
+            logMessage ("24-bit stereo to float, " + getName (instructionSet) + ": "
+                          + String ((double) (numRepeats * numSamples) / (jmax (seconds, 1.0e-9) * 1.0e6), 1) + " million frames/s");
+        }
+    }
+
+    void runTest() override
+    {
+        auto r = getRandom();
+        const auto originalInstructionSet = VectorisedConversion::getInstructionSet();
+        std::vector<float> ditherSource;
+
+        for (int i = 0; i < 1000; ++i)
+            ditherSource.push_back (r.nextFloat() * 2.0f - 1.0f);
+
+        VectorisedConversion::setInstructionSet (InstructionSet::none);
+        const auto referenceDither = getDitheredSamples (ditherSource);
+
+        for (auto instructionSet : getSupportedInstructionSets())
+        {
+            expect (VectorisedConversion::setInstructionSet (instructionSet));
+            expect (VectorisedConversion::getInstructionSet() == instructionSet);
+
+            beginTest ("Conversions match the scalar versions: " + getName (instructionSet));
+            testFormats<AudioData::LittleEndian> (r);
+            testFormats<AudioData::BigEndian> (r);
+
+            beginTest ("Dither: " + getName (instructionSet));
+            testDither (r);
+            expect (getDitheredSamples (ditherSource) == referenceDither);
+        }
+
+        beginTest ("Benchmark");
+        runBenchmark (r);
+
+        VectorisedConversion::setInstructionSet (originalInstructionSet);
+    }
+};
+
+static AudioDataVectorisedConversionTests audioDataVectorisedConversionTests;
+
 #endif
 
 JUCE_END_IGNORE_WARNINGS_MSVC
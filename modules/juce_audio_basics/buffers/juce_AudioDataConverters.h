@@ -322,6 +322,96 @@ public:
     };
   #endif
 
+    //==============================================================================
+    /**
+        Vectorised versions of the most common sample format conversions.
+
+        Pointer::convertSamples() uses these automatically when it converts packed 16, 24
+        or 32-bit integer or 32-bit float data into native-endian Int32 or Float32
+        non-interleaved data, or the other way round, so the audio format readers and
+        writers get them without doing anything special.
+
+        The best kernels that the CPU supports are chosen at runtime, and they produce
+        exactly the same results as the sample-by-sample conversions. Each function returns
+        the number of samples that it converted, which may be fewer than were requested (or
+        zero, if the format or the layout of the data isn't supported), and the caller must
+        convert any samples that remain.
+
+        @see Pointer::convertSamples
+    */
+    struct JUCE_API VectorisedConversion
+    {
+        /** The packed sample formats that the kernels can read and write. */
+        enum class PackedFormat
+        {
+            unsupported,
+            int16Bit,
+            int24Bit,
+            int32Bit,
+            float32Bit
+        };
+
+        /** The instruction sets for which there are kernels. */
+        enum class InstructionSet
+        {
+            none,   /**< No kernels are used, and everything is converted a sample at a time. */
+            ssse3,
+            avx2,
+            neon
+        };
+
+        /** Returns the PackedFormat that corresponds to one of the AudioData sample format types. */
+        template <typename SampleFormatType>
+        static constexpr PackedFormat getPackedFormat() noexcept
+        {
+            if constexpr (std::is_same_v<SampleFormatType, Int16>)    return PackedFormat::int16Bit;
+            if constexpr (std::is_same_v<SampleFormatType, Int24>)    return PackedFormat::int24Bit;
+            if constexpr (std::is_same_v<SampleFormatType, Int32>)    return PackedFormat::int32Bit;
+            if constexpr (std::is_same_v<SampleFormatType, Float32>)  return PackedFormat::float32Bit;
+
+            return PackedFormat::unsupported;
+        }
+
+        /** Converts packed samples that are sourceStride samples apart into native 32-bit integers,
+            scaled in the same way as Pointer::getAsInt32(). Floating point sources aren't supported.
+        */
+        static int packedToInt32 (PackedFormat sourceFormat, bool sourceIsBigEndian,
+                                  const void* source, int sourceStride,
+                                  int32* dest, int numSamples) noexcept;
+
+        /** Converts packed samples that are sourceStride samples apart into native floats,
+            scaled in the same way as Pointer::getAsFloat().
+        */
+        static int packedToFloat (PackedFormat sourceFormat, bool sourceIsBigEndian,
+                                  const void* source, int sourceStride,
+                                  float* dest, int numSamples) noexcept;
+
+        /** Interleaves one or two channels of native 32-bit integers into packed samples,
+            in the same way as Pointer::setAsInt32().
+        */
+        static int int32ToPacked (PackedFormat destFormat, bool destIsBigEndian,
+                                  const int32* const* sources, int numChannels,
+                                  void* dest, int numSamples) noexcept;
+
+        /** Interleaves one or two channels of native floats into packed samples, in the same way
+            as Pointer::setAsFloat(). 32-bit integer destinations aren't supported.
+        */
+        static int floatToPacked (PackedFormat destFormat, bool destIsBigEndian,
+                                  const float* const* sources, int numChannels,
+                                  void* dest, int numSamples) noexcept;
+
+        /** Returns the instruction set that the kernels are currently using. */
+        static InstructionSet getInstructionSet() noexcept;
+
+        /** Makes the kernels use a particular instruction set, which can be handy when testing or
+            benchmarking them. Returns false if the CPU doesn't support it.
+        */
+        static bool setInstructionSet (InstructionSet) noexcept;
+
+        /** Returns true if the CPU supports the given instruction set. */
+        static bool isSupported (InstructionSet) noexcept;
+    };
+
     //==============================================================================
     /**
         A pointer to a block of audio data with a particular encoding.
@@ -468,6 +558,11 @@ public:
 
             if (source.getRawData() != getRawData() || source.getNumBytesBetweenSamples() >= getNumBytesBetweenSamples())
             {
+                const auto numConverted = convertSamplesVectorised (source, numSamples);
+                dest += numConverted;
+                source += numConverted;
+                numSamples -= numConverted;
+
                 while (--numSamples >= 0)
                 {
                     Endianness::copyFrom (dest.data, source);
@@ -572,8 +667,67 @@ public:
         //==============================================================================
         SampleFormat data;
 
+        template <typename, typename, typename, typename> friend class Pointer;
+
+        static constexpr auto packedFormat = VectorisedConversion::getPackedFormat<SampleFormat>();
+        static constexpr bool isNativeNonInterleaved = InterleavingType::isInterleavedType == 0
+                                                         && (int) Endianness::isBigEndian == (int) NativeEndian::isBigEndian;
+
         inline void advance() noexcept                          { this->advanceData (data); }
 
+        template <class OtherPointerType>
+        bool overlaps (const OtherPointerType& other, int numSamples) const noexcept
+        {
+            auto* start = static_cast<const char*> (getRawData());
+            auto* otherStart = static_cast<const char*> (other.getRawData());
+
+            return start < otherStart + numSamples * other.getNumBytesBetweenSamples()
+                    && otherStart < start + numSamples * getNumBytesBetweenSamples();
+        }
+
+        template <class OtherPointerType>
+        int convertSamplesVectorised (const OtherPointerType& source, int numSamples) const noexcept
+        {
+            using Formats = VectorisedConversion::PackedFormat;
+            constexpr auto sourceFormat = OtherPointerType::packedFormat;
+
+            if constexpr (isNativeNonInterleaved && sourceFormat != Formats::unsupported
+                           && (packedFormat == Formats::int32Bit || packedFormat == Formats::float32Bit))
+            {
+                if (overlaps (source, numSamples))
+                    return 0;
+
+                if constexpr (packedFormat == Formats::int32Bit)
+                    return VectorisedConversion::packedToInt32 (sourceFormat, OtherPointerType::isBigEndian(), source.getRawData(),
+                                                                source.getNumInterleavedChannels(), reinterpret_cast<int32*> (data.data), numSamples);
+                else
+                    return VectorisedConversion::packedToFloat (sourceFormat, OtherPointerType::isBigEndian(), source.getRawData(),
+                                                                source.getNumInterleavedChannels(), data.data, numSamples);
+            }
+            else if constexpr (OtherPointerType::isNativeNonInterleaved && packedFormat != Formats::unsupported
+                                && (sourceFormat == Formats::int32Bit || sourceFormat == Formats::float32Bit))
+            {
+                if (getNumInterleavedChannels() != 1 || overlaps (source, numSamples))
+                    return 0;
+
+                if constexpr (sourceFormat == Formats::int32Bit)
+                {
+                    const auto* sourceData = static_cast<const int32*> (source.getRawData());
+                    return VectorisedConversion::int32ToPacked (packedFormat, isBigEndian(), &sourceData, 1, data.data, numSamples);
+                }
+                else
+                {
+                    const auto* sourceData = static_cast<const float*> (source.getRawData());
+                    return VectorisedConversion::floatToPacked (packedFormat, isBigEndian(), &sourceData, 1, data.data, numSamples);
+                }
+            }
+            else
+            {
+                ignoreUnused (source, numSamples);
+                return 0;
+            }
+        }
+
         Pointer operator++ (int); // private to force you to use the more efficient pre-increment!
         Pointer operator-- (int);
     };
@@ -784,6 +938,47 @@ public:
             }
         }
     }
+
+    //==============================================================================
+    /**
+        Converts floating point samples to integers with triangular (TPDF) dither.
+
+        Truncating or rounding floats to a shorter integer format produces distortion that
+        is correlated with the signal. Adding a little noise with a triangular probability
+        distribution before quantising turns this into a constant, benign noise floor, which
+        is what you want when rendering to 16 or 24-bit files.
+
+        Each object keeps the state of its own random number generator, so you should use
+        one object per stream. The conversion is vectorised, and gives the same results
+        whichever instruction set is used.
+
+        @see AudioFormatWriter::setDitherEnabled
+    */
+    class JUCE_API TPDFDither
+    {
+    public:
+        /** Creates a ditherer, seeding its random number generator with the given value. */
+        explicit TPDFDither (uint32 seed = 1) noexcept;
+
+        /** Re-seeds the random number generator. */
+        void reset (uint32 seed) noexcept;
+
+        /** Converts some floats in the range -1.0 to 1.0 into dithered 32-bit integers.
+
+            The results are quantised to the given bit depth (which must be between 2 and 24),
+            and scaled in the same way as AudioData::Int32, so the bottom (32 - bitDepth) bits
+            will be zero and they can be passed to anything that expects 32-bit samples, such
+            as AudioFormatWriter::write(). Values beyond full scale are clipped. The source and
+            destination may be the same block of memory.
+        */
+        void convertFloatToInt32 (const float* source, int32* dest, int numSamples, int bitDepth) noexcept;
+
+        /** The number of samples that the vectorised kernels process at a time. */
+        static constexpr int numLanes = 8;
+
+    private:
+        uint32 state[numLanes];
+    };
 };
 
 //==============================================================================
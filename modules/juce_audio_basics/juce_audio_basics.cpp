@@ -37,6 +37,7 @@
 
 #if JUCE_USE_SSE_INTRINSICS
  #include <emmintrin.h>
+ #include <immintrin.h>
 #endif
 
 #if JUCE_MAC || JUCE_IOS
@@ -54,7 +55,7 @@
  #undef JUCE_USE_VDSP_FRAMEWORK
 #endif
 
-#if JUCE_USE_ARM_NEON
+#if JUCE_USE_ARM_NEON || (JUCE_ARM && JUCE_64BIT)
  #include <arm_neon.h>
 #endif
 
@@ -105,4 +106,5 @@
 #if JUCE_UNIT_TESTS
  #include "utilities/juce_ADSR_test.cpp"
  #include "midi/ump/juce_UMP_test.cpp"
+ #include "synthesisers/juce_Synthesiser_test.cpp"
 #endif
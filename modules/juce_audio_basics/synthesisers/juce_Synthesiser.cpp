@@ -72,6 +72,181 @@ void SynthesiserVoice::renderNextBlock (AudioBuffer<double>& outputBuffer,
     subBuffer.makeCopyOf (tempBuffer, true);
 }
 
+//==============================================================================
+class Synthesiser::VoiceRenderingPool
+{
+public:
+    VoiceRenderingPool (int numWorkers, int maxNumChannels, int maxBlockSize)
+        : maximumNumChannels (maxNumChannels), maximumBlockSize (maxBlockSize)
+    {
+        for (int i = 0; i < numWorkers; ++i)
+            workers.add (new Worker (*this));
+
+        for (auto* worker : workers)
+            worker->start();
+    }
+
+    ~VoiceRenderingPool()
+    {
+        for (auto* worker : workers)
+        {
+            worker->signalThreadShouldExit();
+            worker->wakeUp.signal();
+        }
+
+        for (auto* worker : workers)
+            worker->stopThread (-1);
+    }
+
+    int getNumWorkers() const noexcept      { return workers.size(); }
+
+    /*  Renders the voices on the calling thread and on any workers that wake up in
+        time, and adds the workers' buffers to the output. Returns false without
+        rendering anything if the block doesn't fit in the workers' buffers.
+    */
+    template <typename FloatType>
+    bool render (const OwnedArray<SynthesiserVoice>& voices, AudioBuffer<FloatType>& outputAudio,
+                 int startSample, int numSamples)
+    {
+        if (outputAudio.getNumChannels() > maximumNumChannels
+             || numSamples > maximumBlockSize
+             || voices.size() < 2)
+            return false;
+
+        job = { voices.begin(), voices.size(), outputAudio.getNumChannels(), numSamples,
+                std::is_same_v<FloatType, double>, job.number + 1 };
+        nextVoice = 0;
+        jobIsOpen = true;
+
+        for (auto* worker : workers)
+            worker->wakeUp.signal();
+
+        // The calling thread renders its share straight into the output
+        for (int i; (i = nextVoice++) < job.numVoices;)
+            job.voices[i]->renderNextBlock (outputAudio, startSample, numSamples);
+
+        jobIsOpen = false;
+
+        // Any workers that are still busy have already taken their last voice
+        while (numBusyWorkers > 0)
+            workersFinished.wait (-1);
+
+        for (auto* worker : workers)
+        {
+            if (std::exchange (worker->hasOutput, false))
+            {
+                auto& workerBuffer = worker->getBuffer<FloatType>();
+
+                for (int channel = 0; channel < job.numChannels; ++channel)
+                    outputAudio.addFrom (channel, startSample, workerBuffer, channel, 0, numSamples);
+            }
+        }
+
+        return true;
+    }
+
+private:
+    //==============================================================================
+    class Worker final : public Thread
+    {
+    public:
+        explicit Worker (VoiceRenderingPool& p)
+            : Thread ("Synthesiser voice rendering"), pool (p)
+        {
+            floatBuffer .setSize (pool.maximumNumChannels, pool.maximumBlockSize);
+            doubleBuffer.setSize (pool.maximumNumChannels, pool.maximumBlockSize);
+        }
+
+        void start()
+        {
+            if (! startRealtimeThread (RealtimeOptions{}))
+                startThread (Priority::highest);
+        }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                wakeUp.wait (-1);
+
+                if (! threadShouldExit())
+                    pool.renderJob (*this);
+            }
+        }
+
+        template <typename FloatType>
+        AudioBuffer<FloatType>& getBuffer() noexcept
+        {
+            if constexpr (std::is_same_v<FloatType, double>)
+                return doubleBuffer;
+            else
+                return floatBuffer;
+        }
+
+        VoiceRenderingPool& pool;
+        WaitableEvent wakeUp;
+        AudioBuffer<float> floatBuffer;
+        AudioBuffer<double> doubleBuffer;
+        uint32 lastJobNumber = 0;
+        bool hasOutput = false;
+    };
+
+    struct Job
+    {
+        SynthesiserVoice* const* voices = nullptr;
+        int numVoices = 0, numChannels = 0, numSamples = 0;
+        bool isDouble = false;
+        uint32 number = 0;
+    };
+
+    void renderJob (Worker& worker)
+    {
+        ++numBusyWorkers;
+
+        // A worker that wakes up too late mustn't touch the job, but it may just as well
+        // help with the next one if that has already started. It must only do so once
+        // though, because the next job's wake-up call will still be waiting for it, and
+        // a second pass would throw away the voices it rendered the first time.
+        if (jobIsOpen && std::exchange (worker.lastJobNumber, job.number) != job.number)
+        {
+            if (job.isDouble)
+                renderVoices (worker, worker.doubleBuffer);
+            else
+                renderVoices (worker, worker.floatBuffer);
+        }
+
+        if (--numBusyWorkers == 0 && ! jobIsOpen)
+            workersFinished.signal();
+    }
+
+    template <typename FloatType>
+    void renderVoices (Worker& worker, AudioBuffer<FloatType>& workerBuffer)
+    {
+        AudioBuffer<FloatType> buffer (workerBuffer.getArrayOfWritePointers(), job.numChannels, job.numSamples);
+        bool hasRendered = false;
+
+        for (int i; (i = nextVoice++) < job.numVoices;)
+        {
+            if (! std::exchange (hasRendered, true))
+                buffer.clear();
+
+            job.voices[i]->renderNextBlock (buffer, 0, job.numSamples);
+        }
+
+        worker.hasOutput = hasRendered;
+    }
+
+    //==============================================================================
+    const int maximumNumChannels, maximumBlockSize;
+    OwnedArray<Worker> workers;
+    Job job;
+    std::atomic<int> nextVoice { 0 }, numBusyWorkers { 0 };
+    std::atomic<bool> jobIsOpen { false };
+    WaitableEvent workersFinished;
+
+    JUCE_DECLARE_NON_COPYABLE (VoiceRenderingPool)
+};
+
 //==============================================================================
 Synthesiser::Synthesiser()
 {
@@ -98,20 +273,9 @@ void Synthesiser::clearVoices()
 
 SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
 {
-    SynthesiserVoice* voice;
-
-    {
-        const ScopedLock sl (lock);
-        newVoice->setCurrentPlaybackSampleRate (sampleRate);
-        voice = voices.add (newVoice);
-    }
-
-    {
-        const ScopedLock sl (stealLock);
-        usableVoicesToStealArray.ensureStorageAllocated (voices.size() + 1);
-    }
-
-    return voice;
+    const ScopedLock sl (lock);
+    newVoice->setCurrentPlaybackSampleRate (sampleRate);
+    return voices.add (newVoice);
 }
 
 void Synthesiser::removeVoice (const int index)
@@ -150,6 +314,26 @@ void Synthesiser::setMinimumRenderingSubdivisionSize (int numSamples, bool shoul
     subBlockSubdivisionIsStrict = shouldBeStrict;
 }
 
+void Synthesiser::setNumVoiceRenderingThreads (int numWorkerThreads, int maximumNumChannels, int maximumBlockSize)
+{
+    jassert (numWorkerThreads >= 0 && maximumNumChannels >= 0 && maximumBlockSize >= 0);
+
+    std::unique_ptr<VoiceRenderingPool> newPool;
+
+    if (numWorkerThreads > 0)
+        newPool = std::make_unique<VoiceRenderingPool> (numWorkerThreads, maximumNumChannels, maximumBlockSize);
+
+    {
+        const ScopedLock sl (lock);
+        std::swap (voiceRenderingPool, newPool);
+    }
+}
+
+int Synthesiser::getNumVoiceRenderingThreads() const noexcept
+{
+    return voiceRenderingPool != nullptr ? voiceRenderingPool->getNumWorkers() : 0;
+}
+
 //==============================================================================
 void Synthesiser::setCurrentPlaybackSampleRate (const double newRate)
 {
@@ -241,12 +425,18 @@ void Synthesiser::renderNextBlock (AudioBuffer<double>& outputAudio, const MidiB
 
 void Synthesiser::renderVoices (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
+    if (voiceRenderingPool != nullptr && voiceRenderingPool->render (voices, buffer, startSample, numSamples))
+        return;
+
     for (auto* voice : voices)
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
 
 void Synthesiser::renderVoices (AudioBuffer<double>& buffer, int startSample, int numSamples)
 {
+    if (voiceRenderingPool != nullptr && voiceRenderingPool->render (voices, buffer, startSample, numSamples))
+        return;
+
     for (auto* voice : voices)
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
@@ -498,8 +688,6 @@ SynthesiserVoice* Synthesiser::findFreeVoice (SynthesiserSound* soundToPlay,
                                               int midiChannel, int midiNoteNumber,
                                               const bool stealIfNoneAvailable) const
 {
-    const ScopedLock sl (lock);
-
     for (auto* voice : voices)
         if ((! voice->isVoiceActive()) && voice->canPlaySound (soundToPlay))
             return voice;
@@ -524,31 +712,12 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
     SynthesiserVoice* low = nullptr; // Lowest sounding note, might be sustained, but NOT in release phase
     SynthesiserVoice* top = nullptr; // Highest sounding note, might be sustained, but NOT in release phase
 
-    // All major OSes use double-locking so this will be lock- and wait-free as long as the lock is not
-    // contended. This is always the case if you do not call findVoiceToSteal on multiple threads at
-    // the same time.
-    const ScopedLock sl (stealLock);
-
-    // this is a list of voices we can steal, sorted by how long they've been running
-    usableVoicesToStealArray.clear();
-
     for (auto* voice : voices)
     {
         if (voice->canPlaySound (soundToPlay))
         {
             jassert (voice->isVoiceActive()); // We wouldn't be here otherwise
 
-            usableVoicesToStealArray.add (voice);
-
-            // NB: Using a functor rather than a lambda here due to scare-stories about
-            // compilers generating code containing heap allocations..
-            struct Sorter
-            {
-                bool operator() (const SynthesiserVoice* a, const SynthesiserVoice* b) const noexcept { return a->wasStartedBefore (*b); }
-            };
-
-            std::sort (usableVoicesToStealArray.begin(), usableVoicesToStealArray.end(), Sorter());
-
             if (! voice->isPlayingButReleased()) // Don't protect released notes
             {
                 auto note = voice->getCurrentlyPlayingNote();
@@ -566,25 +735,35 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
     if (top == low)
         top = nullptr;
 
+    // Rather than sorting the voices by how long they've been running, each of these searches
+    // just picks the oldest voice that passes its test, so that no locking or allocation is needed.
+    const auto findOldestVoice = [&] (auto&& isSuitable) -> SynthesiserVoice*
+    {
+        SynthesiserVoice* oldest = nullptr;
+
+        for (auto* voice : voices)
+            if (voice->canPlaySound (soundToPlay) && isSuitable (voice)
+                 && (oldest == nullptr || voice->wasStartedBefore (*oldest)))
+                oldest = voice;
+
+        return oldest;
+    };
+
     // The oldest note that's playing with the target pitch is ideal..
-    for (auto* voice : usableVoicesToStealArray)
-        if (voice->getCurrentlyPlayingNote() == midiNoteNumber)
-            return voice;
+    if (auto* voice = findOldestVoice ([&] (auto* v) { return v->getCurrentlyPlayingNote() == midiNoteNumber; }))
+        return voice;
 
     // Oldest voice that has been released (no finger on it and not held by sustain pedal)
-    for (auto* voice : usableVoicesToStealArray)
-        if (voice != low && voice != top && voice->isPlayingButReleased())
-            return voice;
+    if (auto* voice = findOldestVoice ([&] (auto* v) { return v != low && v != top && v->isPlayingButReleased(); }))
+        return voice;
 
     // Oldest voice that doesn't have a finger on it:
-    for (auto* voice : usableVoicesToStealArray)
-        if (voice != low && voice != top && ! voice->isKeyDown())
-            return voice;
+    if (auto* voice = findOldestVoice ([&] (auto* v) { return v != low && v != top && ! v->isKeyDown(); }))
+        return voice;
 
     // Oldest voice that isn't protected
-    for (auto* voice : usableVoicesToStealArray)
-        if (voice != low && voice != top)
-            return voice;
+    if (auto* voice = findOldestVoice ([&] (auto* v) { return v != low && v != top; }))
+        return voice;
 
     // We've only got "protected" voices now: lowest note takes priority
     jassert (low != nullptr);
@@ -557,6 +557,31 @@ public:
     */
     void setMinimumRenderingSubdivisionSize (int numSamples, bool shouldBeStrict = false) noexcept;
 
+    //==============================================================================
+    /** Shares the rendering of the voices between the audio thread and some worker threads.
+
+        When this is enabled, the default renderVoices() method hands the voices out to
+        the calling thread and to numWorkerThreads realtime threads, which render them
+        into their own buffers. These buffers are then added to the output, so your
+        voices' renderNextBlock() methods must be safe to call at the same time as those
+        of the other voices.
+
+        The buffers are allocated here for the given number of channels and block size,
+        and any larger blocks will be rendered on the calling thread only. Passing 0
+        worker threads goes back to rendering all the voices on the calling thread.
+
+        This is worth doing when there are many voices that are expensive to render,
+        for example in large sample-based instruments.
+
+        @see getNumVoiceRenderingThreads
+    */
+    void setNumVoiceRenderingThreads (int numWorkerThreads, int maximumNumChannels, int maximumBlockSize);
+
+    /** Returns the number of worker threads that help rendering the voices.
+        @see setNumVoiceRenderingThreads
+    */
+    int getNumVoiceRenderingThreads() const noexcept;
+
 protected:
     //==============================================================================
     /** This is used to control access to the rendering callback and the note trigger methods. */
@@ -582,6 +607,10 @@ protected:
 
         Returns nullptr if all voices are busy and stealing isn't enabled.
 
+        This is called by noteOn() while the lock is held, so the default method doesn't
+        take any locks itself. If you call it from anywhere else, make sure that you're
+        holding the lock.
+
         To implement a custom note-stealing algorithm, you can either override this
         method, or (preferably) override findVoiceToSteal().
     */
@@ -594,6 +623,9 @@ protected:
         The default method will attempt to find the oldest voice that isn't the
         bottom or top note being played. If that's not suitable for your synth,
         you can override this method and do something more cunning instead.
+
+        Like findFreeVoice(), this is called while the lock is held, and the default
+        method doesn't lock or allocate.
     */
     virtual SynthesiserVoice* findVoiceToSteal (SynthesiserSound* soundToPlay,
                                                 int midiChannel,
@@ -627,8 +659,9 @@ private:
     bool subBlockSubdivisionIsStrict = false;
     bool shouldStealNotes = true;
     BigInteger sustainPedalsDown;
-    mutable CriticalSection stealLock;
-    mutable Array<SynthesiserVoice*> usableVoicesToStealArray;
+
+    class VoiceRenderingPool;
+    std::unique_ptr<VoiceRenderingPool> voiceRenderingPool;
 
     template <typename floatType>
     void processNextBlock (AudioBuffer<floatType>&, const MidiBuffer&, int startSample, int numSamples);
@@ -0,0 +1,237 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct SynthesiserTests final : public UnitTest
+{
+    SynthesiserTests()  : UnitTest ("Synthesiser", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        beginTest ("Parallel rendering matches serial rendering");
+        {
+            expectParallelRenderingMatches<float>  (3, 512);
+            expectParallelRenderingMatches<double> (3, 512);
+            expectParallelRenderingMatches<float>  (1, 512);
+        }
+
+        beginTest ("Blocks that are too large are rendered serially");
+        {
+            expectParallelRenderingMatches<float> (2, 100);
+        }
+
+        beginTest ("Parallel rendering matches serial rendering over many small blocks");
+        {
+            // Every MIDI event splits the block, so this starts a great many short jobs
+            // in quick succession, which gives the workers plenty of chances to wake up late
+            expectParallelRenderingMatches<float>  (3, 512, 16, 2000);
+            expectParallelRenderingMatches<double> (2, 512, 16, 1000);
+        }
+
+        beginTest ("Voices can be stolen");
+        {
+            Synthesiser synth;
+            synth.setCurrentPlaybackSampleRate (44100.0);
+            synth.addSound (new TestSound());
+
+            for (int i = 0; i < 4; ++i)
+                synth.addVoice (new TestVoice());
+
+            for (auto note : { 60, 62, 64, 66 })
+                synth.noteOn (1, note, 1.0f);
+
+            // The oldest voice that isn't the lowest or highest note is stolen
+            synth.noteOn (1, 68, 1.0f);
+            expect (! isPlaying (synth, 62));
+            expect (isPlaying (synth, 60) && isPlaying (synth, 64) && isPlaying (synth, 66) && isPlaying (synth, 68));
+
+            // ...unless it's still held down and another one has been released
+            synth.noteOff (1, 66, 1.0f, true);
+            synth.noteOn (1, 70, 1.0f);
+            expect (! isPlaying (synth, 66));
+            expect (isPlaying (synth, 64));
+
+            // The same note is always retriggered on the oldest voice playing it
+            synth.noteOn (1, 64, 1.0f);
+            expect (isPlaying (synth, 60) && isPlaying (synth, 64) && isPlaying (synth, 68) && isPlaying (synth, 70));
+        }
+
+        beginTest ("Benchmark");
+        {
+            constexpr int numChannels = 2, blockSize = 512, numBlocks = 50, numVoices = 256;
+            String message;
+
+            for (auto numThreads : { 0, 1, 3 })
+            {
+                Synthesiser synth;
+                synth.setCurrentPlaybackSampleRate (44100.0);
+                synth.addSound (new TestSound());
+                synth.setNumVoiceRenderingThreads (numThreads, numChannels, blockSize);
+
+                for (int i = 0; i < numVoices; ++i)
+                {
+                    synth.addVoice (new TestVoice (numBlocks * blockSize));
+                    synth.noteOn (1 + i % 16, 20 + i % 100, 0.1f);
+                }
+
+                AudioBuffer<float> buffer (numChannels, blockSize);
+                const auto start = Time::getHighResolutionTicks();
+
+                for (int i = 0; i < numBlocks; ++i)
+                {
+                    buffer.clear();
+                    synth.renderNextBlock (buffer, {}, 0, blockSize);
+                }
+
+                const auto time = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start) * 1000.0;
+                message << numThreads << " worker threads " << String (time, 2) << " ms, ";
+            }
+
+            logMessage (String (numVoices) + " voices: " + message.dropLastCharacters (2));
+        }
+    }
+
+private:
+    struct TestSound final : public SynthesiserSound
+    {
+        bool appliesToNote (int) override       { return true; }
+        bool appliesToChannel (int) override    { return true; }
+    };
+
+    // A voice that plays a decaying sine for a number of samples that depends on its note
+    struct TestVoice final : public SynthesiserVoice
+    {
+        explicit TestVoice (int extraLengthInSamples = 0)
+            : extraLength (extraLengthInSamples)
+        {}
+
+        bool canPlaySound (SynthesiserSound*) override  { return true; }
+
+        void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int) override
+        {
+            phase = 0.0;
+            increment = MathConstants<double>::twoPi * MidiMessage::getMidiNoteInHertz (midiNoteNumber) / getSampleRate();
+            level = velocity;
+            samplesLeft = 200 + 10 * midiNoteNumber + extraLength;
+        }
+
+        void stopNote (float, bool allowTailOff) override
+        {
+            if (! allowTailOff)
+                clearCurrentNote();
+        }
+
+        void pitchWheelMoved (int) override {}
+        void controllerMoved (int, int) override {}
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override   { render (buffer, startSample, numSamples); }
+        void renderNextBlock (AudioBuffer<double>& buffer, int startSample, int numSamples) override  { render (buffer, startSample, numSamples); }
+
+        template <typename FloatType>
+        void render (AudioBuffer<FloatType>& buffer, int startSample, int numSamples)
+        {
+            if (! isVoiceActive())
+                return;
+
+            for (int i = startSample; i < startSample + numSamples && samplesLeft > 0; ++i, --samplesLeft)
+            {
+                const auto sample = (FloatType) (level * std::sin (phase));
+                phase += increment;
+                level *= 0.999;
+
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    buffer.addSample (channel, i, sample * (FloatType) (channel + 1));
+            }
+
+            if (samplesLeft == 0)
+                clearCurrentNote();
+        }
+
+        const int extraLength;
+        double phase = 0.0, increment = 0.0, level = 0.0;
+        int samplesLeft = 0;
+    };
+
+    static bool isPlaying (const Synthesiser& synth, int note)
+    {
+        for (int i = 0; i < synth.getNumVoices(); ++i)
+            if (synth.getVoice (i)->getCurrentlyPlayingNote() == note)
+                return true;
+
+        return false;
+    }
+
+    template <typename FloatType>
+    void expectParallelRenderingMatches (int numThreads, int maximumBlockSize, int blockSize = 256, int numBlocks = 20)
+    {
+        constexpr int numChannels = 2, numVoices = 24;
+
+        Synthesiser serial, parallel;
+        parallel.setNumVoiceRenderingThreads (numThreads, numChannels, maximumBlockSize);
+        expectEquals (parallel.getNumVoiceRenderingThreads(), numThreads);
+
+        for (auto* synth : { &serial, &parallel })
+        {
+            synth->setCurrentPlaybackSampleRate (44100.0);
+            synth->addSound (new TestSound());
+
+            for (int i = 0; i < numVoices; ++i)
+                synth->addVoice (new TestVoice());
+        }
+
+        AudioBuffer<FloatType> serialBuffer (numChannels, blockSize), parallelBuffer (numChannels, blockSize);
+        Random random (42);
+        auto maxError = 0.0;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            MidiBuffer midi;
+
+            for (int i = 0; i < 8; ++i)
+                midi.addEvent (MidiMessage::noteOn (1 + i % 2, 30 + random.nextInt (60), 0.5f), random.nextInt (blockSize));
+
+            for (auto* buffer : { &serialBuffer, &parallelBuffer })
+                buffer->clear();
+
+            serial  .renderNextBlock (serialBuffer,   midi, 0, blockSize);
+            parallel.renderNextBlock (parallelBuffer, midi, 0, blockSize);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    maxError = jmax (maxError, (double) std::abs (serialBuffer.getSample (channel, i) - parallelBuffer.getSample (channel, i)));
+        }
+
+        expectLessThan (maxError, 1.0e-5);
+
+        parallel.setNumVoiceRenderingThreads (0, 0, 0);
+        expectEquals (parallel.getNumVoiceRenderingThreads(), 0);
+    }
+};
+
+static SynthesiserTests synthesiserTests;
+
+} // namespace juce
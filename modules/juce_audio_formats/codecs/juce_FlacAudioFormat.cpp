@@ -190,6 +190,7 @@ public:
     {
         lengthInSamples = 0;
         decoder = FlacNamespace::FLAC__stream_decoder_new();
+        FLAC__stream_decoder_set_metadata_respond (decoder, FlacNamespace::FLAC__METADATA_TYPE_SEEKTABLE);
 
         ok = FLAC__stream_decoder_init_stream (decoder,
                                                readCallback_, seekCallback_, tellCallback_, lengthCallback_,
@@ -231,6 +232,31 @@ public:
         reservoir.setSize ((int) numChannels, 2 * (int) info.max_blocksize, false, false, true);
     }
 
+    void useSeekTable (const FlacNamespace::FLAC__StreamMetadata_SeekTable& table)
+    {
+        seekPoints.clearQuick();
+
+        for (unsigned int i = 0; i < table.num_points; ++i)
+            if (table.points[i].sample_number != FlacNamespace::FLAC__STREAM_METADATA_SEEKPOINT_PLACEHOLDER)
+                seekPoints.add ((int64) table.points[i].sample_number);
+    }
+
+    int64 getSeekPointBefore (int64 samplePosition) override
+    {
+        // the seek table is sorted, so find the last point that isn't beyond the position..
+        auto result = samplePosition;
+
+        for (auto point : seekPoints)
+        {
+            if (point > samplePosition)
+                break;
+
+            result = point;
+        }
+
+        return result;
+    }
+
     bool readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
                       int64 startSampleInFile, int numSamples) override
     {
@@ -270,6 +296,15 @@ public:
                 // accurately than this. Probably fixed in newer versions of the library, though.
                 bufferedRange = emptyRange (requestedStart & ~511);
                 FLAC__stream_decoder_seek_absolute (decoder, (FlacNamespace::FLAC__uint64) bufferedRange.getStart());
+
+                // The seek only delivers the rest of the frame that holds the aligned position,
+                // which can end before the requested one, so keep decoding until we reach it..
+                while (! bufferedRange.isEmpty() && bufferedRange.getEnd() <= requestedStart)
+                {
+                    bufferedRange = emptyRange (bufferedRange.getEnd());
+                    FLAC__stream_decoder_process_single (decoder);
+                }
+
                 return;
             }
 
@@ -368,7 +403,10 @@ public:
                                    const FlacNamespace::FLAC__StreamMetadata* metadata,
                                    void* client_data)
     {
-        static_cast<FlacReader*> (client_data)->useMetadata (metadata->data.stream_info);
+        if (metadata->type == FlacNamespace::FLAC__METADATA_TYPE_STREAMINFO)
+            static_cast<FlacReader*> (client_data)->useMetadata (metadata->data.stream_info);
+        else if (metadata->type == FlacNamespace::FLAC__METADATA_TYPE_SEEKTABLE)
+            static_cast<FlacReader*> (client_data)->useSeekTable (metadata->data.seek_table);
     }
 
     static void errorCallback_ (const FlacNamespace::FLAC__StreamDecoder*, FlacNamespace::FLAC__StreamDecoderErrorStatus, void*)
@@ -379,6 +417,7 @@ private:
     FlacNamespace::FLAC__StreamDecoder* decoder;
     AudioBuffer<float> reservoir;
     Range<int64> bufferedRange;
+    Array<int64> seekPoints;
     bool ok = false, scanningForLength = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacReader)
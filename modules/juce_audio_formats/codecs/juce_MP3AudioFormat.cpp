@@ -409,6 +409,18 @@ struct VBRTagData
         else
             sampleRate = sampleRates[type][sampleRateIndex];
 
+        headersize = ((type + 1) * 72000 * bitrate) / sampleRate;
+
+        // A VBRI header always starts 32 bytes after the frame header
+        if (isVbriTag (data + 36))
+        {
+            flags = 3;
+            bytes  = ByteOrder::bigEndianInt (data + 36 + 10);
+            frames = ByteOrder::bigEndianInt (data + 36 + 14);
+            vbrScale = -1;
+            return true;
+        }
+
         data += type != 0 ? (mode != 3 ? (32 + 4) : (17 + 4))
                           : (mode != 3 ? (17 + 4) : (9 + 4));
 
@@ -444,7 +456,6 @@ struct VBRTagData
         if (flags & 8)
             vbrScale = (int) ByteOrder::bigEndianInt (data);
 
-        headersize = ((type + 1) * 72000 * bitrate) / sampleRate;
         return true;
     }
 
@@ -458,6 +469,11 @@ private:
         return (d[0] == 'X' && d[1] == 'i' && d[2] == 'n' && d[3] == 'g')
             || (d[0] == 'I' && d[1] == 'n' && d[2] == 'f' && d[3] == 'o');
     }
+
+    static bool isVbriTag (const uint8* d) noexcept
+    {
+        return d[0] == 'V' && d[1] == 'B' && d[2] == 'R' && d[3] == 'I';
+    }
 };
 
 //==============================================================================
@@ -1558,17 +1574,11 @@ struct MP3Stream
     {
         frameIndex = jmax (0, frameIndex);
 
-        while (frameIndex >= frameStreamPositions.size() * storedStartPosInterval)
-        {
-            int dummy = 0;
-            auto result = decodeNextBlock (nullptr, nullptr, dummy);
+        if (frameIndex >= frameStreamPositions.size() * storedStartPosInterval && ! allFramePositionsKnown)
+            scanFramePositions();
 
-            if (result < 0)
-                return false;
-
-            if (result > 0)
-                break;
-        }
+        if (frameStreamPositions.isEmpty())
+            return false;
 
         frameIndex = jmin (frameIndex & ~(storedStartPosInterval - 1),
                            (frameStreamPositions.size() - 1) * storedStartPosInterval);
@@ -1579,6 +1589,72 @@ struct MP3Stream
         return true;
     }
 
+    /*  Finds the stream positions of all the remaining frames by reading their headers
+        only. This follows the same steps as decodeNextBlock(), so that the frames are
+        counted in exactly the same way, but it is a lot faster than decoding them.
+    */
+    void scanFramePositions()
+    {
+        if (frameStreamPositions.isEmpty())
+            return;
+
+        const auto oldPos = stream.getPosition();
+        const auto oldFrameIndex = currentFrameIndex;
+
+        currentFrameIndex = (frameStreamPositions.size() - 1) * storedStartPosInterval;
+        auto position = frameStreamPositions.getLast();
+        auto checkForVBRHeader = (currentFrameIndex == 0);
+        MP3Frame scannedFrame;
+
+        for (;;)
+        {
+            stream.setPosition (position);
+            const auto offset = scanForNextFrameHeader (false);
+
+            if (offset < 0)
+                break;
+
+            if (std::exchange (checkForVBRHeader, offset > 0))
+            {
+                uint8 data[194];
+                stream.read (data, sizeof (data));
+
+                VBRTagData tagData;
+
+                if (tagData.read (data))
+                {
+                    position += jmax (tagData.headersize, 1);
+                    checkForVBRHeader = true;
+                    continue;
+                }
+            }
+
+            stream.setPosition (position + offset);
+
+            if (scannedFrame.decodeHeader ((uint32) stream.readIntBigEndian()) == MP3Frame::ParseSuccessful::no)
+                break;
+
+            position += offset + 4 + scannedFrame.frameSize;
+        }
+
+        allFramePositionsKnown = true;
+        currentFrameIndex = oldFrameIndex;
+        stream.setPosition (oldPos);
+    }
+
+    /** Returns the positions of every storedStartPosInterval-th frame that have been found so far. */
+    const Array<int64>& getFramePositions() const noexcept      { return frameStreamPositions; }
+
+    /** Returns true if the positions of all the frames in the stream are known. */
+    bool hasAllFramePositions() const noexcept                  { return allFramePositionsKnown; }
+
+    /** Replaces the frame positions with a complete set found by another reader of the same stream. */
+    void setAllFramePositions (const Array<int64>& positions)
+    {
+        frameStreamPositions = positions;
+        allFramePositionsKnown = true;
+    }
+
     MP3Frame frame;
     VBRTagData vbrTagData;
     BufferedInputStream stream;
@@ -1620,6 +1696,7 @@ private:
 
     enum { storedStartPosInterval = 4 };
     Array<int64> frameStreamPositions;
+    bool allFramePositionsKnown = false;
 
     struct SideInfoLayer1
     {
@@ -2950,6 +3027,75 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MP3Stream)
 };
 
+//==============================================================================
+/*  Keeps the frame positions of the most recently scanned files, so that other
+    readers of the same file can seek straight away without scanning it again.
+*/
+class SeekIndexCache
+{
+public:
+    static SeekIndexCache& getInstance()
+    {
+        static SeekIndexCache cache;
+        return cache;
+    }
+
+    /*  Returns a key that identifies the file that a stream reads, or an empty
+        string if the stream isn't reading a file.
+    */
+    static String getKeyForStream (InputStream* stream)
+    {
+        if (auto* fileStream = dynamic_cast<FileInputStream*> (stream))
+        {
+            const auto& file = fileStream->getFile();
+
+            return file.getFullPathName() + "|" + String (file.getSize())
+                    + "|" + String (file.getLastModificationTime().toMilliseconds());
+        }
+
+        return {};
+    }
+
+    std::shared_ptr<const Array<int64>> find (const String& key)
+    {
+        const ScopedLock sl (lock);
+
+        for (auto it = entries.begin(); it != entries.end(); ++it)
+        {
+            if (it->first == key)
+            {
+                // Move the entry to the front, so that the least recently used ones are dropped first
+                std::rotate (entries.begin(), it, std::next (it));
+                return entries.front().second;
+            }
+        }
+
+        return {};
+    }
+
+    void store (const String& key, const Array<int64>& positions)
+    {
+        auto entry = std::make_pair (key, std::make_shared<const Array<int64>> (positions));
+
+        const ScopedLock sl (lock);
+
+        entries.erase (std::remove_if (entries.begin(), entries.end(), [&] (const auto& e) { return e.first == key; }),
+                       entries.end());
+        entries.insert (entries.begin(), std::move (entry));
+
+        if (entries.size() > maxNumEntries)
+            entries.resize (maxNumEntries);
+    }
+
+private:
+    SeekIndexCache() = default;
+
+    static constexpr size_t maxNumEntries = 32;
+
+    CriticalSection lock;
+    std::vector<std::pair<String, std::shared_ptr<const Array<int64>>>> entries;
+};
+
 //==============================================================================
 static const char* const mp3FormatName = "MP3 file";
 
@@ -2960,7 +3106,8 @@ public:
     MP3Reader (InputStream* const in)
         : AudioFormatReader (in, mp3FormatName),
           stream (*in), currentPosition (0),
-          decodedStart (0), decodedEnd (0)
+          decodedStart (0), decodedEnd (0),
+          seekIndexKey (SeekIndexCache::getKeyForStream (in))
     {
         skipID3();
         const int64 streamPos = stream.stream.getPosition();
@@ -2972,6 +3119,10 @@ public:
             sampleRate = stream.frame.getFrequency();
             numChannels = (unsigned int) stream.frame.numChannels;
             lengthInSamples = findLength (streamPos);
+
+            if (seekIndexKey.isNotEmpty())
+                if (auto positions = SeekIndexCache::getInstance().find (seekIndexKey))
+                    stream.setAllFramePositions (*positions);
         }
     }
 
@@ -2986,6 +3137,8 @@ public:
 
         if (currentPosition != startSampleInFile)
         {
+            const auto hadAllFramePositions = stream.hasAllFramePositions();
+
             if (! stream.seek ((int) (startSampleInFile / 1152 - 1)))
             {
                 currentPosition = -1;
@@ -2993,6 +3146,9 @@ public:
             }
             else
             {
+                if (! hadAllFramePositions && stream.hasAllFramePositions() && seekIndexKey.isNotEmpty())
+                    SeekIndexCache::getInstance().store (seekIndexKey, stream.getFramePositions());
+
                 decodedStart = decodedEnd = 0;
                 const int64 streamPos = stream.currentFrameIndex * 1152;
                 int toSkip = (int) (startSampleInFile - streamPos);
@@ -3054,6 +3210,7 @@ private:
     enum { decodedDataSize = 1152 };
     float decoded0[decodedDataSize], decoded1[decodedDataSize];
     int decodedStart, decodedEnd;
+    const String seekIndexKey;
 
     void createEmptyDecodedData() noexcept
     {
@@ -3172,6 +3329,164 @@ AudioFormatWriter* MP3AudioFormat::createWriterFor (OutputStream*, double /*samp
     return nullptr;
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct MP3AudioFormatTests final : public UnitTest
+{
+    MP3AudioFormatTests()
+        : UnitTest ("MP3 audio format tests", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Scanning the frame headers finds the same frames as decoding");
+        {
+            expectScannedPositionsMatchDecoded (createStream (200, {}, {}));
+            expectScannedPositionsMatchDecoded (createStream (200, "Xing", {}));
+            expectScannedPositionsMatchDecoded (createStream (200, "VBRI", {}));
+            expectScannedPositionsMatchDecoded (createStream (200, {}, { 3, 50, 51, 133 }));
+            expectScannedPositionsMatchDecoded (createStream (200, "Xing", { 0, 1, 77 }));
+        }
+
+        beginTest ("The frame count is read from Xing and VBRI headers");
+        {
+            for (auto tag : { "Xing", "VBRI" })
+            {
+                MemoryBlock data (createStream (300, tag, {}));
+                MP3AudioFormat format;
+                std::unique_ptr<AudioFormatReader> reader (format.createReaderFor (new MemoryInputStream (data, false), true));
+
+                expect (reader != nullptr);
+
+                if (reader != nullptr)
+                    expectEquals (reader->lengthInSamples, (int64) 300 * 1152);
+            }
+        }
+
+        beginTest ("Seek indexes are shared between readers of the same file");
+        {
+            const auto data = createStream (500, {}, { 10, 300 });
+            TemporaryFile tempFile (".mp3");
+            expect (tempFile.getFile().replaceWithData (data.getData(), data.getSize()));
+
+            const auto key = MP3Decoder::SeekIndexCache::getKeyForStream (tempFile.getFile().createInputStream().get());
+            expect (key.isNotEmpty());
+            expect (MP3Decoder::SeekIndexCache::getInstance().find (key) == nullptr);
+
+            MP3AudioFormat format;
+
+            for (int i = 0; i < 2; ++i)
+            {
+                std::unique_ptr<AudioFormatReader> reader (format.createReaderFor (tempFile.getFile().createInputStream().release(), true));
+                expect (reader != nullptr);
+
+                if (reader == nullptr)
+                    break;
+
+                AudioBuffer<float> buffer ((int) reader->numChannels, 1000);
+                expect (reader->read (&buffer, 0, buffer.getNumSamples(), 400 * 1152 + 17, true, true));
+            }
+
+            auto positions = MP3Decoder::SeekIndexCache::getInstance().find (key);
+            expect (positions != nullptr);
+
+            if (positions != nullptr)
+            {
+                MemoryInputStream input (data, false);
+                MP3Decoder::MP3Stream stream (input);
+                decodeAll (stream);
+
+                expect (*positions == stream.getFramePositions());
+            }
+        }
+    }
+
+private:
+    // Creates a stream of silent MPEG-1 layer III frames, with an optional VBR header
+    // frame at the start, and some junk bytes before the frames at the given indexes.
+    static MemoryBlock createStream (int numFrames, const char* vbrTag, std::initializer_list<int> junkBeforeFrames)
+    {
+        MemoryOutputStream out;
+
+        const auto writeFrame = [&out] (bool padding, const char* tag, int numTaggedFrames)
+        {
+            uint8 frame[418] = { 0xff, 0xfb, (uint8) (padding ? 0x92 : 0x90), 0x00 };
+
+            // In a stereo MPEG-1 frame, both kinds of VBR header start after 32 bytes of side info
+            if (tag != nullptr)
+            {
+                memcpy (frame + 36, tag, 4);
+
+                if (String (tag) == "Xing")
+                {
+                    writeBigEndianInt (frame + 40, 1);
+                    writeBigEndianInt (frame + 44, (uint32) numTaggedFrames);
+                }
+                else
+                {
+                    writeBigEndianInt (frame + 50, (uint32) numTaggedFrames);
+                }
+            }
+
+            out.write (frame, padding ? 418 : 417);
+        };
+
+        if (vbrTag != nullptr)
+            writeFrame (false, vbrTag, numFrames);
+
+        for (int i = 0; i < numFrames; ++i)
+        {
+            if (std::find (junkBeforeFrames.begin(), junkBeforeFrames.end(), i) != junkBeforeFrames.end())
+                out.writeRepeatedByte (0x55, (size_t) (7 + i % 5));
+
+            writeFrame (i % 3 == 1, nullptr, 0);
+        }
+
+        return out.getMemoryBlock();
+    }
+
+    static void writeBigEndianInt (uint8* dest, uint32 value)
+    {
+        for (int i = 0; i < 4; ++i)
+            dest[i] = (uint8) (value >> (24 - 8 * i));
+    }
+
+    static void decodeAll (MP3Decoder::MP3Stream& stream)
+    {
+        float out0[1152], out1[1152];
+
+        while (! stream.stream.isExhausted())
+        {
+            int done = 0;
+
+            if (stream.decodeNextBlock (out0, out1, done) < 0)
+                break;
+        }
+    }
+
+    void expectScannedPositionsMatchDecoded (const MemoryBlock& data)
+    {
+        MemoryInputStream decodedInput (data, false), scannedInput (data, false);
+        MP3Decoder::MP3Stream decoded (decodedInput), scanned (scannedInput);
+
+        decodeAll (decoded);
+
+        float out0[1152], out1[1152];
+        int done = 0;
+        scanned.decodeNextBlock (out0, out1, done);
+        scanned.scanFramePositions();
+
+        expect (scanned.hasAllFramePositions());
+        expect (decoded.getFramePositions().size() > 10);
+        expect (scanned.getFramePositions() == decoded.getFramePositions());
+    }
+};
+
+static MP3AudioFormatTests mp3AudioFormatTests;
+
+#endif
+
 #endif
 
 } // namespace juce
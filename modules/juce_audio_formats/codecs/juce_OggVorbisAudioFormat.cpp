@@ -223,6 +223,17 @@ public:
         return true;
     }
 
+    int64 getSeekPointBefore (int64 samplePosition) override
+    {
+        // decoding can resume cleanly from the start of the page that holds the position,
+        // which is the granule position of the page before it..
+        if (samplePosition <= 0 || samplePosition >= lengthInSamples
+             || ov_pcm_seek_page (&ovFile, samplePosition) != 0)
+            return samplePosition;
+
+        return jlimit ((int64) 0, samplePosition, (int64) ov_pcm_tell (&ovFile));
+    }
+
     //==============================================================================
     static size_t oggReadCallback (void* ptr, size_t size, size_t nmemb, void* datasource)
     {
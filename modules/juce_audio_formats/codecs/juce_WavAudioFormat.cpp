@@ -2261,6 +2261,56 @@ struct WaveAudioFormatTests final : public UnitTest
                 expect (reader->metadataValues.getValue (WavAudioFormat::aswgVersion, "") == "3.01");
             }
         }
+
+        {
+            beginTest ("Stereo fixed-point samples survive a round trip, with and without dither");
+
+            constexpr int numSamples = 1001;
+            AudioBuffer<float> source (2, numSamples);
+
+            for (int ch = 0; ch < source.getNumChannels(); ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    source.setSample (ch, i, 0.8f * std::sin ((float) i * 0.01f * (float) (ch + 1)));
+
+            for (auto bitsPerSample : { 16, 24 })
+            {
+                const auto lsb = 1.0f / (float) (1 << (bitsPerSample - 1));
+                AudioBuffer<float> results[2];
+
+                for (auto dither : { false, true })
+                {
+                    MemoryBlock block;
+
+                    {
+                        auto writer = rawToUniquePtr (WavAudioFormat().createWriterFor (new MemoryOutputStream (block, false), 48000, 2,
+                                                                                        bitsPerSample, {}, 0));
+                        writer->setDitherEnabled (dither);
+                        expect (writer->isDitherEnabled() == dither);
+                        expect (writer->writeFromAudioSampleBuffer (source, 0, numSamples));
+                    }
+
+                    auto reader = rawToUniquePtr (WavAudioFormat().createReaderFor (new MemoryInputStream (block, false), true));
+                    auto& result = results[dither ? 1 : 0];
+                    result.setSize (2, numSamples);
+                    expect (reader->read (&result, 0, numSamples, 0, true, true));
+
+                    float biggestDiff = 0.0f;
+
+                    for (int ch = 0; ch < source.getNumChannels(); ++ch)
+                        for (int i = 0; i < numSamples; ++i)
+                            biggestDiff = jmax (biggestDiff, std::abs (result.getSample (ch, i) - source.getSample (ch, i)));
+
+                    expect (biggestDiff <= (dither ? 1.5f : 1.0f) * lsb);
+                }
+
+                bool anyDifferent = false;
+
+                for (int i = 0; i < numSamples; ++i)
+                    anyDifferent = anyDifferent || ! exactlyEqual (results[0].getSample (0, i), results[1].getSample (0, i));
+
+                expect (anyDifferent);
+            }
+        }
     }
 
 private:
@@ -0,0 +1,622 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class AsyncReadAheadScheduler::Worker final : public Thread
+{
+public:
+    explicit Worker (AsyncReadAheadScheduler& s)
+        : Thread ("Audio read-ahead"), owner (s)
+    {
+    }
+
+    void run() override
+    {
+        while (auto request = owner.waitForNextRequest())
+        {
+            auto& reader = *request->reader;
+            const auto nextDeadline = reader.readNextBlock();
+            owner.finishRequest (reader, nextDeadline);
+        }
+    }
+
+private:
+    AsyncReadAheadScheduler& owner;
+
+    JUCE_DECLARE_NON_COPYABLE (Worker)
+};
+
+//==============================================================================
+AsyncReadAheadScheduler::AsyncReadAheadScheduler (int numThreads, int blockSize)
+    : samplesPerBlock (jmax (1, blockSize))
+{
+    // not much point having a scheduler without any threads!
+    jassert (numThreads > 0);
+
+    for (int i = jmax (1, numThreads); --i >= 0;)
+    {
+        workers.push_back (std::make_unique<Worker> (*this));
+        workers.back()->startThread (Thread::Priority::high);
+    }
+}
+
+AsyncReadAheadScheduler::~AsyncReadAheadScheduler()
+{
+    {
+        const std::scoped_lock sl (mutex);
+
+        // all the readers that use this scheduler must be deleted first!
+        jassert (queue.empty());
+
+        shuttingDown = true;
+    }
+
+    requestAdded.notify_all();
+
+    for (auto& worker : workers)
+        worker->stopThread (-1);
+}
+
+AsyncReadAheadScheduler::Statistics AsyncReadAheadScheduler::getStatistics() const
+{
+    const std::scoped_lock sl (mutex);
+    auto result = statistics;
+    result.queueDepth = (int) queue.size();
+    result.numBuffersInPool = (int) freeBuffers.size();
+    return result;
+}
+
+void AsyncReadAheadScheduler::resetStatistics()
+{
+    const std::scoped_lock sl (mutex);
+    statistics.numBlocksRead = 0;
+    statistics.numMissedDeadlines = 0;
+    statistics.numUnderruns = 0;
+    statistics.maxQueueDepth = (int) queue.size();
+}
+
+void AsyncReadAheadScheduler::addRequest (AsyncReadAheadReader& reader, double deadline)
+{
+    {
+        const std::scoped_lock sl (mutex);
+
+        if (reader.isBeingRead)
+        {
+            // the worker that's reading this stream will queue it again when it's finished
+            reader.pendingDeadline = reader.hasPendingRequest ? jmin (reader.pendingDeadline, deadline) : deadline;
+            reader.hasPendingRequest = true;
+            return;
+        }
+
+        addRequestWhileLocked (reader, deadline);
+    }
+
+    requestAdded.notify_one();
+}
+
+void AsyncReadAheadScheduler::addRequestWhileLocked (AsyncReadAheadReader& reader, double deadline)
+{
+    if (reader.isQueued)
+    {
+        for (auto& request : queue)
+        {
+            if (request.reader == &reader)
+            {
+                request.priority = reader.priority;
+                request.deadline = jmin (request.deadline, deadline);
+                break;
+            }
+        }
+
+        return;
+    }
+
+    queue.push_back ({ &reader, reader.priority, deadline });
+    reader.isQueued = true;
+    statistics.maxQueueDepth = jmax (statistics.maxQueueDepth, (int) queue.size());
+}
+
+void AsyncReadAheadScheduler::finishRequest (AsyncReadAheadReader& reader, std::optional<double> nextDeadline)
+{
+    bool addedRequest = false;
+
+    {
+        const std::scoped_lock sl (mutex);
+        reader.isBeingRead = false;
+
+        if (reader.hasPendingRequest)
+        {
+            nextDeadline = nextDeadline.has_value() ? jmin (*nextDeadline, reader.pendingDeadline)
+                                                    : reader.pendingDeadline;
+            reader.hasPendingRequest = false;
+        }
+
+        if (nextDeadline.has_value())
+        {
+            addRequestWhileLocked (reader, *nextDeadline);
+            addedRequest = true;
+        }
+    }
+
+    if (addedRequest)
+        requestAdded.notify_one();
+
+    requestFinished.notify_all();
+}
+
+void AsyncReadAheadScheduler::removeReader (AsyncReadAheadReader& reader)
+{
+    std::unique_lock ul (mutex);
+    requestFinished.wait (ul, [&] { return ! reader.isBeingRead; });
+
+    if (reader.isQueued)
+    {
+        queue.erase (std::remove_if (queue.begin(), queue.end(), [&] (const Request& r) { return r.reader == &reader; }),
+                     queue.end());
+        reader.isQueued = false;
+    }
+
+    reader.hasPendingRequest = false;
+}
+
+std::optional<AsyncReadAheadScheduler::Request> AsyncReadAheadScheduler::waitForNextRequest()
+{
+    std::unique_lock ul (mutex);
+    requestAdded.wait (ul, [this] { return shuttingDown || ! queue.empty(); });
+
+    if (shuttingDown)
+        return {};
+
+    // the highest priority wins, then the earliest deadline
+    const auto next = std::min_element (queue.begin(), queue.end(), [] (const Request& a, const Request& b)
+    {
+        return a.priority != b.priority ? a.priority > b.priority
+                                        : a.deadline < b.deadline;
+    });
+
+    const auto request = *next;
+    queue.erase (next);
+    request.reader->isQueued = false;
+    request.reader->isBeingRead = true;
+    return request;
+}
+
+std::unique_ptr<AudioBuffer<float>> AsyncReadAheadScheduler::getFreeBuffer (int numChannels)
+{
+    {
+        const std::scoped_lock sl (mutex);
+
+        for (auto i = freeBuffers.size(); i > 0; --i)
+        {
+            if (freeBuffers[i - 1]->getNumChannels() == numChannels)
+            {
+                auto buffer = std::move (freeBuffers[i - 1]);
+                freeBuffers.erase (freeBuffers.begin() + (std::ptrdiff_t) (i - 1));
+                return buffer;
+            }
+        }
+
+        ++statistics.numBuffersAllocated;
+    }
+
+    return std::make_unique<AudioBuffer<float>> (numChannels, samplesPerBlock);
+}
+
+void AsyncReadAheadScheduler::recycleBuffer (std::unique_ptr<AudioBuffer<float>> buffer)
+{
+    if (buffer != nullptr)
+    {
+        const std::scoped_lock sl (mutex);
+        freeBuffers.push_back (std::move (buffer));
+    }
+}
+
+void AsyncReadAheadScheduler::blockFinished (bool missedDeadline)
+{
+    const std::scoped_lock sl (mutex);
+    ++statistics.numBlocksRead;
+
+    if (missedDeadline)
+        ++statistics.numMissedDeadlines;
+}
+
+void AsyncReadAheadScheduler::underrunOccurred()
+{
+    const std::scoped_lock sl (mutex);
+    ++statistics.numUnderruns;
+}
+
+//==============================================================================
+AsyncReadAheadReader::AsyncReadAheadReader (AudioFormatReader* sourceReader,
+                                            AsyncReadAheadScheduler& s,
+                                            int samplesToBuffer,
+                                            int initialPriority)
+    : AudioFormatReader (nullptr, sourceReader->getFormatName()),
+      source (sourceReader), scheduler (s),
+      samplesPerBlock (s.getSamplesPerBlock()),
+      numBlocks (1 + (samplesToBuffer / samplesPerBlock)),
+      priority (initialPriority),
+      blocks ((size_t) numBlocks)
+{
+    sampleRate            = source->sampleRate;
+    lengthInSamples       = source->lengthInSamples;
+    numChannels           = source->numChannels;
+    metadataValues        = source->metadataValues;
+    bitsPerSample         = 32;
+    usesFloatingPointData = true;
+
+    const ScopedLock sl (lock);
+    lastReadTime = Time::getMillisecondCounterHiRes();
+    requestNextBlock();
+}
+
+AsyncReadAheadReader::~AsyncReadAheadReader()
+{
+    scheduler.removeReader (*this);
+
+    for (auto& block : blocks)
+        scheduler.recycleBuffer (std::move (block.buffer));
+}
+
+void AsyncReadAheadReader::setReadTimeout (int timeoutMilliseconds) noexcept
+{
+    timeoutMs = timeoutMilliseconds;
+}
+
+void AsyncReadAheadReader::setPriority (int newPriority) noexcept
+{
+    priority = newPriority;
+}
+
+bool AsyncReadAheadReader::readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                                        int64 startSampleInFile, int numSamples)
+{
+    auto startTime = Time::getMillisecondCounter();
+    clearSamplesBeyondAvailableLength (destSamples, numDestChannels, startOffsetInDestBuffer,
+                                       startSampleInFile, numSamples, lengthInSamples);
+
+    const ScopedLock sl (lock);
+    nextReadPosition = startSampleInFile;
+    lastReadTime = Time::getMillisecondCounterHiRes();
+
+    bool allSamplesRead = true, hadUnderrun = false;
+
+    while (numSamples > 0)
+    {
+        if (auto block = getBlockContaining (startSampleInFile))
+        {
+            auto offset = (int) (startSampleInFile - block->range.getStart());
+            auto numToDo = jmin (numSamples, (int) (block->range.getEnd() - startSampleInFile));
+
+            for (int j = 0; j < numDestChannels; ++j)
+            {
+                if (auto* dest = (float*) destSamples[j])
+                {
+                    dest += startOffsetInDestBuffer;
+
+                    if (j < (int) numChannels)
+                        FloatVectorOperations::copy (dest, block->buffer->getReadPointer (j, offset), numToDo);
+                    else
+                        FloatVectorOperations::clear (dest, numToDo);
+                }
+            }
+
+            startOffsetInDestBuffer += numToDo;
+            startSampleInFile += numToDo;
+            numSamples -= numToDo;
+
+            allSamplesRead = allSamplesRead && block->allSamplesRead;
+        }
+        else
+        {
+            if (! hadUnderrun)
+            {
+                hadUnderrun = true;
+                ++numUnderruns;
+                scheduler.underrunOccurred();
+            }
+
+            nextReadPosition = startSampleInFile;
+            requestNextBlock();
+
+            const auto elapsed = (int) (Time::getMillisecondCounter() - startTime);
+
+            if (timeoutMs >= 0 && elapsed >= timeoutMs)
+            {
+                for (int j = 0; j < numDestChannels; ++j)
+                    if (auto* dest = (float*) destSamples[j])
+                        FloatVectorOperations::clear (dest + startOffsetInDestBuffer, numSamples);
+
+                allSamplesRead = false;
+                break;
+            }
+
+            const ScopedUnlock ul (lock);
+            blockArrived.wait (timeoutMs < 0 ? -1.0 : (double) (timeoutMs - elapsed));
+        }
+    }
+
+    requestNextBlock();
+    return allSamplesRead;
+}
+
+AsyncReadAheadReader::BufferedBlock* AsyncReadAheadReader::getBlockContaining (int64 pos) noexcept
+{
+    for (auto& block : blocks)
+        if (block.buffer != nullptr && block.range.contains (pos))
+            return &block;
+
+    return nullptr;
+}
+
+Range<int64> AsyncReadAheadReader::getBufferWindow() const noexcept
+{
+    const auto pos = (nextReadPosition / samplesPerBlock) * samplesPerBlock;
+    return { pos, jmin (lengthInSamples, pos + (int64) numBlocks * samplesPerBlock) };
+}
+
+int64 AsyncReadAheadReader::findNextBlockToRead()
+{
+    const auto window = getBufferWindow();
+
+    // hand back any blocks that we've played past, or that are no longer needed after a jump..
+    for (auto& block : blocks)
+        if (block.buffer != nullptr && ! window.contains (block.range.getStart()))
+            scheduler.recycleBuffer (std::move (block.buffer));
+
+    for (auto p = window.getStart(); p < window.getEnd(); p += samplesPerBlock)
+        if (getBlockContaining (p) == nullptr)
+            return p;
+
+    return -1;
+}
+
+double AsyncReadAheadReader::getDeadlineForBlock (int64 blockStart) const noexcept
+{
+    if (sampleRate <= 0 || blockStart <= nextReadPosition)
+        return lastReadTime;
+
+    return lastReadTime + 1000.0 * (double) (blockStart - nextReadPosition) / sampleRate;
+}
+
+void AsyncReadAheadReader::requestNextBlock()
+{
+    const auto blockStart = findNextBlockToRead();
+
+    if (blockStart >= 0)
+        scheduler.addRequest (*this, getDeadlineForBlock (blockStart));
+}
+
+std::optional<double> AsyncReadAheadReader::readNextBlock()
+{
+    int64 blockStart;
+    double deadline;
+
+    {
+        const ScopedLock sl (lock);
+        blockStart = findNextBlockToRead();
+        deadline = getDeadlineForBlock (blockStart);
+    }
+
+    if (blockStart >= 0)
+    {
+        // only one thread at a time reads from a stream, so the source doesn't need locking
+        auto buffer = scheduler.getFreeBuffer ((int) numChannels);
+        const auto ok = source->read (buffer.get(), 0, samplesPerBlock, blockStart, true, true);
+        scheduler.blockFinished (Time::getMillisecondCounterHiRes() > deadline);
+
+        {
+            const ScopedLock sl (lock);
+
+            findNextBlockToRead();
+
+            // the play position may have moved on while we were reading..
+            if (getBufferWindow().contains (blockStart) && getBlockContaining (blockStart) == nullptr)
+            {
+                for (auto& block : blocks)
+                {
+                    if (block.buffer == nullptr)
+                    {
+                        block.range = Range<int64> (blockStart, blockStart + samplesPerBlock);
+                        block.buffer = std::move (buffer);
+                        block.allSamplesRead = ok;
+                        break;
+                    }
+                }
+            }
+        }
+
+        scheduler.recycleBuffer (std::move (buffer));
+        blockArrived.signal();
+    }
+
+    const ScopedLock sl (lock);
+    const auto nextBlock = findNextBlockToRead();
+
+    if (nextBlock < 0)
+        return {};
+
+    return getDeadlineForBlock (nextBlock);
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AsyncReadAheadReaderTests final : public UnitTest
+{
+public:
+    AsyncReadAheadReaderTests()  : UnitTest ("AsyncReadAheadReader", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        constexpr int blockSize = 4096;
+        auto random = getRandom();
+
+        beginTest ("Streams that share a scheduler read the same samples as their sources");
+        {
+            AsyncReadAheadScheduler scheduler (3, blockSize);
+            std::vector<AudioBuffer<float>> sources;
+
+            for (int i = 0; i < 16; ++i)
+                sources.push_back (AudioFormatTestHelpers::createTestSignal (random, 1 + (i % 3), 50000 + random.nextInt (20000)));
+
+            std::vector<std::unique_ptr<AsyncReadAheadReader>> readers;
+
+            for (auto& s : sources)
+            {
+                readers.push_back (std::make_unique<AsyncReadAheadReader> (new BufferReader (s), scheduler, 3 * blockSize));
+                readers.back()->setReadTimeout (-1);
+            }
+
+            std::vector<AudioBuffer<float>> results;
+
+            for (auto& s : sources)
+                results.emplace_back (s.getNumChannels(), s.getNumSamples());
+
+            // play all the streams along together, in blocks that don't line up with the reader's
+            for (int pos = 0; pos < 70000; pos += 700)
+                for (size_t i = 0; i < readers.size(); ++i)
+                    if (pos < results[i].getNumSamples())
+                        expect (readers[i]->read (&results[i], pos, jmin (700, results[i].getNumSamples() - pos), pos, true, true));
+
+            for (size_t i = 0; i < sources.size(); ++i)
+                expect (AudioFormatTestHelpers::buffersMatch (sources[i], results[i]));
+
+            // jumping backwards should work too
+            AudioBuffer<float> section (sources[0].getNumChannels(), 5000);
+            expect (readers[0]->read (&section, 0, 5000, 1000, true, true));
+
+            for (int channel = 0; channel < section.getNumChannels(); ++channel)
+                expect (std::memcmp (section.getReadPointer (channel), sources[0].getReadPointer (channel, 1000),
+                                     (size_t) section.getNumSamples() * sizeof (float)) == 0);
+
+            readers.clear();
+
+            const auto stats = scheduler.getStatistics();
+            expectGreaterThan (stats.numBlocksRead, (int64) 0);
+            expectEquals (stats.queueDepth, 0);
+            expectEquals (stats.numBuffersInPool, stats.numBuffersAllocated);
+
+            // at most one extra buffer per stream for the block that's in flight
+            expectLessOrEqual (stats.numBuffersAllocated, 16 * (4 + 1));
+        }
+
+        beginTest ("A stalled stream doesn't hold up the others");
+        {
+            AsyncReadAheadScheduler scheduler (2, blockSize);
+            const auto signal = AudioFormatTestHelpers::createTestSignal (random, 2, 40000);
+
+            WaitableEvent releaseStalledRead (true);
+            auto stalled = std::make_unique<AsyncReadAheadReader> (new BufferReader (signal, waitFor (releaseStalledRead)), scheduler, blockSize);
+
+            std::vector<std::unique_ptr<AsyncReadAheadReader>> readers;
+
+            for (int i = 0; i < 8; ++i)
+            {
+                readers.push_back (std::make_unique<AsyncReadAheadReader> (new BufferReader (signal), scheduler, blockSize));
+                readers.back()->setReadTimeout (-1);
+            }
+
+            for (auto& reader : readers)
+            {
+                AudioBuffer<float> result (2, signal.getNumSamples());
+                expect (reader->read (&result, 0, result.getNumSamples(), 0, true, true));
+                expect (AudioFormatTestHelpers::buffersMatch (signal, result));
+            }
+
+            // ..and the stalled one returns silence after its timeout, counting an underrun
+            AudioBuffer<float> result (2, 1000);
+            result.clear();
+            const auto underrunsBefore = scheduler.getStatistics().numUnderruns;
+            stalled->setReadTimeout (10);
+            expect (! stalled->read (&result, 0, 1000, 0, true, true));
+            expectEquals (result.getMagnitude (0, 1000), 0.0f);
+            expectEquals (stalled->getNumUnderruns(), (int64) 1);
+            expectEquals (scheduler.getStatistics().numUnderruns, underrunsBefore + 1);
+
+            releaseStalledRead.signal();
+            stalled->setReadTimeout (-1);
+            expect (stalled->read (&result, 0, 1000, 0, true, true));
+
+            for (int channel = 0; channel < 2; ++channel)
+                expect (std::memcmp (result.getReadPointer (channel), signal.getReadPointer (channel), 1000 * sizeof (float)) == 0);
+        }
+
+        beginTest ("Higher priority streams are read first");
+        {
+            AsyncReadAheadScheduler scheduler (1, blockSize);
+            const auto signal = AudioFormatTestHelpers::createTestSignal (random, 1, 2 * blockSize);
+
+            // keep the only thread busy while the other streams are queued
+            WaitableEvent releaseGate (true);
+            auto gate = std::make_unique<AsyncReadAheadReader> (new BufferReader (signal, waitFor (releaseGate)), scheduler, 0);
+
+            std::vector<String> readOrder;
+            CriticalSection readOrderLock;
+
+            const auto createReader = [&] (const String& streamName, int priority)
+            {
+                auto* source = new BufferReader (signal, [&, streamName] (int64)
+                {
+                    const ScopedLock sl (readOrderLock);
+                    readOrder.push_back (streamName);
+                });
+
+                return std::make_unique<AsyncReadAheadReader> (source, scheduler, 0, priority);
+            };
+
+            auto low  = createReader ("low",  0);
+            auto high = createReader ("high", 5);
+
+            releaseGate.signal();
+
+            for (auto* reader : { low.get(), high.get() })
+            {
+                AudioBuffer<float> result (1, 100);
+                reader->setReadTimeout (-1);
+                expect (reader->read (&result, 0, 100, 0, true, true));
+            }
+
+            const ScopedLock sl (readOrderLock);
+            expect (readOrder.size() >= 2 && readOrder[0] == "high" && readOrder[1] == "low");
+        }
+    }
+
+private:
+    using BufferReader = AudioFormatTestHelpers::BufferReader;
+
+    static std::function<void (int64)> waitFor (WaitableEvent& gate)
+    {
+        return [&gate] (int64) { gate.wait (-1); };
+    }
+};
+
+static AsyncReadAheadReaderTests asyncReadAheadReaderTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class AsyncReadAheadReader;
+
+//==============================================================================
+/**
+    Runs the background reads for a set of AsyncReadAheadReader objects.
+
+    Each scheduler owns a number of threads which decode blocks of audio for
+    its readers, so that many streams can be read concurrently and a slow read
+    only holds up the stream that it belongs to. Blocks are read in order of
+    the readers' priorities, and within the same priority, in order of how soon
+    the block will be needed by the stream that's playing it.
+
+    The buffers that blocks are read into are recycled between all the readers
+    that share a scheduler, and some statistics are kept so that you can keep an
+    eye on underruns and on the number of streams that are waiting to be read.
+
+    Make sure that all the readers that use a scheduler are deleted before it is.
+
+    @see AsyncReadAheadReader, BufferingAudioReader
+
+    @tags{Audio}
+*/
+class JUCE_API  AsyncReadAheadScheduler
+{
+public:
+    /** Creates a scheduler and starts its threads.
+
+        @param numThreads       the number of threads that will read blocks concurrently
+        @param samplesPerBlock  the number of samples in each block that gets read
+    */
+    explicit AsyncReadAheadScheduler (int numThreads = 4, int samplesPerBlock = 32768);
+
+    /** Destructor. */
+    ~AsyncReadAheadScheduler();
+
+    /** Returns the number of samples that are read into each block. */
+    int getSamplesPerBlock() const noexcept           { return samplesPerBlock; }
+
+    //==============================================================================
+    /** Some counters that show how well the scheduler is keeping up. */
+    struct Statistics
+    {
+        /** The number of blocks that have been read. */
+        int64 numBlocksRead = 0;
+
+        /** The number of blocks that were finished later than the time at which
+            their stream was expected to play them.
+        */
+        int64 numMissedDeadlines = 0;
+
+        /** The number of readSamples() calls that found some of their samples missing. */
+        int64 numUnderruns = 0;
+
+        /** The number of streams that are currently waiting for a thread to read them. */
+        int queueDepth = 0;
+
+        /** The largest queueDepth seen since the statistics were last reset. */
+        int maxQueueDepth = 0;
+
+        /** The number of block buffers that have been allocated. */
+        int numBuffersAllocated = 0;
+
+        /** The number of block buffers that are currently free for re-use. */
+        int numBuffersInPool = 0;
+    };
+
+    /** Returns the current statistics. */
+    Statistics getStatistics() const;
+
+    /** Resets the counters and the maximum queue depth. */
+    void resetStatistics();
+
+private:
+    //==============================================================================
+    friend class AsyncReadAheadReader;
+    class Worker;
+
+    struct Request
+    {
+        AsyncReadAheadReader* reader;
+        int priority;
+        double deadline;
+    };
+
+    void addRequest (AsyncReadAheadReader&, double deadline);
+    void finishRequest (AsyncReadAheadReader&, std::optional<double> nextDeadline);
+    void removeReader (AsyncReadAheadReader&);
+    std::optional<Request> waitForNextRequest();
+    void addRequestWhileLocked (AsyncReadAheadReader&, double deadline);
+
+    std::unique_ptr<AudioBuffer<float>> getFreeBuffer (int numChannels);
+    void recycleBuffer (std::unique_ptr<AudioBuffer<float>>);
+    void blockFinished (bool missedDeadline);
+    void underrunOccurred();
+
+    const int samplesPerBlock;
+
+    mutable std::mutex mutex;
+    std::condition_variable requestAdded, requestFinished;
+    std::vector<Request> queue;
+    std::vector<std::unique_ptr<AudioBuffer<float>>> freeBuffers;
+    Statistics statistics;
+    bool shuttingDown = false;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AsyncReadAheadScheduler)
+};
+
+//==============================================================================
+/**
+    An AudioFormatReader that reads ahead of its play position using the threads
+    of an AsyncReadAheadScheduler.
+
+    Unlike BufferingAudioReader, where a single TimeSliceThread reads each of its
+    clients in turn, this lets many streams share a pool of threads, so a stream
+    whose source is slow to respond doesn't delay the others.
+
+    @see AsyncReadAheadScheduler, BufferingAudioReader
+
+    @tags{Audio}
+*/
+class JUCE_API  AsyncReadAheadReader  : public AudioFormatReader
+{
+public:
+    /** Creates a reader.
+
+        @param sourceReader     the source reader to wrap. This AsyncReadAheadReader
+                                takes ownership of this object and will delete it later
+                                when no longer needed
+        @param scheduler        the scheduler that should do the background reading. It
+                                mustn't be deleted while the reader object still exists
+        @param samplesToBuffer  the total number of samples to buffer ahead
+        @param priority         streams with a higher priority are read before those
+                                with a lower one, whatever their deadlines
+    */
+    AsyncReadAheadReader (AudioFormatReader* sourceReader,
+                          AsyncReadAheadScheduler& scheduler,
+                          int samplesToBuffer,
+                          int priority = 0);
+
+    ~AsyncReadAheadReader() override;
+
+    /** Sets a number of milliseconds that the reader can block for in its readSamples()
+        method before giving up and returning silence.
+
+        A value of less that 0 means "wait forever". The default timeout is 0.
+    */
+    void setReadTimeout (int timeoutMilliseconds) noexcept;
+
+    /** Changes the stream's priority. This takes effect the next time it asks for a block. */
+    void setPriority (int newPriority) noexcept;
+
+    /** Returns the stream's priority. */
+    int getPriority() const noexcept                  { return priority; }
+
+    /** Returns the number of readSamples() calls that found some of their samples missing. */
+    int64 getNumUnderruns() const noexcept            { return numUnderruns; }
+
+    //==============================================================================
+    bool readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                      int64 startSampleInFile, int numSamples) override;
+
+private:
+    friend class AsyncReadAheadScheduler;
+
+    struct BufferedBlock
+    {
+        Range<int64> range;
+        std::unique_ptr<AudioBuffer<float>> buffer;
+        bool allSamplesRead = false;
+    };
+
+    BufferedBlock* getBlockContaining (int64 pos) noexcept;
+    Range<int64> getBufferWindow() const noexcept;
+    int64 findNextBlockToRead();
+    double getDeadlineForBlock (int64 blockStart) const noexcept;
+    void requestNextBlock();
+    std::optional<double> readNextBlock();
+
+    std::unique_ptr<AudioFormatReader> source;
+    AsyncReadAheadScheduler& scheduler;
+    const int samplesPerBlock, numBlocks;
+    std::atomic<int> priority;
+    std::atomic<int64> numUnderruns { 0 };
+    int timeoutMs = 0;
+
+    CriticalSection lock;
+    std::vector<BufferedBlock> blocks;
+    int64 nextReadPosition = 0;
+    double lastReadTime = 0;
+    WaitableEvent blockArrived;
+
+    // these are only used by the scheduler, while holding its lock
+    bool isQueued = false, isBeingRead = false, hasPendingRequest = false;
+    double pendingDeadline = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AsyncReadAheadReader)
+};
+
+} // namespace juce
@@ -161,4 +161,227 @@ AudioFormatReader* AudioFormatManager::createReaderFor (std::unique_ptr<InputStr
     return nullptr;
 }
 
+//==============================================================================
+static String getDecodedCacheFilePrefix (const File& audioFile)
+{
+    return audioFile.getFileNameWithoutExtension() + "_"
+             + String::toHexString (audioFile.getFullPathName().hashCode64()) + "_";
+}
+
+static String getDecodedCacheFileVersion (const File& audioFile)
+{
+    return String::toHexString (audioFile.getSize()) + "_"
+             + String::toHexString (audioFile.getLastModificationTime().toMilliseconds()) + "_";
+}
+
+void AudioFormatManager::setDecodedCacheDirectory (const File& directory, DecodedCacheFormat format)
+{
+    decodedCacheDirectory = directory;
+    decodedCacheFormat = format;
+}
+
+File AudioFormatManager::getDecodedCacheFileFor (const File& audioFile) const
+{
+    if (decodedCacheDirectory == File())
+        return {};
+
+    return decodedCacheDirectory.getChildFile (getDecodedCacheFilePrefix (audioFile)
+                                                 + getDecodedCacheFileVersion (audioFile)
+                                                 + (decodedCacheFormat == DecodedCacheFormat::int16Bit ? "s16" : "f32")
+                                                 + ".wav");
+}
+
+MemoryMappedAudioFormatReader* AudioFormatManager::createMemoryMappedReaderFor (const File& file)
+{
+    // you need to actually register some formats before the manager can
+    // use them to open a file!
+    jassert (getNumKnownFormats() > 0);
+
+    for (auto* af : knownFormats)
+        if (af->canHandleFile (file))
+            if (auto* r = af->createMemoryMappedReader (file))
+                return r;
+
+    auto cacheFile = getDecodedCacheFileFor (file);
+
+    if (cacheFile == File() || ! file.existsAsFile())
+        return nullptr;
+
+    if (! cacheFile.existsAsFile() && ! writeDecodedCacheFile (file, cacheFile))
+        return nullptr;
+
+    return WavAudioFormat().createMemoryMappedReader (cacheFile);
+}
+
+bool AudioFormatManager::writeDecodedCacheFile (const File& audioFile, const File& cacheFile)
+{
+    std::unique_ptr<AudioFormatReader> reader (createReaderFor (audioFile));
+
+    if (reader == nullptr || ! cacheFile.getParentDirectory().createDirectory())
+        return false;
+
+    {
+        // the data is written to a temporary file which is then moved into place, so that
+        // other processes sharing the cache never see a partly-written file
+        TemporaryFile temp (cacheFile);
+        std::unique_ptr<AudioFormatWriter> writer;
+
+        if (auto out = temp.getFile().createOutputStream())
+        {
+            writer.reset (WavAudioFormat().createWriterFor (out.get(), reader->sampleRate, reader->numChannels,
+                                                            decodedCacheFormat == DecodedCacheFormat::int16Bit ? 16 : 32,
+                                                            {}, 0));
+
+            if (writer != nullptr)
+                out.release();
+        }
+
+        if (writer == nullptr || ! writer->writeFromAudioReader (*reader, 0, -1))
+            return false;
+
+        writer.reset();
+
+        if (! temp.overwriteTargetFileWithTemporary())
+            return false;
+    }
+
+    // remove anything that was decoded from an older version of the source file
+    const auto prefix = getDecodedCacheFilePrefix (audioFile);
+    const auto currentPrefix = prefix + getDecodedCacheFileVersion (audioFile);
+
+    for (auto& f : cacheFile.getParentDirectory().findChildFiles (File::findFiles, false, prefix + "*"))
+        if (f.getFileName().startsWith (prefix) && ! f.getFileName().startsWith (currentPrefix))
+            f.deleteFile();
+
+    return true;
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS && JUCE_USE_FLAC
+
+class AudioFormatManagerDecodedCacheTests final : public UnitTest
+{
+public:
+    AudioFormatManagerDecodedCacheTests()
+        : UnitTest ("AudioFormatManager decoded cache", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        const auto directory = File::getSpecialLocation (File::tempDirectory)
+                                   .getNonexistentChildFile ("JUCE_DecodedCacheTest", {}, false);
+        expect (directory.createDirectory());
+
+        const auto cacheDirectory = directory.getChildFile ("cache");
+        const auto flacFile = directory.getChildFile ("sample.flac");
+        const auto wavFile = directory.getChildFile ("sample.wav");
+
+        auto random = getRandom();
+        const auto signal = AudioFormatTestHelpers::createTestSignal (random, 2, 30000);
+
+        FlacAudioFormat flac;
+        WavAudioFormat wav;
+        expect (writeFile (flac, flacFile, signal, 16));
+        expect (writeFile (wav, wavFile, signal, 16));
+
+        AudioFormatManager manager;
+        manager.registerBasicFormats();
+
+        beginTest ("Formats that can be mapped are mapped directly");
+        {
+            std::unique_ptr<MemoryMappedAudioFormatReader> reader (manager.createMemoryMappedReaderFor (wavFile));
+            expect (reader != nullptr && reader->getFile() == wavFile);
+            expect (manager.createMemoryMappedReaderFor (flacFile) == nullptr);
+        }
+
+        beginTest ("Compressed files are decoded into the cache and mapped");
+        {
+            manager.setDecodedCacheDirectory (cacheDirectory);
+            const auto expected = readAll (manager, flacFile);
+
+            std::unique_ptr<MemoryMappedAudioFormatReader> reader (manager.createMemoryMappedReaderFor (flacFile));
+            expect (reader != nullptr);
+
+            const auto cacheFile = manager.getDecodedCacheFileFor (flacFile);
+            expect (reader->getFile() == cacheFile && cacheFile.existsAsFile());
+            expect (reader->mapEntireFile());
+            expectEquals (reader->lengthInSamples, (int64) expected.getNumSamples());
+            expect (matches (*reader, expected, 0.0f));
+
+            // a second reader should use the same file rather than decoding it again
+            const auto writeTime = cacheFile.getLastModificationTime();
+            std::unique_ptr<MemoryMappedAudioFormatReader> second (manager.createMemoryMappedReaderFor (flacFile));
+            expect (second != nullptr && second->getFile() == cacheFile);
+            expect (cacheFile.getLastModificationTime() == writeTime);
+            expectEquals (cacheDirectory.getNumberOfChildFiles (File::findFiles), 1);
+        }
+
+        beginTest ("16-bit cache files");
+        {
+            manager.setDecodedCacheDirectory (cacheDirectory, AudioFormatManager::DecodedCacheFormat::int16Bit);
+            const auto expected = readAll (manager, flacFile);
+
+            std::unique_ptr<MemoryMappedAudioFormatReader> reader (manager.createMemoryMappedReaderFor (flacFile));
+            expect (reader != nullptr && reader->mapEntireFile());
+            expectEquals ((int) reader->bitsPerSample, 16);
+            expect (matches (*reader, expected, 1.0f / 16384.0f));
+        }
+
+        beginTest ("Changing the source replaces its cache files");
+        {
+            manager.setDecodedCacheDirectory (cacheDirectory);
+            const auto oldCacheFile = manager.getDecodedCacheFileFor (flacFile);
+
+            AudioBuffer<float> shorter (signal.getNumChannels(), 20000);
+
+            for (int channel = 0; channel < shorter.getNumChannels(); ++channel)
+                shorter.copyFrom (channel, 0, signal, channel, 0, shorter.getNumSamples());
+
+            expect (writeFile (flac, flacFile, shorter, 16));
+
+            std::unique_ptr<MemoryMappedAudioFormatReader> reader (manager.createMemoryMappedReaderFor (flacFile));
+            expect (reader != nullptr && reader->mapEntireFile());
+            expectEquals (reader->lengthInSamples, (int64) 20000);
+            expect (reader->getFile() != oldCacheFile);
+            expectEquals (cacheDirectory.getNumberOfChildFiles (File::findFiles), 1);
+        }
+
+        directory.deleteRecursively();
+    }
+
+private:
+    static bool writeFile (AudioFormat& format, const File& file, const AudioBuffer<float>& buffer, int bitsPerSample)
+    {
+        file.deleteFile();
+        return AudioFormatTestHelpers::writeToStream (format, file.createOutputStream(), buffer, bitsPerSample);
+    }
+
+    static AudioBuffer<float> readAll (AudioFormatManager& manager, const File& file)
+    {
+        std::unique_ptr<AudioFormatReader> reader (manager.createReaderFor (file));
+        AudioBuffer<float> result ((int) reader->numChannels, (int) reader->lengthInSamples);
+        reader->read (&result, 0, result.getNumSamples(), 0, true, true);
+        return result;
+    }
+
+    static bool matches (AudioFormatReader& reader, const AudioBuffer<float>& expected, float tolerance)
+    {
+        AudioBuffer<float> result (expected.getNumChannels(), expected.getNumSamples());
+
+        if (! reader.read (&result, 0, result.getNumSamples(), 0, true, true))
+            return false;
+
+        for (int channel = 0; channel < expected.getNumChannels(); ++channel)
+            for (int i = 0; i < expected.getNumSamples(); ++i)
+                if (std::abs (result.getSample (channel, i) - expected.getSample (channel, i)) > tolerance)
+                    return false;
+
+        return true;
+    }
+};
+
+static AudioFormatManagerDecodedCacheTests audioFormatManagerDecodedCacheTests;
+
+#endif
+
 } // namespace juce
@@ -139,11 +139,68 @@ public:
     */
     AudioFormatReader* createReaderFor (std::unique_ptr<InputStream> audioFileStream);
 
+    //==============================================================================
+    /** The sample formats that decoded cache files can be written in.
+
+        @see setDecodedCacheDirectory
+    */
+    enum class DecodedCacheFormat
+    {
+        float32Bit, /**< 32-bit floating point, which keeps the decoded samples exactly. */
+        int16Bit    /**< 16-bit integer, which needs half the disk space and memory. */
+    };
+
+    /** Enables a cache of decoded audio files, for formats that can't be memory-mapped.
+
+        Once a directory has been set, createMemoryMappedReaderFor() will decode files
+        in compressed formats such as FLAC or Ogg-Vorbis into uncompressed WAV files in
+        this directory the first time they're opened, and will map those instead. The
+        cache files are named after the source file's path, size and modification time,
+        so other processes that use the same directory will share them, and a cache file
+        is replaced when its source file changes.
+
+        Pass File() to disable the cache, which is the default.
+
+        @see createMemoryMappedReaderFor, getDecodedCacheFileFor
+    */
+    void setDecodedCacheDirectory (const File& directory,
+                                   DecodedCacheFormat format = DecodedCacheFormat::float32Bit);
+
+    /** Returns the directory that was set with setDecodedCacheDirectory(). */
+    const File& getDecodedCacheDirectory() const noexcept         { return decodedCacheDirectory; }
+
+    /** Returns the file in the decoded cache directory that would hold the decoded
+        version of the given file. This will return File() if there's no cache directory.
+    */
+    File getDecodedCacheFileFor (const File& audioFile) const;
+
+    /** Tries to create a memory-mapped reader for a file.
+
+        If the format that handles the file supports memory-mapping, e.g. WAV or AIFF,
+        the file itself will be mapped. Otherwise, if a decoded cache directory has been
+        set, the file will be decoded into the cache (unless that's already been done)
+        and the cache file will be mapped instead.
+
+        As with any MemoryMappedAudioFormatReader, you'll need to call mapEntireFile()
+        or mapSectionOfFile() on the reader before you can read from it.
+
+        If the file can't be mapped, it'll return nullptr. Otherwise, it's the caller's
+        responsibility to delete the reader that is returned.
+
+        @see setDecodedCacheDirectory
+    */
+    MemoryMappedAudioFormatReader* createMemoryMappedReaderFor (const File& audioFile);
+
 private:
     //==============================================================================
     OwnedArray<AudioFormat> knownFormats;
     int defaultFormatIndex = 0;
 
+    File decodedCacheDirectory;
+    DecodedCacheFormat decodedCacheFormat = DecodedCacheFormat::float32Bit;
+
+    bool writeDecodedCacheFile (const File& audioFile, const File& cacheFile);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioFormatManager)
 };
 
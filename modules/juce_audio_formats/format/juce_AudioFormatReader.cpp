@@ -206,6 +206,110 @@ bool AudioFormatReader::read (AudioBuffer<float>* buffer,
                          readerStartSample, numTargetChannels, ! usesFloatingPointData);
 }
 
+//==============================================================================
+class ParallelChunkReadJob final : public ThreadPoolJob
+{
+public:
+    explicit ParallelChunkReadJob (std::function<void()> workToDo)
+        : ThreadPoolJob ("Parallel audio read"), work (std::move (workToDo))
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        work();
+        return jobHasFinished;
+    }
+
+private:
+    std::function<void()> work;
+
+    JUCE_DECLARE_NON_COPYABLE (ParallelChunkReadJob)
+};
+
+bool AudioFormatReader::readInParallel (AudioBuffer<float>& buffer,
+                                        int startSample,
+                                        int numSamples,
+                                        int64 readerStartSample,
+                                        ThreadPool& threadPool,
+                                        const std::function<std::unique_ptr<AudioFormatReader>()>& createReader,
+                                        int minimumChunkSize)
+{
+    jassert (startSample >= 0 && startSample + numSamples <= buffer.getNumSamples());
+
+    if (numSamples <= 0)
+        return true;
+
+    const auto numWorkers = createReader != nullptr ? threadPool.getNumThreads() : 0;
+
+    // a few chunks per thread keeps all of them busy if some chunks take longer to decode
+    const auto targetNumChunks = jmin ((numWorkers + 1) * 4, numSamples / jmax (1, minimumChunkSize));
+
+    if (numWorkers == 0 || targetNumChunks < 2)
+        return read (&buffer, startSample, numSamples, readerStartSample, true, true);
+
+    const auto readerEndSample = readerStartSample + numSamples;
+    Array<int64> chunkStarts { readerStartSample };
+
+    for (int i = 1; i < targetNumChunks; ++i)
+    {
+        auto pos = getSeekPointBefore (readerStartSample + (int64) numSamples * i / targetNumChunks);
+
+        if (pos > chunkStarts.getLast() && pos < readerEndSample)
+            chunkStarts.add (pos);
+    }
+
+    chunkStarts.add (readerEndSample);
+
+    const auto numChunks = chunkStarts.size() - 1;
+    auto* const* channels = buffer.getArrayOfWritePointers();
+    const auto numBufferChannels = buffer.getNumChannels();
+    std::atomic<int> nextChunk { 0 };
+    std::atomic<bool> allChunksRead { true };
+
+    const auto readChunks = [&] (AudioFormatReader& reader)
+    {
+        for (auto chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++)
+        {
+            const auto chunkStart = chunkStarts.getUnchecked (chunk);
+            const auto chunkLength = (int) (chunkStarts.getUnchecked (chunk + 1) - chunkStart);
+            AudioBuffer<float> chunkBuffer (channels, numBufferChannels,
+                                            startSample + (int) (chunkStart - readerStartSample), chunkLength);
+
+            if (! reader.read (&chunkBuffer, 0, chunkLength, chunkStart, true, true))
+                allChunksRead = false;
+        }
+    };
+
+    std::vector<std::unique_ptr<ParallelChunkReadJob>> jobs;
+
+    for (int i = jmin (numWorkers, numChunks - 1); --i >= 0;)
+    {
+        jobs.push_back (std::make_unique<ParallelChunkReadJob> ([&]
+        {
+            if (nextChunk.load() < numChunks)
+                if (auto reader = createReader())
+                    readChunks (*reader);
+        }));
+
+        threadPool.addJob (jobs.back().get(), false);
+    }
+
+    readChunks (*this);
+
+    // jobs that haven't started yet are just taken out of the pool
+    for (auto& job : jobs)
+        threadPool.removeJob (job.get(), false, -1);
+
+    return allChunksRead;
+}
+
+int64 AudioFormatReader::getSeekPointBefore (int64 samplePosition)
+{
+    return samplePosition;
+}
+
+//==============================================================================
 void AudioFormatReader::readMaxLevels (int64 startSampleInFile, int64 numSamples,
                                        Range<float>* const results, const int channelsToRead)
 {
@@ -450,4 +554,181 @@ void MemoryMappedAudioFormatReader::touchSample (int64 sample) const noexcept
         jassertfalse; // you must make sure that the window contains all the samples you're going to attempt to read.
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioFormatReaderParallelReadTests final : public UnitTest
+{
+public:
+    AudioFormatReaderParallelReadTests()
+        : UnitTest ("AudioFormatReader parallel reading", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        ThreadPool pool (ThreadPoolOptions{}.withNumberOfThreads (3));
+        auto random = getRandom();
+
+        beginTest ("Parallel reads match sequential reads and start chunks at seek points");
+        {
+            const auto source = AudioFormatTestHelpers::createTestSignal (random, 2, 300000);
+            std::vector<int64> readStarts;
+            CriticalSection readStartsLock;
+
+            const auto createReader = [&]
+            {
+                return std::make_unique<SeekPointReader> (source, readStarts, readStartsLock);
+            };
+
+            for (const auto& range : { Range<int64> { 0, 300000 },
+                                       Range<int64> { 1234, 250000 },
+                                       Range<int64> { -5000, 320000 } })
+            {
+                readStarts.clear();
+                auto reader = createReader();
+
+                const auto numSamples = (int) range.getLength();
+                AudioBuffer<float> expected (2, numSamples + 20), result (2, numSamples + 20);
+                expected.clear();
+                result.clear();
+
+                expect (reader->read (&expected, 10, numSamples, range.getStart(), true, true));
+                readStarts.clear();
+                expect (reader->readInParallel (result, 10, numSamples, range.getStart(), pool, createReader, 4096));
+                expect (AudioFormatTestHelpers::buffersMatch (expected, result));
+
+                expectGreaterThan ((int) readStarts.size(), 1);
+
+                for (auto start : readStarts)
+                    expect (start == range.getStart() || start % SeekPointReader::seekPointSpacing == 0);
+            }
+        }
+
+        beginTest ("Short ranges and calls without a createReader function are read sequentially");
+        {
+            const auto source = AudioFormatTestHelpers::createTestSignal (random, 2, 50000);
+            std::vector<int64> readStarts;
+            CriticalSection readStartsLock;
+            int numReadersCreated = 0;
+
+            const auto createReader = [&]
+            {
+                ++numReadersCreated;
+                return std::make_unique<SeekPointReader> (source, readStarts, readStartsLock);
+            };
+
+            SeekPointReader reader (source, readStarts, readStartsLock);
+            AudioBuffer<float> result (2, 50000);
+
+            expect (reader.readInParallel (result, 0, 50000, 0, pool, createReader, 40000));
+            expect (reader.readInParallel (result, 0, 50000, 0, pool, nullptr, 1000));
+            expect (AudioFormatTestHelpers::buffersMatch (source, result));
+            expectEquals (numReadersCreated, 0);
+        }
+
+       #if JUCE_USE_FLAC
+        beginTest ("FLAC");
+        {
+            FlacAudioFormat format;
+            checkRoundTrip (format, random, pool);
+        }
+       #endif
+
+       #if JUCE_USE_OGGVORBIS
+        beginTest ("Ogg-Vorbis");
+        {
+            OggVorbisAudioFormat format;
+            checkRoundTrip (format, random, pool);
+        }
+       #endif
+    }
+
+private:
+    // Set this to a few hours' worth to benchmark scaling on long files.
+    static constexpr int benchmarkLengthSeconds = 30;
+
+    // Logs where each read starts, and has a seek point every seekPointSpacing samples
+    struct SeekPointReader final : public AudioFormatTestHelpers::BufferReader
+    {
+        static constexpr int64 seekPointSpacing = 10000;
+
+        SeekPointReader (const AudioBuffer<float>& b, std::vector<int64>& readStarts, CriticalSection& readStartsLock)
+            : BufferReader (b, [starts = &readStarts, lock = &readStartsLock] (int64 start)
+              {
+                  const ScopedLock sl (*lock);
+                  starts->push_back (start);
+              })
+        {}
+
+        int64 getSeekPointBefore (int64 samplePosition) override
+        {
+            return samplePosition - samplePosition % seekPointSpacing;
+        }
+    };
+
+    void checkRoundTrip (AudioFormat& format, Random& random, ThreadPool& pool)
+    {
+        const auto numSamples = (int) AudioFormatTestHelpers::sampleRate * benchmarkLengthSeconds;
+        MemoryBlock block;
+        expect (AudioFormatTestHelpers::writeToStream (format, std::make_unique<MemoryOutputStream> (block, false),
+                                                       AudioFormatTestHelpers::createTestSignal (random, 2, numSamples), 16));
+
+        const auto createReader = [&format, &block]
+        {
+            return std::unique_ptr<AudioFormatReader> (format.createReaderFor (new MemoryInputStream (block, false), true));
+        };
+
+        auto reader = createReader();
+        expect (reader != nullptr);
+
+        if (reader == nullptr)
+            return;
+
+        expectEquals (reader->lengthInSamples, (int64) numSamples);
+
+        AudioBuffer<float> expected (2, numSamples), result (2, numSamples);
+
+        auto startTime = Time::getMillisecondCounterHiRes();
+        expect (reader->read (&expected, 0, numSamples, 0, true, true));
+        const auto sequentialTime = Time::getMillisecondCounterHiRes() - startTime;
+
+        startTime = Time::getMillisecondCounterHiRes();
+        expect (reader->readInParallel (result, 0, numSamples, 0, pool, createReader));
+        const auto parallelTime = Time::getMillisecondCounterHiRes() - startTime;
+
+        expect (AudioFormatTestHelpers::buffersMatch (expected, result));
+
+        const auto sectionMatches = [&expected] (const AudioBuffer<float>& section, int start)
+        {
+            for (int channel = 0; channel < section.getNumChannels(); ++channel)
+                if (std::memcmp (section.getReadPointer (channel), expected.getReadPointer (channel, start),
+                                 (size_t) section.getNumSamples() * sizeof (float)) != 0)
+                    return false;
+
+            return true;
+        };
+
+        // each chunk starts with a seek on a newly opened reader
+        for (auto start : { 1000, 82687, 330750, 500000, numSamples - 1000 })
+        {
+            AudioBuffer<float> section (2, 1000);
+            expect (createReader()->read (&section, 0, 1000, start, true, true));
+            expect (sectionMatches (section, start));
+        }
+
+        const Range<int> subRange { 123456, numSamples - 98765 };
+        AudioBuffer<float> section (2, subRange.getLength());
+        expect (createReader()->readInParallel (section, 0, subRange.getLength(), subRange.getStart(), pool, createReader));
+        expect (sectionMatches (section, subRange.getStart()));
+
+        logMessage (format.getFormatName() + ", " + String (benchmarkLengthSeconds) + "s stereo: sequential "
+                    + String (sequentialTime, 1) + " ms, " + String (pool.getNumThreads() + 1) + " threads "
+                    + String (parallelTime, 1) + " ms (" + String (SystemStats::getNumCpus()) + " CPUs)");
+    }
+};
+
+static AudioFormatReaderParallelReadTests audioFormatReaderParallelReadTests;
+
+#endif
+
 } // namespace juce
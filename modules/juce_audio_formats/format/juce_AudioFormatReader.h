@@ -151,6 +151,44 @@ public:
                bool useReaderLeftChan,
                bool useReaderRightChan);
 
+    /** Fills a section of an AudioBuffer from this reader, decoding several chunks of it at once.
+
+        The range is split into chunks, starting where possible at the positions returned
+        by getSeekPointBefore(), and these are decoded by independent readers on the threads
+        of the given pool, each one writing directly into its own region of the buffer. The
+        calling thread decodes chunks too, using this reader, and the method returns when
+        the whole range has been filled, so the result is the same as calling read() with
+        the same range.
+
+        A reader can't share its input stream, so createReader must return a new reader for
+        the same source each time it's called, e.g. by re-opening the file. It's called at most
+        once by each job that gets added to the pool, on the pool's threads. If it returns
+        nullptr, the chunks are just left for the other threads.
+
+        Ranges that are shorter than two chunks of minimumChunkSize samples, or calls without a
+        createReader function, are just read on the calling thread in the same way as read() does.
+
+        @returns    true if all the chunks were read successfully
+        @see getSeekPointBefore
+    */
+    bool readInParallel (AudioBuffer<float>& buffer,
+                         int startSampleInDestBuffer,
+                         int numSamples,
+                         int64 readerStartSample,
+                         ThreadPool& threadPool,
+                         const std::function<std::unique_ptr<AudioFormatReader>()>& createReader,
+                         int minimumChunkSize = 65536);
+
+    /** Returns the nearest position at or before the given one from which this reader can
+        start decoding without having to decode any of the preceding audio first.
+
+        readInParallel() uses this to choose where to split a range into chunks. Formats
+        that store seek points, e.g. FLAC seek tables or Ogg page granule positions, can
+        override it so that each chunk starts exactly where the decoder can resume. The
+        default implementation just returns the position that was passed in.
+    */
+    virtual int64 getSeekPointBefore (int64 samplePosition);
+
     /** Finds the highest and lowest sample levels from a section of the audio stream.
 
         This will read a block of samples from the stream, and measure the
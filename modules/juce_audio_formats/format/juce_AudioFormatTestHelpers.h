@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::AudioFormatTestHelpers
+{
+
+static constexpr double sampleRate = 44100.0;
+
+/*  A sine for each channel, at a different frequency, with some noise added so that
+    the samples don't repeat.
+*/
+static AudioBuffer<float> createTestSignal (Random& random, int numChannels, int numSamples)
+{
+    AudioBuffer<float> buffer (numChannels, numSamples);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* data = buffer.getWritePointer (channel);
+
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = 0.5f * std::sin ((float) i * 0.01f * (float) (channel + 1))
+                        + 0.1f * (random.nextFloat() - 0.5f);
+    }
+
+    return buffer;
+}
+
+/*  Returns true if the buffers have the same size and contain exactly the same samples. */
+static bool buffersMatch (const AudioBuffer<float>& a, const AudioBuffer<float>& b)
+{
+    if (a.getNumChannels() != b.getNumChannels() || a.getNumSamples() != b.getNumSamples())
+        return false;
+
+    for (int channel = 0; channel < a.getNumChannels(); ++channel)
+        if (std::memcmp (a.getReadPointer (channel), b.getReadPointer (channel),
+                         (size_t) a.getNumSamples() * sizeof (float)) != 0)
+            return false;
+
+    return true;
+}
+
+/*  Writes the buffer to a stream in the given format, which takes ownership of the stream. */
+static bool writeToStream (AudioFormat& format, std::unique_ptr<OutputStream> stream,
+                           const AudioBuffer<float>& buffer, int bitsPerSample)
+{
+    if (stream == nullptr)
+        return false;
+
+    std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (stream.get(), sampleRate,
+                                                                       (unsigned int) buffer.getNumChannels(),
+                                                                       bitsPerSample, {}, 0));
+
+    if (writer == nullptr)
+        return false;
+
+    stream.release();
+    return writer->writeFromAudioSampleBuffer (buffer, 0, buffer.getNumSamples());
+}
+
+//==============================================================================
+/*  A reader that plays back the contents of a buffer. The onRead function, if there is
+    one, is called with the start of each block before it's read, which lets tests log
+    or hold up the reads.
+*/
+struct BufferReader : public AudioFormatReader
+{
+    explicit BufferReader (const AudioBuffer<float>& b, std::function<void (int64)> onReadCallback = {})
+        : AudioFormatReader (nullptr, "Test"), buffer (b), onRead (std::move (onReadCallback))
+    {
+        sampleRate            = AudioFormatTestHelpers::sampleRate;
+        bitsPerSample         = 32;
+        usesFloatingPointData = true;
+        lengthInSamples       = buffer.getNumSamples();
+        numChannels           = (unsigned int) buffer.getNumChannels();
+    }
+
+    bool readSamples (int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                      int64 startSampleInFile, int numSamples) override
+    {
+        if (onRead != nullptr)
+            onRead (startSampleInFile);
+
+        clearSamplesBeyondAvailableLength (destChannels, numDestChannels, startOffsetInDestBuffer,
+                                           startSampleInFile, numSamples, lengthInSamples);
+
+        for (int i = 0; i < numDestChannels && numSamples > 0; ++i)
+            if (auto* dest = reinterpret_cast<float*> (destChannels[i]))
+                FloatVectorOperations::copy (dest + startOffsetInDestBuffer,
+                                             buffer.getReadPointer (i, (int) startSampleInFile), numSamples);
+
+        return true;
+    }
+
+    const AudioBuffer<float>& buffer;
+    std::function<void (int64)> onRead;
+};
+
+} // namespace juce::AudioFormatTestHelpers
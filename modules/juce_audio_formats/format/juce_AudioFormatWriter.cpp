@@ -78,6 +78,14 @@ static void convertFloatsToInts (int* dest, const float* src, int numSamples) no
     }
 }
 
+void AudioFormatWriter::convertFloatsToFixedPoint (int* dest, const float* source, int numSamples) noexcept
+{
+    if (ditherEnabled && bitsPerSample < 32)
+        dither.convertFloatToInt32 (source, dest, numSamples, jlimit (2, 24, (int) bitsPerSample));
+    else
+        convertFloatsToInts (dest, source, numSamples);
+}
+
 bool AudioFormatWriter::writeFromAudioReader (AudioFormatReader& reader,
                                               int64 startSample,
                                               int64 numSamplesToRead)
@@ -113,7 +121,7 @@ bool AudioFormatWriter::writeFromAudioReader (AudioFormatReader& reader,
                 if (isFloatingPoint())
                     FloatVectorOperations::convertFixedToFloat ((float*) b, (int*) b, scaleFactor, numToDo);
                 else
-                    convertFloatsToInts ((int*) b, (float*) b, numToDo);
+                    convertFloatsToFixedPoint ((int*) b, (float*) b, numToDo);
             }
         }
 
@@ -174,7 +182,7 @@ bool AudioFormatWriter::writeFromFloatArrays (const float* const* channels, int
         auto numToDo = jmin (numSamples, maxSamples);
 
         for (int i = 0; i < numSourceChannels; ++i)
-            convertFloatsToInts (chans[(size_t) i], channels[(size_t) i] + startSample, numToDo);
+            convertFloatsToFixedPoint (chans[(size_t) i], channels[(size_t) i] + startSample, numToDo);
 
         if (! write ((const int**) chans.data(), numToDo))
             return false;
@@ -175,6 +175,21 @@ public:
     /** Returns true if it's a floating-point format, false if it's fixed-point. */
     bool isFloatingPoint() const noexcept       { return usesFloatingPointData; }
 
+    /** Enables or disables TPDF dither when floating point data is written to a fixed-point format.
+
+        When this is enabled, writeFromFloatArrays(), writeFromAudioSampleBuffer() and
+        writeFromAudioReader() add triangular dither at the writer's bit depth before
+        quantising float samples, instead of simply rounding them. It's disabled by default.
+
+        @see AudioData::TPDFDither
+    */
+    void setDitherEnabled (bool shouldDither) noexcept      { ditherEnabled = shouldDither; }
+
+    /** Returns true if dither is enabled.
+        @see setDitherEnabled
+    */
+    bool isDitherEnabled() const noexcept                   { return ditherEnabled; }
+
     //==============================================================================
     /**
         Provides a FIFO for an AudioFormatWriter, allowing you to push incoming
@@ -272,13 +287,34 @@ protected:
         static void write (void* destData, int numDestChannels, const int* const* source,
                            int numSamples, const int sourceOffset = 0) noexcept
         {
+            int numDone = 0;
+
+            // stereo is the most common case, and can be interleaved in one pass
+            if (numDestChannels == 2 && source[0] != nullptr && source[1] != nullptr)
+            {
+                using VectorisedConversion = AudioData::VectorisedConversion;
+                constexpr auto destFormat = VectorisedConversion::getPackedFormat<DestSampleType>();
+
+                if constexpr (std::is_same_v<SourceSampleType, AudioData::Int32>)
+                {
+                    const int32* channels[] = { source[0] + sourceOffset, source[1] + sourceOffset };
+                    numDone = VectorisedConversion::int32ToPacked (destFormat, DestType::isBigEndian(), channels, 2, destData, numSamples);
+                }
+                else if constexpr (std::is_same_v<SourceSampleType, AudioData::Float32>)
+                {
+                    const float* channels[] = { reinterpret_cast<const float*> (source[0] + sourceOffset),
+                                                reinterpret_cast<const float*> (source[1] + sourceOffset) };
+                    numDone = VectorisedConversion::floatToPacked (destFormat, DestType::isBigEndian(), channels, 2, destData, numSamples);
+                }
+            }
+
             for (int i = 0; i < numDestChannels; ++i)
             {
                 const DestType dest (addBytesToPointer (destData, i * DestType::getBytesPerSample()), numDestChannels);
 
                 if (*source != nullptr)
                 {
-                    dest.convertSamples (SourceType (*source + sourceOffset), numSamples);
+                    (dest + numDone).convertSamples (SourceType (*source + sourceOffset + numDone), numSamples - numDone);
                     ++source;
                 }
                 else
@@ -291,8 +327,12 @@ protected:
 
 private:
     String formatName;
+    AudioData::TPDFDither dither;
+    bool ditherEnabled = false;
     friend class ThreadedWriter;
 
+    void convertFloatsToFixedPoint (int* dest, const float* source, int numSamples) noexcept;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioFormatWriter)
 };
 
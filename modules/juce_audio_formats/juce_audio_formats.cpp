@@ -52,6 +52,10 @@
 #endif
 
 //==============================================================================
+#if JUCE_UNIT_TESTS
+ #include "format/juce_AudioFormatTestHelpers.h"
+#endif
+
 #include "format/juce_AudioFormat.cpp"
 #include "format/juce_AudioFormatManager.cpp"
 #include "format/juce_AudioFormatReader.cpp"
@@ -59,6 +63,7 @@
 #include "format/juce_AudioFormatWriter.cpp"
 #include "format/juce_AudioSubsectionReader.cpp"
 #include "format/juce_BufferingAudioFormatReader.cpp"
+#include "format/juce_AsyncReadAheadReader.cpp"
 #include "sampler/juce_Sampler.cpp"
 #include "codecs/juce_AiffAudioFormat.cpp"
 #include "codecs/juce_CoreAudioFormat.cpp"
@@ -535,6 +535,9 @@ public:
         midiMessages.ensureSize (2048);
         midiMessages.clear();
 
+        processor.getParameterAutomation().ensureSize (2048);
+        processor.getParameterAutomation().clear();
+
         hostMusicalContextCallback = [au musicalContextBlock];
         hostTransportStateCallback = [au transportStateBlock];
 
@@ -1459,6 +1462,12 @@ private:
                     {
                         auto normalisedValue = paramEvent.value / getMaximumParameterValue (*p);
                         setAudioProcessorParameter (p, normalisedValue);
+
+                        // A ramp's value is the one reached at its end, which is usually
+                        // beyond this block, so it's recorded as a change at the ramp's start
+                        getAudioProcessor().getParameterAutomation().addEvent (*p,
+                                                                               normalisedValue,
+                                                                               static_cast<int> (paramEvent.eventSampleTime - startTime));
                     }
                 }
                 break;
@@ -1483,6 +1492,7 @@ private:
         {
             // process params and incoming midi (only once for a given timestamp)
             midiMessages.clear();
+            getAudioProcessor().getParameterAutomation().clear();
 
             const int numParams = juceParameters.getNumParameters();
             processEvents (realtimeEventListHead, numParams, static_cast<AUEventSampleTime> (timestamp->mSampleTime));
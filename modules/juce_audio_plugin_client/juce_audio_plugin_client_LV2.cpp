@@ -151,7 +151,8 @@ public:
         return ttlSanitised;
     }
 
-    void setValueFromHost (LV2_URID urid, float value) noexcept
+    /*  Returns the parameter that was changed, or nullptr if there's no such parameter. */
+    AudioProcessorParameter* setValueFromHost (LV2_URID urid, float value) noexcept
     {
         const auto it = uridToIndexMap.find (urid);
 
@@ -159,7 +160,7 @@ public:
         {
             // No such parameter.
             jassertfalse;
-            return;
+            return nullptr;
         }
 
         if (auto* param = legacyParameters.getParamForIndex ((int) it->second))
@@ -177,7 +178,11 @@ public:
                 ScopedValueSetter<bool> scope (ignoreCallbacks, true);
                 param->setValueNotifyingHost (scaledValue);
             }
+
+            return param;
         }
+
+        return nullptr;
     }
 
     struct Options
@@ -537,6 +542,7 @@ public:
         jassert (static_cast<int> (numSteps) <= processor->getBlockSize());
 
         midi.clear();
+        processor->getParameterAutomation().clear();
         playHead.invalidate();
         audio.setSize (audio.getNumChannels(), static_cast<int> (numSteps), true, false, true);
 
@@ -544,20 +550,22 @@ public:
         {
             struct Callback
             {
-                explicit Callback (LV2PluginInstance& s) : self (s) {}
+                Callback (LV2PluginInstance& s, int64_t frame) : self (s), samplePosition ((int) frame) {}
 
                 void setParameter (LV2_URID property, float value) const noexcept
                 {
-                    self.parameters.setValueFromHost (property, value);
+                    if (auto* param = self.parameters.setValueFromHost (property, value))
+                        self.processor->getParameterAutomation().addEvent (*param, param->getValue(), samplePosition);
                 }
 
                 // The host probably shouldn't send us 'touched' messages.
                 void gesture (LV2_URID, bool) const noexcept {}
 
                 LV2PluginInstance& self;
+                int samplePosition;
             };
 
-            patchSetHelper.processPatchSet (event, Callback { *this });
+            patchSetHelper.processPatchSet (event, Callback { *this, event->time.frames });
 
             playHead.readNewInfo (event);
 
@@ -783,6 +791,7 @@ private:
                                        processor->getTotalNumOutputChannels());
 
         midi.ensureSize (8192);
+        processor->getParameterAutomation().ensureSize (2048);
         audio.setSize (numChannels, maxBlockSize);
         audio.clear();
     }
@@ -3502,9 +3502,17 @@ public:
                 }
                 else
                #endif
-                if (const auto change = getPointFromQueue (paramQueue, numPoints - 1))
+                if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
                 {
-                    if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
+                    auto& automation = pluginInstance->getParameterAutomation();
+
+                    for (Steinberg::int32 point = 0; point < numPoints; ++point)
+                    {
+                        if (const auto change = getPointFromQueue (paramQueue, point))
+                            automation.addEvent (*param, (float) change->value, (int) change->offsetSamples);
+                    }
+
+                    if (const auto change = getPointFromQueue (paramQueue, numPoints - 1))
                         setValueAndNotifyIfChanged (*param, (float) change->value);
                 }
             }
@@ -3557,6 +3565,7 @@ public:
         }
 
         midiBuffer.clear();
+        pluginInstance->getParameterAutomation().clear();
 
         if (data.inputParameterChanges != nullptr)
             processParameterChanges (*data.inputParameterChanges);
@@ -3752,6 +3761,9 @@ private:
         midiBuffer.ensureSize (2048);
         midiBuffer.clear();
 
+        p.getParameterAutomation().ensureSize (2048);
+        p.getParameterAutomation().clear();
+
         bufferMapper.updateFromProcessor (p);
         bufferMapper.prepare (bufferSize);
     }
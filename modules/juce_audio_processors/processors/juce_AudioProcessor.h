@@ -727,6 +727,28 @@ public:
     */
     AudioPlayHead* getPlayHead() const noexcept                 { return playHead; }
 
+    /** Returns the sample-accurate parameter changes that the host has scheduled within
+        the block currently being processed.
+
+        As with getPlayHead(), you should only call this from your processBlock() method.
+        By the time processBlock() is called, each automated parameter will already hold the
+        last value that it takes in the block, so you only need to look at these events if
+        you want to follow the automation more closely than once per block.
+
+        The buffer will be empty if the host doesn't supply sample-accurate automation.
+
+        @see ParameterAutomationBuffer::forEachSegment
+    */
+    const ParameterAutomationBuffer& getParameterAutomation() const noexcept    { return parameterAutomation; }
+
+    /** Returns the buffer that a host or plugin wrapper should fill with the parameter
+        changes for the next block, before calling processBlock().
+
+        The host should clear it before each block, and reserve space for the events in
+        advance with ParameterAutomationBuffer::ensureSize().
+    */
+    ParameterAutomationBuffer& getParameterAutomation() noexcept                { return parameterAutomation; }
+
     //==============================================================================
     /** Returns the total number of input channels.
 
@@ -843,6 +865,25 @@ public:
     /** Returns the length of the processor's tail, in seconds. */
     virtual double getTailLengthSeconds() const = 0;
 
+    /** Returns true if this processor is guaranteed to produce silent output, and no MIDI, once
+        its audio inputs have been silent for longer than its tail length plus its latency, and
+        it has received no MIDI in that time.
+
+        This is typically true of effects. Hosts such as the AudioProcessorGraph can use it to
+        avoid calling processBlock() when there's nothing for the processor to do, so if you
+        return true, your processor must not rely on processBlock() being called for every
+        block, e.g. to advance an LFO or to react to the play head.
+
+        The default implementation returns false. The AudioProcessorGraph checks this, along
+        with getTailLengthSeconds(), each time a node's input becomes silent, so the tail may
+        change with the processor's parameters. A change made after the input has gone silent
+        only takes effect once the input has become non-silent again, so if the tail gets
+        longer, its output must already be silent by the end of the previously reported tail.
+
+        @see getTailLengthSeconds
+    */
+    virtual bool producesSilenceForSilentInput() const { return false; }
+
     /** Returns true if the processor wants MIDI messages. */
     virtual bool acceptsMidi() const = 0;
 
@@ -1529,6 +1570,7 @@ private:
     std::atomic<bool> nonRealtime { false };
     ProcessingPrecision processingPrecision = singlePrecision;
     CriticalSection callbackLock, listenerLock, activeEditorLock;
+    ParameterAutomationBuffer parameterAutomation;
 
     friend class Bus;
     mutable OwnedArray<Bus> inputBuses, outputBuses;
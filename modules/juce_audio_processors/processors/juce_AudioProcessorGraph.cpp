@@ -140,9 +140,13 @@ public:
     using NodeAndChannel = AudioProcessorGraph::NodeAndChannel;
 
 private:
-    static auto equalRange (const std::set<NodeAndChannel>& pins, const NodeID node)
+    // std::equal_range is linear for the bidirectional iterators of std::set and std::map, so we
+    // use the containers' own logarithmic lookups instead.
+    template <typename Container>
+    static auto equalRange (const Container& pins, const NodeID node)
     {
-        return std::equal_range (pins.cbegin(), pins.cend(), node, ImplicitNode::compare);
+        return std::make_pair (pins.lower_bound (NodeAndChannel { node, std::numeric_limits<int>::lowest() }),
+                               pins.upper_bound (NodeAndChannel { node, std::numeric_limits<int>::max() }));
     }
 
     using Map = std::map<NodeAndChannel, std::set<NodeAndChannel>>;
@@ -285,43 +289,6 @@ public:
     bool operator== (const Connections& other) const { return sourcesForDestination == other.sourcesForDestination; }
     bool operator!= (const Connections& other) const { return sourcesForDestination != other.sourcesForDestination; }
 
-    class DestinationsForSources
-    {
-    public:
-        explicit DestinationsForSources (Map m) : map (std::move (m)) {}
-
-        bool isSourceConnectedToDestinationNodeIgnoringChannel (const NodeAndChannel& source, NodeID dest, int channel) const
-        {
-            if (const auto destIter = map.find (source); destIter != map.cend())
-            {
-                const auto [begin, end] = equalRange (destIter->second, dest);
-                return std::any_of (begin, end, [&] (const NodeAndChannel& nodeAndChannel)
-                {
-                    return nodeAndChannel != NodeAndChannel { dest, channel };
-                });
-            }
-
-            return false;
-        }
-
-    private:
-        Map map;
-    };
-
-    /*  Reverses the graph, to allow fast lookup by source.
-        This is expensive, don't call this more than necessary!
-    */
-    auto getDestinationsForSources() const
-    {
-        Map destinationsForSources;
-
-        for (const auto& [destination, sources] : sourcesForDestination)
-            for (const auto& source : sources)
-                destinationsForSources[source].insert (destination);
-
-        return DestinationsForSources (std::move (destinationsForSources));
-    }
-
 private:
     struct SearchState
     {
@@ -362,7 +329,7 @@ private:
 
     std::pair<Map::const_iterator, Map::const_iterator> getMatchingDestinations (NodeID destID) const
     {
-        return std::equal_range (sourcesForDestination.cbegin(), sourcesForDestination.cend(), destID, ImplicitNode::compare);
+        return equalRange (sourcesForDestination, destID);
     }
 
     Map sourcesForDestination;
@@ -494,6 +461,491 @@ private:
     std::optional<PrepareSettings> current, next;
 };
 
+//==============================================================================
+/*  Records which buffers are touched by each op in a render sequence, and uses this information
+    to work out which ops may run concurrently.
+
+    Two ops that access the same buffer, where at least one of the ops writes to that buffer, will
+    always run in the same order as in the serial render sequence. This means that results from a
+    parallel render will be identical to those of a serial render.
+*/
+class RenderOpDependencies
+{
+public:
+    enum class ResourceKind { audioBuffer, midiBuffer, audioOutput, midiOutput };
+    using Resource = std::pair<ResourceKind, int>;
+
+    struct Access
+    {
+        std::vector<Resource> reads, writes;
+    };
+
+    void addOp (const Access& access)
+    {
+        const auto index = numDependencies.size();
+        std::set<size_t> dependencies;
+
+        for (const auto& resource : access.reads)
+        {
+            auto& state = resources[resource];
+
+            if (state.lastWriter.has_value())
+                dependencies.insert (*state.lastWriter);
+
+            state.readersSinceLastWrite.push_back (index);
+        }
+
+        for (const auto& resource : access.writes)
+        {
+            auto& state = resources[resource];
+
+            if (state.lastWriter.has_value())
+                dependencies.insert (*state.lastWriter);
+
+            dependencies.insert (state.readersSinceLastWrite.begin(), state.readersSinceLastWrite.end());
+            state.readersSinceLastWrite.clear();
+            state.lastWriter = index;
+        }
+
+        // An op that reads and writes the same buffer shouldn't wait for itself
+        dependencies.erase (index);
+
+        numDependencies.push_back ((int) dependencies.size());
+        dependents.emplace_back();
+
+        for (const auto dependency : dependencies)
+            dependents[dependency].push_back (index);
+    }
+
+    const std::vector<int>& getNumDependencies() const              { return numDependencies; }
+    const std::vector<std::vector<size_t>>& getDependents() const   { return dependents; }
+
+private:
+    struct ResourceState
+    {
+        std::optional<size_t> lastWriter;
+        std::vector<size_t> readersSinceLastWrite;
+    };
+
+    std::map<Resource, ResourceState> resources;
+    std::vector<int> numDependencies;
+    std::vector<std::vector<size_t>> dependents;
+};
+
+//==============================================================================
+/*  A pool of realtime worker threads that help the audio thread to work through a Job.
+
+    The pool may only be reconfigured on the main thread. If the audio thread finds that the pool
+    is being reconfigured, it won't wait, and instead the caller should do all of the work itself.
+*/
+class RenderThreadPool
+{
+public:
+    /*  A unit of work that can be shared between several threads. */
+    struct Job
+    {
+        virtual ~Job() = default;
+
+        /*  Called on the audio thread before any worker thread may call runNextTask. */
+        virtual void start() = 0;
+
+        /*  May be called concurrently from several threads.
+            Should return false if there was no task ready to run.
+        */
+        virtual bool runNextTask() = 0;
+
+        virtual bool isFinished() const = 0;
+    };
+
+    RenderThreadPool() = default;
+
+    ~RenderThreadPool()
+    {
+        setNumThreads (0);
+    }
+
+    /*  Call from the main thread only. */
+    void setNumThreads (int numThreads)
+    {
+        numThreads = jmax (0, numThreads);
+
+        if (numThreads == getNumThreads())
+            return;
+
+        const SpinLock::ScopedLockType lock (mutex);
+
+        for (auto& worker : workers)
+            worker->signalThreadShouldExit();
+
+        workers.clear();
+
+        for (int i = 0; i < numThreads; ++i)
+        {
+            auto worker = std::make_unique<Worker> (*this);
+
+            // Realtime threads may be unavailable if the process doesn't have the necessary
+            // permissions, in which case we fall back to a normal high-priority thread.
+            if (! worker->startRealtimeThread (Thread::RealtimeOptions{}.withPriority (10)))
+                worker->startThread (Thread::Priority::highest);
+
+            workers.push_back (std::move (worker));
+        }
+
+        numWorkers = numThreads;
+    }
+
+    int getNumThreads() const noexcept { return numWorkers; }
+
+    /*  Call from any thread. Worker threads will join the new workgroup the next time they wake. */
+    void setWorkgroup (const AudioWorkgroup& newWorkgroup)
+    {
+        const SpinLock::ScopedLockType lock (workgroupMutex);
+        workgroup = newWorkgroup;
+        ++workgroupGeneration;
+    }
+
+    /*  Call from the audio thread only.
+
+        Returns false if the pool is unavailable, in which case the job will not have been started.
+        Otherwise, the job will be complete when this function returns.
+    */
+    bool perform (Job& job)
+    {
+        const SpinLock::ScopedTryLockType lock (mutex);
+
+        if (! lock.isLocked() || workers.empty())
+            return false;
+
+        job.start();
+        currentJob = &job;
+
+        for (auto& worker : workers)
+            worker->notify();
+
+        runUntilFinished (job);
+        currentJob = nullptr;
+
+        // A worker might still be checking whether there's more work to do, so we need to wait for
+        // it to finish before the job can be modified again.
+        while (numActiveWorkers != 0)
+            Thread::yield();
+
+        return true;
+    }
+
+private:
+    class Worker final : public Thread
+    {
+    public:
+        explicit Worker (RenderThreadPool& p) : Thread ("Graph Render Worker"), pool (p) {}
+
+        ~Worker() override
+        {
+            stopThread (1000);
+        }
+
+        void run() override
+        {
+            WorkgroupToken token;
+            int joinedGeneration = -1;
+
+            while (! threadShouldExit())
+            {
+                pool.joinWorkgroupIfChanged (token, joinedGeneration);
+                pool.helpWithCurrentJob();
+                wait (-1);
+            }
+        }
+
+    private:
+        RenderThreadPool& pool;
+    };
+
+    static void runUntilFinished (Job& job)
+    {
+        while (! job.isFinished())
+            if (! job.runNextTask())
+                Thread::yield();
+    }
+
+    void helpWithCurrentJob()
+    {
+        ++numActiveWorkers;
+
+        if (auto* job = currentJob.load())
+            runUntilFinished (*job);
+
+        --numActiveWorkers;
+    }
+
+    void joinWorkgroupIfChanged (WorkgroupToken& token, int& joinedGeneration)
+    {
+        const SpinLock::ScopedLockType lock (workgroupMutex);
+
+        if (std::exchange (joinedGeneration, workgroupGeneration) == workgroupGeneration)
+            return;
+
+        if (workgroup)
+            workgroup.join (token);
+        else
+            token.reset();
+    }
+
+    SpinLock mutex, workgroupMutex;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<int> numWorkers { 0 }, numActiveWorkers { 0 };
+    std::atomic<Job*> currentJob { nullptr };
+    AudioWorkgroup workgroup;
+    int workgroupGeneration = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (RenderThreadPool)
+};
+
+//==============================================================================
+/*  Runs the ops in a render sequence on several threads, respecting the order implied by a
+    RenderOpDependencies instance.
+
+    All storage is allocated up-front on the main thread, so that the job can be started on the
+    audio thread without allocating.
+*/
+class ParallelRenderJob : public RenderThreadPool::Job
+{
+public:
+    explicit ParallelRenderJob (const RenderOpDependencies& d)
+        : numDependencies (d.getNumDependencies()),
+          dependents (d.getDependents()),
+          pending (numDependencies.size()),
+          queue (numDependencies.size())
+    {
+    }
+
+    void start() override
+    {
+        numQueued = 0;
+        numClaimed = 0;
+        numCompleted = 0;
+
+        for (auto& slot : queue)
+            slot.store (-1, std::memory_order_relaxed);
+
+        for (size_t i = 0; i < numDependencies.size(); ++i)
+        {
+            pending[i].store (numDependencies[i], std::memory_order_relaxed);
+
+            if (numDependencies[i] == 0)
+                push (i);
+        }
+    }
+
+    bool runNextTask() override
+    {
+        auto slot = numClaimed.load();
+
+        do
+        {
+            if (slot >= numQueued.load())
+                return false;
+        }
+        while (! numClaimed.compare_exchange_weak (slot, slot + 1));
+
+        // The thread that queued this op may not have filled in the slot yet
+        auto index = queue[slot].load (std::memory_order_acquire);
+
+        while (index < 0)
+            index = queue[slot].load (std::memory_order_acquire);
+
+        runOp ((size_t) index);
+
+        for (const auto dependent : dependents[(size_t) index])
+            if (pending[dependent].fetch_sub (1, std::memory_order_acq_rel) == 1)
+                push (dependent);
+
+        numCompleted.fetch_add (1, std::memory_order_release);
+        return true;
+    }
+
+    bool isFinished() const override
+    {
+        return numCompleted.load (std::memory_order_acquire) == queue.size();
+    }
+
+protected:
+    virtual void runOp (size_t index) = 0;
+
+private:
+    void push (size_t index)
+    {
+        queue[numQueued++].store ((int) index, std::memory_order_release);
+    }
+
+    const std::vector<int> numDependencies;
+    const std::vector<std::vector<size_t>> dependents;
+    std::vector<std::atomic<int>> pending, queue;
+    std::atomic<size_t> numQueued { 0 }, numClaimed { 0 }, numCompleted { 0 };
+};
+
+//==============================================================================
+/*  Collects processing time measurements for a single node.
+
+    record() is only ever called by the thread that is processing the node, so the counters can
+    be updated with relaxed atomic operations, and the message thread can read them at any time
+    without locking. The counters aren't updated together, so a reader may occasionally see
+    figures that are one block out of step with each other, which is fine for display.
+
+    A histogram of block times with 8 bins per octave is kept in order to estimate percentiles.
+*/
+class NodeTimer final : public ReferenceCountedObject
+{
+public:
+    using Ptr = ReferenceCountedObjectPtr<NodeTimer>;
+
+    /*  Call from the rendering thread only. */
+    void record (int64 ticks, int numSamples) noexcept
+    {
+        if (resetRequested.exchange (false, std::memory_order_acquire))
+            clear();
+
+        const auto t = (uint64) jmax ((int64) 0, ticks);
+        const auto ticksPerSample = (double) t / (double) jmax (1, numSamples);
+
+        const auto blocks = numBlocks.load (std::memory_order_relaxed);
+
+        if (blocks == 0 || t < minTicks.load (std::memory_order_relaxed))
+            minTicks.store (t, std::memory_order_relaxed);
+
+        if (t > maxTicks.load (std::memory_order_relaxed))
+            maxTicks.store (t, std::memory_order_relaxed);
+
+        if (ticksPerSample > maxTicksPerSample.load (std::memory_order_relaxed))
+            maxTicksPerSample.store (ticksPerSample, std::memory_order_relaxed);
+
+        totalTicks  .store (totalTicks  .load (std::memory_order_relaxed) + t,                  std::memory_order_relaxed);
+        totalSamples.store (totalSamples.load (std::memory_order_relaxed) + (uint64) numSamples, std::memory_order_relaxed);
+
+        auto& bin = histogram[(size_t) getBinForTicks (t)];
+        bin.store (bin.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        numBlocks.store (blocks + 1, std::memory_order_release);
+    }
+
+    /*  Asks the rendering thread to discard the measurements before recording the next block. */
+    void reset() noexcept
+    {
+        resetRequested.store (true, std::memory_order_release);
+    }
+
+    AudioProcessorGraph::NodeTimingInfo getInfo (double sampleRate) const
+    {
+        AudioProcessorGraph::NodeTimingInfo result;
+
+        if (resetRequested.load (std::memory_order_acquire))
+            return result;
+
+        const auto blocks = numBlocks.load (std::memory_order_acquire);
+
+        if (blocks == 0)
+            return result;
+
+        const auto toMs = [] (double ticks) { return Time::highResolutionTicksToSeconds ((int64) ticks) * 1000.0; };
+
+        const auto minT = (double) minTicks.load (std::memory_order_relaxed);
+        const auto maxT = (double) maxTicks.load (std::memory_order_relaxed);
+        const auto samples = totalSamples.load (std::memory_order_relaxed);
+        const auto total = (double) totalTicks.load (std::memory_order_relaxed);
+
+        result.numBlocks = (int64) blocks;
+        result.minMilliseconds = toMs (minT);
+        result.maxMilliseconds = toMs (maxT);
+        result.averageMilliseconds = toMs (total / (double) blocks);
+        result.percentile95Milliseconds = toMs (jlimit (minT, maxT, getPercentileTicks (0.95)));
+        result.percentile99Milliseconds = toMs (jlimit (minT, maxT, getPercentileTicks (0.99)));
+
+        if (sampleRate > 0.0 && samples > 0)
+        {
+            const auto ticksPerSecond = (double) Time::getHighResolutionTicksPerSecond();
+            const auto loadForTicksPerSample = [&] (double ticksPerSample) { return ticksPerSample * sampleRate / ticksPerSecond; };
+
+            result.averageLoad = loadForTicksPerSample (total / (double) samples);
+            result.maxLoad = loadForTicksPerSample (maxTicksPerSample.load (std::memory_order_relaxed));
+        }
+
+        return result;
+    }
+
+private:
+    static constexpr int binsPerOctaveLog2 = 3;
+    static constexpr int binsPerOctave = 1 << binsPerOctaveLog2;
+    static constexpr int numBins = (64 - binsPerOctaveLog2 + 1) * binsPerOctave;
+
+    static int getHighestSetBit (uint64 n) noexcept
+    {
+        const auto high = (uint32) (n >> 32);
+        return high != 0 ? 32 + findHighestSetBit (high) : findHighestSetBit ((uint32) n);
+    }
+
+    static int getBinForTicks (uint64 ticks) noexcept
+    {
+        if (ticks < (uint64) binsPerOctave)
+            return (int) ticks;
+
+        const auto octave = getHighestSetBit (ticks);
+        const auto subBin = (int) (ticks >> (octave - binsPerOctaveLog2)) & (binsPerOctave - 1);
+        return (octave - binsPerOctaveLog2 + 1) * binsPerOctave + subBin;
+    }
+
+    /*  Returns the midpoint of the range of tick counts that fall into a given bin. */
+    static double getTicksForBin (int bin) noexcept
+    {
+        if (bin < binsPerOctave)
+            return (double) bin;
+
+        const auto shift = bin / binsPerOctave - 1;
+        const auto lowest = (double) ((uint64) (binsPerOctave + bin % binsPerOctave) << shift);
+        const auto width = (double) ((uint64) 1 << shift);
+        return lowest + width * 0.5;
+    }
+
+    double getPercentileTicks (double proportion) const noexcept
+    {
+        uint64 counted = 0;
+
+        for (const auto& bin : histogram)
+            counted += bin.load (std::memory_order_relaxed);
+
+        const auto target = (uint64) std::ceil ((double) counted * proportion);
+        uint64 seen = 0;
+
+        for (size_t i = 0; i < histogram.size(); ++i)
+        {
+            seen += histogram[i].load (std::memory_order_relaxed);
+
+            if (seen >= target && seen > 0)
+                return getTicksForBin ((int) i);
+        }
+
+        return 0.0;
+    }
+
+    void clear() noexcept
+    {
+        for (auto& bin : histogram)
+            bin.store (0, std::memory_order_relaxed);
+
+        for (auto* counter : { &minTicks, &maxTicks, &totalTicks, &totalSamples })
+            counter->store (0, std::memory_order_relaxed);
+
+        maxTicksPerSample.store (0.0, std::memory_order_relaxed);
+        numBlocks.store (0, std::memory_order_release);
+    }
+
+    std::atomic<uint64> numBlocks { 0 }, minTicks { 0 }, maxTicks { 0 }, totalTicks { 0 }, totalSamples { 0 };
+    std::atomic<double> maxTicksPerSample { 0.0 };
+    std::array<std::atomic<uint32>, (size_t) numBins> histogram{};
+    std::atomic<bool> resetRequested { false };
+};
+
+using NodeTimers = std::map<AudioProcessorGraph::NodeID, NodeTimer::Ptr>;
+
 //==============================================================================
 template <typename FloatType>
 struct GraphRenderSequence
@@ -513,9 +965,20 @@ struct GraphRenderSequence
         GlobalIO globalIO;
         AudioPlayHead* audioPlayHead;
         int numSamples;
+
+        /*  For each channel of the rendering buffer, true if the channel is known to contain only
+            zeros in the current block. Ops that are given silent inputs can use this to avoid
+            doing unnecessary work.
+            Each flag is only accessed by ops that use the corresponding channel, so the flags can
+            be used safely when the ops are running in parallel.
+        */
+        bool* silentChannels;
     };
 
-    void perform (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages, AudioPlayHead* audioPlayHead)
+    void perform (AudioBuffer<FloatType>& buffer,
+                  MidiBuffer& midiMessages,
+                  AudioPlayHead* audioPlayHead,
+                  RenderThreadPool& threadPool)
     {
         auto numSamples = buffer.getNumSamples();
         auto maxSamples = renderingBuffer.getNumSamples();
@@ -534,7 +997,7 @@ struct GraphRenderSequence
 
                 // Splitting up the buffer like this will cause the play head and host time to be
                 // invalid for all but the first chunk...
-                perform (audioChunk, midiChunk, audioPlayHead);
+                perform (audioChunk, midiChunk, audioPlayHead, threadPool);
 
                 chunkStartSample += maxSamples;
             }
@@ -546,16 +1009,31 @@ struct GraphRenderSequence
         currentAudioOutputBuffer.clear();
         currentMidiOutputBuffer.clear();
 
+        // Only the read-only empty channel is known to be silent until an op says otherwise
+        std::fill_n (silentChannels.get(), renderingBuffer.getNumChannels(), false);
+        silentChannels[0] = true;
+
         {
             const Context context { { buffer,
                                       currentAudioOutputBuffer,
                                       midiMessages,
                                       currentMidiOutputBuffer },
                                     audioPlayHead,
-                                    numSamples };
+                                    numSamples,
+                                    silentChannels.get() };
+
+            const auto renderedInParallel = [&]
+            {
+                if (parallelJob == nullptr)
+                    return false;
+
+                parallelJob->setContext (renderOps.data(), context);
+                return threadPool.perform (*parallelJob);
+            }();
 
-            for (const auto& op : renderOps)
-                op->process (context);
+            if (! renderedInParallel)
+                for (const auto& op : renderOps)
+                    op->process (context);
         }
 
         for (int i = 0; i < buffer.getNumChannels(); ++i)
@@ -581,6 +1059,17 @@ struct GraphRenderSequence
             void process (const Context& c) override
             {
                 FloatVectorOperations::clear (channelBuffer, c.numSamples);
+                c.silentChannels[index] = true;
+            }
+
+            Access getAccess() const override
+            {
+                return { {}, { audioBufferResource (index) } };
+            }
+
+            void visitAudioBuffers (const AudioBufferVisitor& visit) override
+            {
+                visit (index, BufferUse::overwrite);
             }
 
             FloatType* channelBuffer = nullptr;
@@ -604,7 +1093,25 @@ struct GraphRenderSequence
 
             void process (const Context& c) override
             {
-                FloatVectorOperations::copy (toBuffer, fromBuffer, c.numSamples);
+                const auto isSilent = c.silentChannels[from];
+
+                if (isSilent)
+                    FloatVectorOperations::clear (toBuffer, c.numSamples);
+                else
+                    FloatVectorOperations::copy (toBuffer, fromBuffer, c.numSamples);
+
+                c.silentChannels[to] = isSilent;
+            }
+
+            Access getAccess() const override
+            {
+                return { { audioBufferResource (from) }, { audioBufferResource (to) } };
+            }
+
+            void visitAudioBuffers (const AudioBufferVisitor& visit) override
+            {
+                visit (from, BufferUse::read);
+                visit (to, BufferUse::overwrite);
             }
 
             FloatType* fromBuffer = nullptr;
@@ -629,7 +1136,26 @@ struct GraphRenderSequence
 
             void process (const Context& c) override
             {
-                FloatVectorOperations::add (toBuffer, fromBuffer, c.numSamples);
+                if (c.silentChannels[from])
+                    return;
+
+                if (c.silentChannels[to])
+                    FloatVectorOperations::copy (toBuffer, fromBuffer, c.numSamples);
+                else
+                    FloatVectorOperations::add (toBuffer, fromBuffer, c.numSamples);
+
+                c.silentChannels[to] = false;
+            }
+
+            Access getAccess() const override
+            {
+                return { { audioBufferResource (from), audioBufferResource (to) }, { audioBufferResource (to) } };
+            }
+
+            void visitAudioBuffers (const AudioBufferVisitor& visit) override
+            {
+                visit (from, BufferUse::read);
+                visit (to, BufferUse::read);
             }
 
             FloatType* fromBuffer = nullptr;
@@ -658,6 +1184,11 @@ struct GraphRenderSequence
                 channelBuffer->clear();
             }
 
+            Access getAccess() const override
+            {
+                return { {}, { midiBufferResource (index) } };
+            }
+
             MidiBuffer* channelBuffer = nullptr;
             int index = 0;
         };
@@ -682,6 +1213,11 @@ struct GraphRenderSequence
                 *toBuffer = *fromBuffer;
             }
 
+            Access getAccess() const override
+            {
+                return { { midiBufferResource (from) }, { midiBufferResource (to) } };
+            }
+
             MidiBuffer* fromBuffer = nullptr;
             MidiBuffer* toBuffer = nullptr;
             int from = 0, to = 0;
@@ -707,6 +1243,11 @@ struct GraphRenderSequence
                 toBuffer->addEvents (*fromBuffer, 0, c.numSamples, 0);
             }
 
+            Access getAccess() const override
+            {
+                return { { midiBufferResource (from), midiBufferResource (to) }, { midiBufferResource (to) } };
+            }
+
             MidiBuffer* fromBuffer = nullptr;
             MidiBuffer* toBuffer = nullptr;
             int from = 0, to = 0;
@@ -733,6 +1274,19 @@ struct GraphRenderSequence
 
             void process (const Context& c) override
             {
+                if (c.silentChannels[channel])
+                {
+                    // Once the delay line is full of zeros, the output will stay silent
+                    if (numSilentSamplesWritten >= buffer.size())
+                        return;
+
+                    numSilentSamplesWritten += (size_t) c.numSamples;
+                }
+                else
+                {
+                    numSilentSamplesWritten = 0;
+                }
+
                 auto* data = channelBuffer;
 
                 for (int i = c.numSamples; --i >= 0;)
@@ -743,12 +1297,25 @@ struct GraphRenderSequence
                     if (++readIndex  >= (int) buffer.size()) readIndex = 0;
                     if (++writeIndex >= (int) buffer.size()) writeIndex = 0;
                 }
+
+                c.silentChannels[channel] = false;
+            }
+
+            Access getAccess() const override
+            {
+                return { { audioBufferResource (channel) }, { audioBufferResource (channel) } };
+            }
+
+            void visitAudioBuffers (const AudioBufferVisitor& visit) override
+            {
+                visit (channel, BufferUse::read);
             }
 
             std::vector<FloatType> buffer;
             FloatType* channelBuffer = nullptr;
-            const int channel;
+            int channel;
             int readIndex = 0, writeIndex;
+            size_t numSilentSamplesWritten = 0;
         };
 
         renderOps.push_back (std::make_unique<DelayChannelOp> (chan, delaySize));
@@ -804,11 +1371,114 @@ struct GraphRenderSequence
         for (auto&& m : midiBuffers)
             m.ensureSize (defaultMIDIBufferSize);
 
+        silentChannels.calloc ((size_t) renderingBuffer.getNumChannels());
+
         for (const auto& op : renderOps)
             op->prepare (renderingBuffer.getArrayOfWritePointers(), midiBuffers.data());
     }
 
-    int numBuffersNeeded = 0, numMidiBuffersNeeded = 0;
+    /*  Call from the main thread only, before prepareBuffers.
+
+        Reassigns the audio buffers used by the render ops so that the number of buffers is as
+        small as possible. Each value held in a buffer is live from the op that writes it until the
+        last op that reads it. Values are placed in order of their first op, each reusing a buffer
+        whose previous value has already died, which is optimal for intervals like these.
+    */
+    void assignAudioBuffersByLifetime()
+    {
+        struct Lifetime
+        {
+            size_t start = 0, end = 0;
+            std::vector<int*> references;
+        };
+
+        std::vector<Lifetime> lifetimes;
+        std::map<int, size_t> currentLifetimeForBuffer;
+
+        for (size_t opIndex = 0; opIndex < renderOps.size(); ++opIndex)
+        {
+            renderOps[opIndex]->visitAudioBuffers ([&] (int& bufferIndex, BufferUse use)
+            {
+                // The read-only empty buffer is shared by all ops, so it can't be moved
+                if (bufferIndex == 0)
+                    return;
+
+                auto iter = currentLifetimeForBuffer.find (bufferIndex);
+
+                if (use == BufferUse::overwrite || iter == currentLifetimeForBuffer.end())
+                {
+                    iter = currentLifetimeForBuffer.insert_or_assign (bufferIndex, lifetimes.size()).first;
+                    lifetimes.push_back ({ opIndex, opIndex, {} });
+                }
+
+                auto& lifetime = lifetimes[iter->second];
+                lifetime.end = opIndex;
+                lifetime.references.push_back (&bufferIndex);
+            });
+        }
+
+        // Buffers whose values are still live, ordered by the op that ends each lifetime
+        std::multimap<size_t, int> liveBuffers;
+        std::set<int> freeBuffers;
+        int numBuffers = 1;
+
+        for (auto& lifetime : lifetimes)
+        {
+            // A buffer can only be reused by a later op, otherwise the inputs and outputs of an op
+            // might overlap
+            while (! liveBuffers.empty() && liveBuffers.begin()->first < lifetime.start)
+            {
+                freeBuffers.insert (liveBuffers.begin()->second);
+                liveBuffers.erase (liveBuffers.begin());
+            }
+
+            const auto bufferIndex = [&]
+            {
+                if (freeBuffers.empty())
+                    return numBuffers++;
+
+                return freeBuffers.extract (freeBuffers.begin()).value();
+            }();
+
+            liveBuffers.emplace (lifetime.end, bufferIndex);
+            peakLiveChannels = jmax (peakLiveChannels, (int) liveBuffers.size());
+
+            for (auto* reference : lifetime.references)
+                *reference = bufferIndex;
+        }
+
+        numBuffersNeeded = numBuffers;
+    }
+
+    AudioProcessorGraph::RenderBufferInfo getRenderBufferInfo() const
+    {
+        return { renderingBuffer.getNumChannels(),
+                 peakLiveChannels,
+                 (size_t) renderingBuffer.getNumChannels() * (size_t) renderingBuffer.getNumSamples() * sizeof (FloatType) };
+    }
+
+    /*  Call from the main thread only.
+        Finds the ops that may run concurrently, so that this sequence can be rendered by a
+        RenderThreadPool.
+    */
+    void prepareParallelRendering()
+    {
+        RenderOpDependencies dependencies;
+
+        for (const auto& op : renderOps)
+            dependencies.addOp (op->getAccess());
+
+        parallelJob = std::make_unique<OpJob> (dependencies);
+    }
+
+    /*  Call from the main thread only, before passing the sequence to the audio thread. */
+    void attachNodeTimers (const NodeTimers& timers)
+    {
+        for (const auto& op : renderOps)
+            op->attachTimer (timers);
+    }
+
+    int numBuffersNeeded = 0, numMidiBuffersNeeded = 0, peakLiveChannels = 0;
 
     AudioBuffer<FloatType> renderingBuffer, currentAudioOutputBuffer;
 
@@ -817,13 +1487,55 @@ struct GraphRenderSequence
     Array<MidiBuffer> midiBuffers;
     MidiBuffer midiChunk;
 
+    HeapBlock<bool> silentChannels;
+
 private:
     //==============================================================================
+    using Access = RenderOpDependencies::Access;
+    using ResourceKind = RenderOpDependencies::ResourceKind;
+
+    static auto audioBufferResource (int index)  { return RenderOpDependencies::Resource { ResourceKind::audioBuffer, index }; }
+    static auto midiBufferResource  (int index)  { return RenderOpDependencies::Resource { ResourceKind::midiBuffer,  index }; }
+
+    /*  'overwrite' means that the op replaces the buffer's contents without reading them. */
+    enum class BufferUse { read, overwrite };
+    using AudioBufferVisitor = std::function<void (int& bufferIndex, BufferUse)>;
+
     struct RenderOp
     {
         virtual ~RenderOp() = default;
         virtual void prepare (FloatType* const*, MidiBuffer*) = 0;
         virtual void process (const Context&) = 0;
+
+        /*  Returns the buffers that are read and written by this op. */
+        virtual Access getAccess() const = 0;
+
+        /*  Calls the visitor with each audio buffer index used by this op, allowing the index to
+            be reassigned. Must be called before prepare().
+        */
+        virtual void visitAudioBuffers (const AudioBufferVisitor&) {}
+
+        /*  Gives the op a chance to find the timer for the node that it processes, if any. */
+        virtual void attachTimer (const NodeTimers&) {}
+    };
+
+    struct OpJob final : public ParallelRenderJob
+    {
+        using ParallelRenderJob::ParallelRenderJob;
+
+        void setContext (const std::unique_ptr<RenderOp>* opsIn, const Context& contextIn)
+        {
+            ops = opsIn;
+            context = &contextIn;
+        }
+
+        void runOp (size_t index) override
+        {
+            ops[index]->process (*context);
+        }
+
+        const std::unique_ptr<RenderOp>* ops = nullptr;
+        const Context* context = nullptr;
     };
 
     struct NodeOp : public RenderOp
@@ -836,7 +1548,9 @@ private:
               processor (*n->getProcessor()),
               audioChannelsToUse (audioChannelsUsed),
               audioChannels ((size_t) jmax (1, totalNumChans), nullptr),
-              midiBufferToUse (midiBufferIndex)
+              midiBufferToUse (midiBufferIndex),
+              usesMidi (processor.acceptsMidi() || processor.producesMidi()),
+              numInputChannels (processor.getTotalNumInputChannels())
         {
             while (audioChannelsToUse.size() < (int) audioChannels.size())
                 audioChannelsToUse.add (0);
@@ -847,7 +1561,9 @@ private:
             for (size_t i = 0; i < audioChannels.size(); ++i)
                 audioChannels[i] = renderBuffer[audioChannelsToUse.getUnchecked ((int) i)];
 
-            midiBuffer = buffers + midiBufferToUse;
+            // Processors that don't use MIDI get their own buffer, so that they can't interfere
+            // with any other node, even if they're running concurrently.
+            midiBuffer = usesMidi ? buffers + midiBufferToUse : &unusedMidiBuffer;
         }
 
         void process (const Context& c) final
@@ -865,35 +1581,173 @@ private:
 
             AudioBuffer<FloatType> buffer { audioChannels.data(), numAudioChannels, c.numSamples };
 
+            if (! usesMidi)
+                unusedMidiBuffer.clear();
+
             if (processor.isSuspended())
             {
                 buffer.clear();
+                setChannelsSilent (c, true);
             }
             else
             {
                 const auto bypass = node->isBypassed() && processor.getBypassParameter() == nullptr;
-                processWithBuffer (c.globalIO, bypass, buffer, *midiBuffer);
+
+                if (timer == nullptr)
+                {
+                    processWithBuffer (c, bypass, buffer, *midiBuffer);
+                }
+                else
+                {
+                    const auto start = Time::getHighResolutionTicks();
+                    processWithBuffer (c, bypass, buffer, *midiBuffer);
+                    timer->record (Time::getHighResolutionTicks() - start, c.numSamples);
+                }
+            }
+        }
+
+        Access getAccess() const override
+        {
+            Access result;
+
+            for (const auto index : audioChannelsToUse)
+                result.writes.push_back (audioBufferResource (index));
+
+            if (usesMidi)
+                result.writes.push_back (midiBufferResource (midiBufferToUse));
+
+            result.reads = result.writes;
+            return result;
+        }
+
+        void visitAudioBuffers (const AudioBufferVisitor& visit) override
+        {
+            // Channels after the inputs hold new output data
+            for (auto i = 0; i < audioChannelsToUse.size(); ++i)
+                visit (audioChannelsToUse.getReference (i), i < numInputChannels ? BufferUse::read : BufferUse::overwrite);
+        }
+
+        /*  Returns true if all of the node's audio inputs are silent, and it has no incoming MIDI. */
+        bool hasSilentInput (const Context& c) const
+        {
+            for (auto i = 0; i < numInputChannels; ++i)
+                if (! c.silentChannels[audioChannelsToUse.getUnchecked (i)])
+                    return false;
+
+            return ! usesMidi || midiBuffer->isEmpty();
+        }
+
+        void setChannelSilent (const Context& c, int channel, bool silent) const
+        {
+            // The read-only empty channel must always stay silent
+            if (const auto index = audioChannelsToUse.getUnchecked (channel); index != 0)
+                c.silentChannels[index] = silent;
+        }
+
+        void setChannelsSilent (const Context& c, bool silent) const
+        {
+            for (auto i = 0; i < audioChannelsToUse.size(); ++i)
+                setChannelSilent (c, i, silent);
+        }
+
+        /*  Clears any of the node's channels that aren't already known to be silent. */
+        void clearChannels (const Context& c)
+        {
+            for (auto i = 0; i < audioChannelsToUse.size(); ++i)
+            {
+                if (! c.silentChannels[audioChannelsToUse.getUnchecked (i)])
+                {
+                    FloatVectorOperations::clear (audioChannels[(size_t) i], c.numSamples);
+                    setChannelSilent (c, i, true);
+                }
             }
         }
 
-        virtual void processWithBuffer (const GlobalIO&, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) = 0;
+        void attachTimer (const NodeTimers& timers) override
+        {
+            const auto iter = timers.find (node->nodeID);
+            timer = iter != timers.end() ? iter->second : nullptr;
+        }
+
+        virtual void processWithBuffer (const Context&, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) = 0;
 
         const Node::Ptr node;
         AudioProcessor& processor;
         MidiBuffer* midiBuffer = nullptr;
+        MidiBuffer unusedMidiBuffer;
+        NodeTimer::Ptr timer;
 
         Array<int> audioChannelsToUse;
         std::vector<FloatType*> audioChannels;
         const int midiBufferToUse;
+        const bool usesMidi;
+        const int numInputChannels;
     };
 
     struct ProcessOp final : public NodeOp
     {
-        using NodeOp::NodeOp;
+        ProcessOp (const Node::Ptr& n,
+                   const Array<int>& audioChannelsUsed,
+                   int totalNumChans,
+                   int midiBufferIndex)
+            : NodeOp (n, audioChannelsUsed, totalNumChans, midiBufferIndex)
+        {
+        }
 
-        void processWithBuffer (const GlobalIO&, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
+        void processWithBuffer (const Context& c, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
         {
+            if (canSkip (c, bypass))
+            {
+                this->clearChannels (c);
+                return;
+            }
+
             callProcess (bypass, audio, midi);
+            this->setChannelsSilent (c, false);
+        }
+
+        /*  Returns true if the processor's output is known to be silent in this block, in which
+            case there's no need to call it.
+        */
+        bool canSkip (const Context& c, bool bypass)
+        {
+            if (! this->hasSilentInput (c))
+            {
+                numSilentInputSamples = 0;
+                return false;
+            }
+
+            // The tail may depend on the processor's parameters, so it's fetched afresh at the
+            // start of each silent stretch
+            if (numSilentInputSamples == 0)
+                silentInputTail = getSilentInputTail (this->processor);
+
+            // When the graph bypasses a node, the node's input is passed through, possibly after
+            // being delayed to compensate for the node's latency
+            const auto tail = bypass ? std::optional<int64> ((int64) this->processor.getLatencySamples())
+                                     : silentInputTail;
+
+            const auto result = tail.has_value() && numSilentInputSamples >= *tail;
+            numSilentInputSamples += c.numSamples;
+            return result;
+        }
+
+        /*  Returns the number of samples for which the processor may keep producing output after
+            its input becomes silent, or nullopt if it might produce output at any time. This
+            includes the processor's latency, as a processor with a lookahead will still be
+            outputting its delayed input for that long.
+        */
+        static std::optional<int64> getSilentInputTail (const AudioProcessor& p)
+        {
+            if (! p.producesSilenceForSilentInput())
+                return {};
+
+            const auto seconds = p.getTailLengthSeconds();
+
+            if (! std::isfinite (seconds))
+                return {};
+
+            return (int64) std::ceil (jmax (0.0, seconds) * p.getSampleRate()) + jmax (0, p.getLatencySamples());
         }
 
         void callProcess (bool bypass, AudioBuffer<float>& buffer, MidiBuffer& midi)
@@ -934,16 +1788,18 @@ private:
         }
 
         AudioBuffer<float> tempBufferFloat, tempBufferDouble;
+        std::optional<int64> silentInputTail;
+        int64 numSilentInputSamples = 0;
     };
 
     struct MidiInOp final : public NodeOp
     {
         using NodeOp::NodeOp;
 
-        void processWithBuffer (const GlobalIO& g, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
+        void processWithBuffer (const Context& c, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
         {
             if (! bypass)
-                midi.addEvents (g.midiIn, 0, audio.getNumSamples(), 0);
+                midi.addEvents (c.globalIO.midiIn, 0, audio.getNumSamples(), 0);
         }
     };
 
@@ -951,10 +1807,15 @@ private:
     {
         using NodeOp::NodeOp;
 
-        void processWithBuffer (const GlobalIO& g, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
+        void processWithBuffer (const Context& c, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
         {
             if (! bypass)
-                g.midiOut.addEvents (midi, 0, audio.getNumSamples(), 0);
+                c.globalIO.midiOut.addEvents (midi, 0, audio.getNumSamples(), 0);
+        }
+
+        Access getAccess() const override
+        {
+            return { { midiBufferResource (this->midiBufferToUse) }, { { ResourceKind::midiOutput, 0 } } };
         }
     };
 
@@ -962,13 +1823,18 @@ private:
     {
         using NodeOp::NodeOp;
 
-        void processWithBuffer (const GlobalIO& g, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer&) final
+        void processWithBuffer (const Context& c, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer&) final
         {
             if (bypass)
                 return;
 
-            for (int i = jmin (g.audioIn.getNumChannels(), audio.getNumChannels()); --i >= 0;)
-                audio.copyFrom (i, 0, g.audioIn, i, 0, audio.getNumSamples());
+            const auto& audioIn = c.globalIO.audioIn;
+
+            for (int i = jmin (audioIn.getNumChannels(), audio.getNumChannels()); --i >= 0;)
+            {
+                audio.copyFrom (i, 0, audioIn, i, 0, audio.getNumSamples());
+                this->setChannelSilent (c, i, audioIn.hasBeenCleared());
+            }
         }
     };
 
@@ -976,17 +1842,34 @@ private:
     {
         using NodeOp::NodeOp;
 
-        void processWithBuffer (const GlobalIO& g, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer&) final
+        void processWithBuffer (const Context& c, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer&) final
         {
             if (bypass)
                 return;
 
-            for (int i = jmin (g.audioOut.getNumChannels(), audio.getNumChannels()); --i >= 0;)
-                g.audioOut.addFrom (i, 0, audio, i, 0, audio.getNumSamples());
+            auto& audioOut = c.globalIO.audioOut;
+
+            for (int i = jmin (audioOut.getNumChannels(), audio.getNumChannels()); --i >= 0;)
+                if (! c.silentChannels[this->audioChannelsToUse.getUnchecked (i)])
+                    audioOut.addFrom (i, 0, audio, i, 0, audio.getNumSamples());
+        }
+
+        Access getAccess() const override
+        {
+            Access result;
+
+            for (const auto index : this->audioChannelsToUse)
+                result.reads.push_back (audioBufferResource (index));
+
+            // All output ops write to the same global buffer, so they must run in a fixed order
+            // to keep the result deterministic.
+            result.writes.push_back ({ ResourceKind::audioOutput, 0 });
+            return result;
         }
     };
 
     std::vector<std::unique_ptr<RenderOp>> renderOps;
+    std::unique_ptr<OpJob> parallelJob;
 };
 
 //==============================================================================
@@ -997,6 +1880,7 @@ struct SequenceAndLatency
 
     RenderSequenceVariant sequence;
     int latencySamples = 0;
+    std::vector<AudioProcessorGraph::NodeID> nodeOrder;
 };
 
 //==============================================================================
@@ -1010,16 +1894,72 @@ public:
 
     static constexpr auto midiChannelIndex = AudioProcessorGraph::midiChannelIndex;
 
+    /*  previousOrder should hold the node order of the last sequence that was built for this
+        graph. Nodes will be kept in this order wherever possible, so that small topology edits
+        don't need to reorder the whole graph.
+    */
     template <typename FloatType>
-    static SequenceAndLatency build (const Nodes& n, const Connections& c)
+    static SequenceAndLatency build (const Nodes& n, const Connections& c, const std::vector<NodeID>& previousOrder)
     {
         GraphRenderSequence<FloatType> sequence;
-        const RenderSequenceBuilder builder (n, c, sequence);
-        return { std::move (sequence), builder.totalLatency };
+        const RenderSequenceBuilder builder (n, c, previousOrder, sequence);
+        return { std::move (sequence), builder.totalLatency, builder.getNodeOrder() };
     }
 
 private:
     //==============================================================================
+    /*  For each output of each node, holds the positions in the render order of the nodes that
+        read from that output.
+        This allows us to check whether a buffer is still needed without searching through the
+        rest of the render order.
+    */
+    class DestinationsForSources
+    {
+    public:
+        DestinationsForSources (const Connections& c, const Array<Node*>& order)
+        {
+            std::map<NodeID, int> positions;
+
+            for (int i = 0; i < order.size(); ++i)
+                positions.emplace (order.getUnchecked (i)->nodeID, i);
+
+            for (const auto& connection : c.getConnections())
+            {
+                const auto position = positions.find (connection.destination.nodeID);
+
+                if (position != positions.cend())
+                    map[connection.source].emplace_back (position->second, connection.destination.channelIndex);
+            }
+
+            for (auto& pair : map)
+                std::sort (pair.second.begin(), pair.second.end());
+        }
+
+        /*  Returns true if the output is read by the node at stepIndex on any input other than
+            inputChannelToIgnore, or if it is read by any node later in the render order.
+        */
+        bool isNeededLater (NodeAndChannel output, int stepIndex, int inputChannelToIgnore) const
+        {
+            const auto iter = map.find (output);
+
+            if (iter == map.cend())
+                return false;
+
+            const auto& uses = iter->second;
+            const auto begin = std::lower_bound (uses.cbegin(), uses.cend(), Use { stepIndex, std::numeric_limits<int>::lowest() });
+
+            return std::any_of (begin, uses.cend(), [&] (const Use& use)
+            {
+                return use.first != stepIndex || use.second != inputChannelToIgnore;
+            });
+        }
+
+    private:
+        using Use = std::pair<int, int>; // position in render order, input channel
+
+        std::map<NodeAndChannel, std::vector<Use>> map;
+    };
+
     const Array<Node*> orderedNodes;
 
     struct AssignedBuffer
@@ -1089,7 +2029,81 @@ private:
         }
     }
 
-    Array<Node*> createOrderedNodeList (const Nodes& n, const Connections& c)
+    Array<Node*> createOrderedNodeList (const Nodes& n, const Connections& c, const std::vector<NodeID>& previousOrder)
+    {
+        if (auto result = createOrderedNodeListForAcyclicGraph (n, c, previousOrder))
+            return *result;
+
+        return createOrderedNodeListFromScratch (n, c);
+    }
+
+    /*  Sorts the nodes so that each node comes after all of its sources, keeping nodes in the same
+        relative order as in previousOrder wherever possible.
+        This is much faster than createOrderedNodeListFromScratch, but returns nullopt if the graph
+        contains a feedback loop.
+    */
+    static std::optional<Array<Node*>> createOrderedNodeListForAcyclicGraph (const Nodes& n,
+                                                                             const Connections& c,
+                                                                             const std::vector<NodeID>& previousOrder)
+    {
+        const auto& nodes = n.getNodes();
+
+        std::map<NodeID, size_t> previousPositions;
+
+        for (size_t i = 0; i < previousOrder.size(); ++i)
+            previousPositions.emplace (previousOrder[i], i);
+
+        const auto getIndex = [&] (NodeID nodeID)
+        {
+            return (size_t) std::distance (nodes.begin(), std::lower_bound (nodes.begin(), nodes.end(), nodeID, ImplicitNode::compare));
+        };
+
+        // New nodes are placed after the nodes that were already in the graph
+        const auto getPriority = [&] (size_t index)
+        {
+            const auto nodeID = nodes.getUnchecked ((int) index)->nodeID;
+            const auto iter = previousPositions.find (nodeID);
+            return std::make_tuple (iter != previousPositions.cend() ? iter->second : previousOrder.size(), nodeID.uid, index);
+        };
+
+        std::vector<size_t> numSources ((size_t) nodes.size());
+        std::vector<std::vector<size_t>> destinations ((size_t) nodes.size());
+        std::set<decltype (getPriority (0))> ready;
+
+        for (size_t i = 0; i < (size_t) nodes.size(); ++i)
+        {
+            const auto sources = c.getSourceNodesForDestination (nodes.getUnchecked ((int) i)->nodeID);
+            numSources[i] = sources.size();
+
+            for (const auto& source : sources)
+                destinations[getIndex (source)].push_back (i);
+
+            if (sources.empty())
+                ready.insert (getPriority (i));
+        }
+
+        Array<Node*> result;
+        result.ensureStorageAllocated (nodes.size());
+
+        while (! ready.empty())
+        {
+            const auto index = std::get<2> (*ready.begin());
+            ready.erase (ready.begin());
+            result.add (nodes.getUnchecked ((int) index));
+
+            for (const auto destination : destinations[index])
+                if (--numSources[destination] == 0)
+                    ready.insert (getPriority (destination));
+        }
+
+        // If some nodes couldn't be placed, there must be a feedback loop
+        if (result.size() != nodes.size())
+            return {};
+
+        return result;
+    }
+
+    Array<Node*> createOrderedNodeListFromScratch (const Nodes& n, const Connections& c)
     {
         Array<Node*> result;
 
@@ -1118,7 +2132,7 @@ private:
     //==============================================================================
     template <typename RenderSequence>
     int findBufferForInputAudioChannel (const Connections& c,
-                                        const Connections::DestinationsForSources& reversed,
+                                        const DestinationsForSources& reversed,
                                         RenderSequence& sequence,
                                         Node& node,
                                         const int inputChan,
@@ -1263,7 +2277,7 @@ private:
 
     template <typename RenderSequence>
     int findBufferForInputMidiChannel (const Connections& c,
-                                       const Connections::DestinationsForSources& reversed,
+                                       const DestinationsForSources& reversed,
                                        RenderSequence& sequence,
                                        Node& node,
                                        int ourRenderingIndex)
@@ -1368,7 +2382,7 @@ private:
 
     template <typename RenderSequence>
     void createRenderingOpsForNode (const Connections& c,
-                                    const Connections::DestinationsForSources& reversed,
+                                    const DestinationsForSources& reversed,
                                     RenderSequence& sequence,
                                     Node& node,
                                     const int ourRenderingIndex)
@@ -1447,7 +2461,7 @@ private:
         return -1;
     }
 
-    void markAnyUnusedBuffersAsFree (const Connections::DestinationsForSources& c,
+    void markAnyUnusedBuffersAsFree (const DestinationsForSources& c,
                                      Array<AssignedBuffer>& buffers,
                                      const int stepIndex)
     {
@@ -1456,35 +2470,33 @@ private:
                 b.setFree();
     }
 
-    bool isBufferNeededLater (const Connections::DestinationsForSources& c,
-                              const int stepIndexToSearchFrom,
-                              const int inputChannelOfIndexToIgnore,
-                              const NodeAndChannel output) const
+    static bool isBufferNeededLater (const DestinationsForSources& c,
+                                     const int stepIndexToSearchFrom,
+                                     const int inputChannelOfIndexToIgnore,
+                                     const NodeAndChannel output)
     {
-        if (orderedNodes.size() <= stepIndexToSearchFrom)
-            return false;
+        return c.isNeededLater (output, stepIndexToSearchFrom, inputChannelOfIndexToIgnore);
+    }
 
-        if (c.isSourceConnectedToDestinationNodeIgnoringChannel (output,
-                                                                 orderedNodes.getUnchecked (stepIndexToSearchFrom)->nodeID,
-                                                                 inputChannelOfIndexToIgnore))
-        {
-            return true;
-        }
+    std::vector<NodeID> getNodeOrder() const
+    {
+        std::vector<NodeID> result;
+        result.reserve ((size_t) orderedNodes.size());
 
-        return std::any_of (orderedNodes.begin() + stepIndexToSearchFrom + 1, orderedNodes.end(), [&] (const auto* node)
-        {
-            return c.isSourceConnectedToDestinationNodeIgnoringChannel (output, node->nodeID, -1);
-        });
+        for (const auto* node : orderedNodes)
+            result.push_back (node->nodeID);
+
+        return result;
     }
 
     template <typename RenderSequence>
-    RenderSequenceBuilder (const Nodes& n, const Connections& c, RenderSequence& sequence)
-        : orderedNodes (createOrderedNodeList (n, c))
+    RenderSequenceBuilder (const Nodes& n, const Connections& c, const std::vector<NodeID>& previousOrder, RenderSequence& sequence)
+        : orderedNodes (createOrderedNodeList (n, c, previousOrder))
     {
         audioBuffers.add (AssignedBuffer::createReadOnlyEmpty()); // first buffer is read-only zeros
         midiBuffers .add (AssignedBuffer::createReadOnlyEmpty());
 
-        const auto reversed = c.getDestinationsForSources();
+        const DestinationsForSources reversed (c, orderedNodes);
 
         for (int i = 0; i < orderedNodes.size(); ++i)
         {
@@ -1495,6 +2507,7 @@ private:
 
         sequence.numBuffersNeeded = audioBuffers.size();
         sequence.numMidiBuffersNeeded = midiBuffers.size();
+        sequence.assignAudioBuffersByLifetime();
     }
 };
 
@@ -1510,24 +2523,43 @@ class RenderSequence
 public:
     using AudioGraphIOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
 
-    RenderSequence (const PrepareSettings s, const Nodes& n, const Connections& c)
+    RenderSequence (const PrepareSettings s,
+                    const Nodes& n,
+                    const Connections& c,
+                    const std::vector<AudioProcessorGraph::NodeID>& previousOrder,
+                    bool parallel)
         : RenderSequence (s, s.precision == AudioProcessor::ProcessingPrecision::singlePrecision
-                                ? RenderSequenceBuilder::build<float>  (n, c)
-                                : RenderSequenceBuilder::build<double> (n, c))
+                                ? RenderSequenceBuilder::build<float>  (n, c, previousOrder)
+                                : RenderSequenceBuilder::build<double> (n, c, previousOrder))
     {
+        if (parallel)
+            visitRenderSequence (*this, [] (auto& seq) { seq.prepareParallelRendering(); });
     }
 
     template <typename FloatType>
-    void process (AudioBuffer<FloatType>& audio, MidiBuffer& midi, AudioPlayHead* playHead)
+    void process (AudioBuffer<FloatType>& audio, MidiBuffer& midi, AudioPlayHead* playHead, RenderThreadPool& pool)
     {
         if (auto* s = std::get_if<GraphRenderSequence<FloatType>> (&sequence.sequence))
-            s->perform (audio, midi, playHead);
+            s->perform (audio, midi, playHead, pool);
         else
             jassertfalse; // Not prepared for this audio format!
     }
 
+    void attachNodeTimers (const NodeTimers& timers)
+    {
+        visitRenderSequence (*this, [&] (auto& seq) { seq.attachNodeTimers (timers); });
+    }
+
     int getLatencySamples() const { return sequence.latencySamples; }
     PrepareSettings getSettings() const { return settings; }
+    const auto& getNodeOrder() const { return sequence.nodeOrder; }
+
+    AudioProcessorGraph::RenderBufferInfo getRenderBufferInfo() const
+    {
+        AudioProcessorGraph::RenderBufferInfo result;
+        visitRenderSequence (*this, [&] (auto& seq) { result = seq.getRenderBufferInfo(); });
+        return result;
+    }
 
 private:
     template <typename This, typename Callback>
@@ -1555,11 +2587,11 @@ private:
 */
 class RenderSequenceSignature
 {
-    auto tie() const { return std::tie (settings, connections, nodes); }
+    auto tie() const { return std::tie (settings, connections, nodes, parallel, timed); }
 
 public:
-    RenderSequenceSignature (const PrepareSettings s, const Nodes& n, const Connections& c)
-        : settings (s), connections (c), nodes (getNodeMap (n)) {}
+    RenderSequenceSignature (const PrepareSettings s, const Nodes& n, const Connections& c, bool p, bool t)
+        : settings (s), connections (c), nodes (getNodeMap (n)), parallel (p), timed (t) {}
 
     bool operator== (const RenderSequenceSignature& other) const { return tie() == other.tie(); }
     bool operator!= (const RenderSequenceSignature& other) const { return tie() != other.tie(); }
@@ -1581,6 +2613,7 @@ private:
     PrepareSettings settings;
     Connections connections;
     NodeMap nodes;
+    bool parallel = false, timed = false;
 };
 
 //==============================================================================
@@ -1842,6 +2875,61 @@ public:
             n->getProcessor()->setNonRealtime (isProcessingNonRealtime);
     }
 
+    void setNumRenderThreads (int numThreads)
+    {
+        if (numThreads == renderThreadPool.getNumThreads())
+            return;
+
+        renderThreadPool.setNumThreads (numThreads);
+        rebuild (UpdateKind::sync);
+    }
+
+    int getNumRenderThreads() const noexcept
+    {
+        return renderThreadPool.getNumThreads();
+    }
+
+    void setWorkgroup (const AudioWorkgroup& workgroup)
+    {
+        renderThreadPool.setWorkgroup (workgroup);
+    }
+
+    RenderBufferInfo getRenderBufferInfo() const
+    {
+        return renderBufferInfo;
+    }
+
+    void setNodeTimingEnabled (bool shouldBeEnabled)
+    {
+        if (std::exchange (nodeTimingEnabled, shouldBeEnabled) == shouldBeEnabled)
+            return;
+
+        nodeTimers.clear();
+        rebuild (UpdateKind::sync);
+    }
+
+    bool isNodeTimingEnabled() const noexcept
+    {
+        return nodeTimingEnabled;
+    }
+
+    NodeTimingInfo getNodeTimingInfo (NodeID nodeID) const
+    {
+        const auto iter = nodeTimers.find (nodeID);
+
+        if (iter == nodeTimers.end())
+            return {};
+
+        const auto settings = nodeStates.getLastRequestedSettings();
+        return iter->second->getInfo (settings.has_value() ? settings->sampleRate : 0.0);
+    }
+
+    void resetNodeTimingInfo()
+    {
+        for (const auto& pair : nodeTimers)
+            pair.second->reset();
+    }
+
     template <typename Value>
     void processBlock (AudioBuffer<Value>& audio, MidiBuffer& midi, AudioPlayHead* playHead)
     {
@@ -1864,7 +2952,7 @@ public:
         // Only process if the graph has the correct blockSize, sampleRate etc.
         if (state != nullptr && state->getSettings() == nodeStates.getLastRequestedSettings())
         {
-            state->process (audio, midi, playHead);
+            state->process (audio, midi, playHead, renderThreadPool);
         }
         else
         {
@@ -1883,6 +2971,23 @@ private:
             ioProc->setParentGraph (owner);
     }
 
+    /*  Makes sure that there's a timer for each node, and none for nodes that have been removed.
+        Timers are shared with the render sequences that use them, so a timer that's removed here
+        will stay alive until the audio thread has finished with it.
+    */
+    void updateNodeTimers()
+    {
+        NodeTimers updated;
+
+        for (const auto* node : nodes.getNodes())
+        {
+            const auto iter = nodeTimers.find (node->nodeID);
+            updated.emplace (node->nodeID, iter != nodeTimers.end() ? iter->second : NodeTimer::Ptr (new NodeTimer));
+        }
+
+        nodeTimers = std::move (updated);
+    }
+
     void topologyChanged (UpdateKind updateKind)
     {
         owner->sendChangeMessage();
@@ -1896,11 +3001,20 @@ private:
             for (const auto node : nodes.getNodes())
                 setParentGraph (node->getProcessor());
 
-            const RenderSequenceSignature newSignature (*newSettings, nodes, connections);
+            const auto parallel = renderThreadPool.getNumThreads() > 0;
+            const RenderSequenceSignature newSignature (*newSettings, nodes, connections, parallel, nodeTimingEnabled);
 
             if (std::exchange (lastBuiltSequence, newSignature) != newSignature)
             {
-                auto sequence = std::make_unique<RenderSequence> (*newSettings, nodes, connections);
+                auto sequence = std::make_unique<RenderSequence> (*newSettings, nodes, connections, lastNodeOrder, parallel);
+
+                if (nodeTimingEnabled)
+                {
+                    updateNodeTimers();
+                    sequence->attachNodeTimers (nodeTimers);
+                }
+                lastNodeOrder = sequence->getNodeOrder();
+                renderBufferInfo = sequence->getRenderBufferInfo();
                 owner->setLatencySamples (sequence->getLatencySamples());
                 renderSequenceExchange.set (std::move (sequence));
             }
@@ -1908,6 +3022,7 @@ private:
         else
         {
             lastBuiltSequence.reset();
+            renderBufferInfo = {};
             renderSequenceExchange.set (nullptr);
         }
     }
@@ -1917,9 +3032,14 @@ private:
     Nodes nodes;
     Connections connections;
     NodeStates nodeStates;
+    RenderThreadPool renderThreadPool;
     RenderSequenceExchange renderSequenceExchange;
     NodeID lastNodeID;
     std::optional<RenderSequenceSignature> lastBuiltSequence;
+    std::vector<NodeID> lastNodeOrder;
+    RenderBufferInfo renderBufferInfo;
+    NodeTimers nodeTimers;
+    bool nodeTimingEnabled = false;
     LockingAsyncUpdater updater { [this] { handleAsyncUpdate(); } };
 };
 
@@ -1969,6 +3089,46 @@ void AudioProcessorGraph::setNonRealtime (bool isProcessingNonRealtime) noexcept
     pimpl->setNonRealtime (isProcessingNonRealtime);
 }
 
+void AudioProcessorGraph::setNumRenderThreads (int numThreads)
+{
+    pimpl->setNumRenderThreads (numThreads);
+}
+
+int AudioProcessorGraph::getNumRenderThreads() const noexcept
+{
+    return pimpl->getNumRenderThreads();
+}
+
+AudioProcessorGraph::RenderBufferInfo AudioProcessorGraph::getRenderBufferInfo() const
+{
+    return pimpl->getRenderBufferInfo();
+}
+
+void AudioProcessorGraph::setNodeTimingEnabled (bool shouldBeEnabled)
+{
+    pimpl->setNodeTimingEnabled (shouldBeEnabled);
+}
+
+bool AudioProcessorGraph::isNodeTimingEnabled() const noexcept
+{
+    return pimpl->isNodeTimingEnabled();
+}
+
+AudioProcessorGraph::NodeTimingInfo AudioProcessorGraph::getNodeTimingInfo (NodeID nodeID) const
+{
+    return pimpl->getNodeTimingInfo (nodeID);
+}
+
+void AudioProcessorGraph::resetNodeTimingInfo()
+{
+    pimpl->resetNodeTimingInfo();
+}
+
+void AudioProcessorGraph::audioWorkgroupContextChanged (const AudioWorkgroup& workgroup)
+{
+    pimpl->setWorkgroup (workgroup);
+}
+
 AudioProcessorGraph::Node::Ptr AudioProcessorGraph::removeNode (NodeID nodeID, UpdateKind updateKind)
 {
     return pimpl->removeNode (nodeID, updateKind);
@@ -2233,6 +3393,214 @@ public:
             // this graph, so we just want to make sure that we finish the test without timing out.
             logMessage ("render sequence built in " + String (duration) + " ms");
         }
+
+        beginTest ("rebuild time after a topology edit scales with node count");
+        {
+            for (const auto numChains : { 25, 50, 100, 200 })
+            {
+                constexpr auto chainLength = 4;
+                constexpr auto numEdits = 20;
+
+                AudioProcessorGraph graph;
+                graph.setPlayConfigDetails (2, 2, 44100.0, 512);
+
+                using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+                const auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+                const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+
+                std::vector<AudioProcessorGraph::NodeID> chainEnds;
+
+                for (auto chain = 0; chain < numChains; ++chain)
+                {
+                    auto previous = input;
+
+                    for (auto i = 0; i < chainLength; ++i)
+                    {
+                        const auto node = graph.addNode (BasicProcessor::make (BasicProcessor::getStereoProperties(),
+                                                                               MidiIn::no,
+                                                                               MidiOut::no),
+                                                         {},
+                                                         AudioProcessorGraph::UpdateKind::none)->nodeID;
+
+                        for (auto channel = 0; channel < 2; ++channel)
+                            graph.addConnection ({ { previous, channel }, { node, channel } }, AudioProcessorGraph::UpdateKind::none);
+
+                        previous = node;
+                    }
+
+                    chainEnds.push_back (previous);
+                }
+
+                graph.prepareToPlay (44100.0, 512);
+
+                const auto b = std::chrono::steady_clock::now();
+
+                // Each edit triggers a synchronous rebuild
+                for (auto edit = 0; edit < numEdits; ++edit)
+                {
+                    const AudioProcessorGraph::Connection connection { { chainEnds[(size_t) edit % chainEnds.size()], 0 }, { output, 0 } };
+
+                    if (graph.isConnected (connection))
+                        expect (graph.removeConnection (connection));
+                    else
+                        expect (graph.addConnection (connection));
+                }
+
+                const auto e = std::chrono::steady_clock::now();
+                const auto duration = std::chrono::duration<double, std::milli> (e - b).count() / numEdits;
+
+                logMessage (String (graph.getNumNodes()) + " nodes: rebuilt in " + String (duration, 3) + " ms per edit");
+            }
+        }
+
+        beginTest ("parallel rendering produces the same output as serial rendering");
+        {
+            const auto serial = MixBusGraph (0).render();
+
+            for (const auto numThreads : { 1, 3 })
+                expect (MixBusGraph (numThreads).render() == serial);
+        }
+
+        beginTest ("render buffers are shared between values with disjoint lifetimes");
+        {
+            MixBusGraph mixBus (0);
+            const auto result = mixBus.render();
+
+            for (size_t i = 0; i < result.size(); ++i)
+                expectWithinAbsoluteError (result[i], MixBusGraph::getExpectedOutput (MixBusGraph::getInput (i)), 1.0e-5f);
+
+            const auto info = mixBus.graph.getRenderBufferInfo();
+
+            // One extra channel is the read-only empty buffer, and another is spare
+            expect (info.peakLiveChannels > 0);
+            expectEquals (info.numAllocatedChannels, info.peakLiveChannels + 2);
+            expectEquals (info.numBytes, (size_t) info.numAllocatedChannels * (size_t) MixBusGraph::blockSize * sizeof (float));
+
+            mixBus.graph.releaseResources();
+            expectEquals (mixBus.graph.getRenderBufferInfo().numAllocatedChannels, 0);
+        }
+
+        beginTest ("node timing records every processed block");
+        {
+            const auto untimed = MixBusGraph (0).render();
+
+            for (const auto numThreads : { 0, 3 })
+            {
+                MixBusGraph mixBus (numThreads);
+                auto& graph = mixBus.graph;
+
+                expect (! graph.isNodeTimingEnabled());
+                graph.setNodeTimingEnabled (true);
+                expect (graph.isNodeTimingEnabled());
+
+                expect (mixBus.render() == untimed);
+
+                for (auto* node : graph.getNodes())
+                {
+                    const auto info = graph.getNodeTimingInfo (node->nodeID);
+
+                    expectEquals (info.numBlocks, (int64) MixBusGraph::numBlocks);
+                    expect (info.minMilliseconds <= info.averageMilliseconds);
+                    expect (info.averageMilliseconds <= info.maxMilliseconds);
+                    expect (info.minMilliseconds <= info.percentile95Milliseconds);
+                    expect (info.percentile95Milliseconds <= info.percentile99Milliseconds);
+                    expect (info.percentile99Milliseconds <= info.maxMilliseconds);
+                    expect (info.averageLoad <= info.maxLoad);
+                }
+
+                const auto anyNode = graph.getNodes().getFirst()->nodeID;
+
+                graph.resetNodeTimingInfo();
+                expectEquals (graph.getNodeTimingInfo (anyNode).numBlocks, (int64) 0);
+
+                mixBus.render();
+                expectEquals (graph.getNodeTimingInfo (anyNode).numBlocks, (int64) MixBusGraph::numBlocks);
+
+                graph.setNodeTimingEnabled (false);
+                expectEquals (graph.getNodeTimingInfo (anyNode).numBlocks, (int64) 0);
+
+                mixBus.render();
+                expectEquals (graph.getNodeTimingInfo (anyNode).numBlocks, (int64) 0);
+            }
+        }
+
+        beginTest ("nodes with silent input are skipped once their tail has finished");
+        {
+            constexpr auto blockSize = 64;
+
+            auto effect = std::make_unique<GainProcessor> (0.5f, 0.0f);
+            effect->tailSeconds = 2.5 * blockSize / 44100.0;
+            auto& gain = *effect;
+
+            SingleNodeGraph graph (std::move (effect), blockSize);
+
+            expectEquals (graph.render (true), 0.5f);
+            expectEquals (gain.numBlocksProcessed, 1);
+
+            // The first three silent blocks are still inside the tail
+            for (auto block = 0; block < 5; ++block)
+                expectEquals (graph.render (false), 0.0f);
+
+            expectEquals (gain.numBlocksProcessed, 4);
+
+            expectEquals (graph.render (true), 0.5f);
+            expectEquals (gain.numBlocksProcessed, 5);
+
+            // A change to the tail is picked up when the input next becomes silent
+            gain.tailSeconds = 0.5 * blockSize / 44100.0;
+
+            for (auto block = 0; block < 3; ++block)
+                expectEquals (graph.render (false), 0.0f);
+
+            expectEquals (gain.numBlocksProcessed, 6);
+        }
+
+        beginTest ("nodes with silent input aren't skipped until their latency has passed");
+        {
+            constexpr auto blockSize = 64;
+
+            auto effect = std::make_unique<GainProcessor> (0.5f, 0.0f);
+            effect->setLatencySamples (blockSize + blockSize / 2);
+            auto& gain = *effect;
+
+            SingleNodeGraph graph (std::move (effect), blockSize);
+
+            expectEquals (graph.render (true), 0.5f);
+
+            // The first two silent blocks still contain some of the delayed signal
+            for (auto block = 0; block < 4; ++block)
+                graph.render (false);
+
+            expectEquals (gain.numBlocksProcessed, 3);
+        }
+
+        beginTest ("nodes that may produce output from silent input are never skipped");
+        {
+            auto generator = std::make_unique<GainProcessor> (1.0f, 0.25f);
+            auto& gain = *generator;
+
+            SingleNodeGraph graph (std::move (generator), 64);
+
+            for (auto block = 0; block < 4; ++block)
+                expectEquals (graph.render (false), 0.25f);
+
+            expectEquals (gain.numBlocksProcessed, 4);
+        }
+
+        beginTest ("bypassed nodes with silent input are skipped");
+        {
+            auto generator = std::make_unique<GainProcessor> (1.0f, 0.25f);
+            auto& gain = *generator;
+
+            SingleNodeGraph graph (std::move (generator), 64);
+            graph.node->setBypassed (true);
+
+            for (auto block = 0; block < 4; ++block)
+                expectEquals (graph.render (false), 0.0f);
+
+            expectEquals (graph.render (true), 1.0f);
+            expectEquals (gain.numBlocksProcessed, 0);
+        }
     }
 
 private:
@@ -2291,6 +3659,219 @@ private:
         MidiIn midiIn;
         MidiOut midiOut;
     };
+
+    /*  Several chains of gain stages, feeding a bus and the graph output. */
+    struct MixBusGraph
+    {
+        static constexpr auto numChannels = 2;
+        static constexpr auto numChains = 8;
+        static constexpr auto chainLength = 4;
+        static constexpr auto blockSize = 256;
+        static constexpr auto numBlocks = 4;
+        static constexpr auto busGain = 0.25f;
+
+        explicit MixBusGraph (int numThreads)
+        {
+            graph.setPlayConfigDetails (numChannels, numChannels, 44100.0, blockSize);
+            graph.setNumRenderThreads (numThreads);
+
+            using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+            const auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+            const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+            const auto bus    = graph.addNode (GainProcessor::make (busGain, 0.0f))->nodeID;
+
+            for (auto chain = 0; chain < numChains; ++chain)
+            {
+                auto previous = input;
+
+                for (auto i = 0; i < chainLength; ++i)
+                {
+                    const auto [gain, offset] = getGainAndOffset (chain, i);
+                    const auto node = graph.addNode (GainProcessor::make (gain, offset))->nodeID;
+                    connect (previous, node);
+                    previous = node;
+                }
+
+                connect (previous, bus);
+
+                // Odd chains also feed the output directly, bypassing the bus
+                if (chain % 2 != 0)
+                    connect (previous, output);
+            }
+
+            connect (bus, output);
+            graph.prepareToPlay (44100.0, blockSize);
+        }
+
+        std::vector<float> render()
+        {
+            AudioBuffer<float> buffer (numChannels, blockSize);
+            MidiBuffer midi;
+            std::vector<float> result;
+
+            for (auto block = 0; block < numBlocks; ++block)
+            {
+                for (auto channel = 0; channel < numChannels; ++channel)
+                    for (auto i = 0; i < blockSize; ++i)
+                        buffer.setSample (channel, i, getInput (result.size() + (size_t) (channel * blockSize + i)));
+
+                graph.processBlock (buffer, midi);
+
+                for (auto channel = 0; channel < numChannels; ++channel)
+                    result.insert (result.end(), buffer.getReadPointer (channel), buffer.getReadPointer (channel) + blockSize);
+            }
+
+            return result;
+        }
+
+        static float getInput (size_t index)
+        {
+            return std::sin ((float) index * 0.01f);
+        }
+
+        static float getExpectedOutput (float input)
+        {
+            auto busSum = 0.0f, directSum = 0.0f;
+
+            for (auto chain = 0; chain < numChains; ++chain)
+            {
+                auto value = input;
+
+                for (auto i = 0; i < chainLength; ++i)
+                {
+                    const auto [gain, offset] = getGainAndOffset (chain, i);
+                    value = value * gain + offset;
+                }
+
+                busSum += value;
+
+                if (chain % 2 != 0)
+                    directSum += value;
+            }
+
+            return busSum * busGain + directSum;
+        }
+
+        AudioProcessorGraph graph;
+
+    private:
+        static std::tuple<float, float> getGainAndOffset (int chain, int i)
+        {
+            const auto index = (float) (chain * chainLength + i);
+            return { 0.5f + 0.01f * index, 0.001f * index };
+        }
+
+        void connect (AudioProcessorGraph::NodeID source, AudioProcessorGraph::NodeID destination)
+        {
+            for (auto channel = 0; channel < numChannels; ++channel)
+                graph.addConnection ({ { source, channel }, { destination, channel } });
+        }
+    };
+
+    /*  A graph that passes its input through a single node to its output. */
+    struct SingleNodeGraph
+    {
+        SingleNodeGraph (std::unique_ptr<AudioProcessor> processor, int blockSizeIn)
+            : blockSize (blockSizeIn)
+        {
+            graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+
+            using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+            const auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+            const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+            node = graph.addNode (std::move (processor));
+
+            for (auto channel = 0; channel < 2; ++channel)
+            {
+                graph.addConnection ({ { input, channel }, { node->nodeID, channel } });
+                graph.addConnection ({ { node->nodeID, channel }, { output, channel } });
+            }
+
+            graph.prepareToPlay (44100.0, blockSize);
+        }
+
+        /*  Renders a block of either silence or ones, and returns the output level, which is
+            expected to be constant.
+        */
+        float render (bool withSignal)
+        {
+            AudioBuffer<float> buffer (2, blockSize);
+            MidiBuffer midi;
+
+            if (withSignal)
+                for (auto channel = 0; channel < 2; ++channel)
+                    FloatVectorOperations::fill (buffer.getWritePointer (channel), 1.0f, blockSize);
+            else
+                buffer.clear();
+
+            graph.processBlock (buffer, midi);
+
+            const auto level = buffer.getSample (0, 0);
+            const auto range = buffer.findMinMax (1, 0, blockSize);
+
+            if (! exactlyEqual (range.getStart(), level) || ! exactlyEqual (range.getEnd(), level))
+                return std::numeric_limits<float>::quiet_NaN();
+
+            return level;
+        }
+
+        AudioProcessorGraph graph;
+        AudioProcessorGraph::Node::Ptr node;
+        int blockSize = 0;
+    };
+
+    class GainProcessor final : public AudioProcessor
+    {
+    public:
+        GainProcessor (float gainIn, float offsetIn)
+            : AudioProcessor (BusesProperties().withInput  ("in",  AudioChannelSet::stereo())
+                                               .withOutput ("out", AudioChannelSet::stereo())),
+              gain (gainIn),
+              offset (offsetIn) {}
+
+        const String getName() const override                         { return "Gain Processor"; }
+        double getTailLengthSeconds() const override                  { return tailSeconds; }
+        bool producesSilenceForSilentInput() const override           { return exactlyEqual (offset, 0.0f); }
+        bool acceptsMidi() const override                             { return false; }
+        bool producesMidi() const override                            { return false; }
+        AudioProcessorEditor* createEditor() override                 { return {}; }
+        bool hasEditor() const override                               { return {}; }
+        int getNumPrograms() override                                 { return 1; }
+        int getCurrentProgram() override                              { return {}; }
+        void setCurrentProgram (int) override                         {}
+        const String getProgramName (int) override                    { return {}; }
+        void changeProgramName (int, const String&) override          {}
+        void getStateInformation (juce::MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override          {}
+        void prepareToPlay (double, int) override                     {}
+        void releaseResources() override                              {}
+
+        void processBlock (AudioBuffer<float>& audio, MidiBuffer&) override
+        {
+            ++numBlocksProcessed;
+
+            for (auto channel = 0; channel < audio.getNumChannels(); ++channel)
+            {
+                auto* data = audio.getWritePointer (channel);
+
+                for (auto i = 0; i < audio.getNumSamples(); ++i)
+                    data[i] = data[i] * gain + offset;
+            }
+        }
+
+        using AudioProcessor::processBlock;
+
+        static std::unique_ptr<AudioProcessor> make (float gain, float offset)
+        {
+            return std::make_unique<GainProcessor> (gain, offset);
+        }
+
+        double tailSeconds = 0.0;
+        int numBlocksProcessed = 0;
+
+    private:
+        float gain = 1.0f, offset = 0.0f;
+    };
 };
 
 static AudioProcessorGraphTests audioProcessorGraphTests;
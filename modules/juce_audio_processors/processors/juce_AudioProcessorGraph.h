@@ -323,6 +323,130 @@ public:
     */
     void rebuild();
 
+    //==============================================================================
+    /** Sets the number of worker threads that may help to render the graph.
+
+        By default this is 0, and the whole graph is rendered on the thread that calls
+        processBlock(). When this is greater than 0, the graph will start this many realtime
+        worker threads, and nodes that don't depend on one another (for example, the separate
+        channel strips feeding into a mix bus) will be processed concurrently. The thread calling
+        processBlock() always takes part in rendering, and will wait for the workers to finish
+        before returning.
+
+        The output of a parallel render is identical to that of a serial render. If the worker
+        threads are unavailable when processBlock() is called, e.g. because they're being
+        reconfigured, the graph will fall back to rendering serially for that block.
+
+        Note that when parallel rendering is enabled, the processBlock() functions of the nodes
+        in the graph may be called from any of the worker threads, and several nodes may be
+        processed at the same time.
+
+        Call this from the message thread only.
+
+        @see getNumRenderThreads
+    */
+    void setNumRenderThreads (int numThreads);
+
+    /** Returns the number of worker threads that will help to render the graph.
+
+        @see setNumRenderThreads
+    */
+    int getNumRenderThreads() const noexcept;
+
+    //==============================================================================
+    /** Describes the audio buffers that the graph allocates for rendering.
+
+        @see getRenderBufferInfo
+    */
+    struct RenderBufferInfo
+    {
+        /** The number of channels in the graph's internal rendering buffer. */
+        int numAllocatedChannels = 0;
+
+        /** The largest number of channels that hold audio that is still needed at any point
+            during rendering. The graph will never need fewer channels than this.
+        */
+        int peakLiveChannels = 0;
+
+        /** The size of the internal rendering buffer in bytes. */
+        size_t numBytes = 0;
+    };
+
+    /** Returns information about the audio buffers used by the most recently built render
+        sequence.
+
+        If the graph hasn't been prepared, all of the returned values will be 0.
+
+        Call this from the message thread only.
+    */
+    RenderBufferInfo getRenderBufferInfo() const;
+
+    //==============================================================================
+    /** Enables or disables timing of the individual nodes in the graph.
+
+        When enabled, the graph will measure how long each node's processBlock() call takes,
+        which can be useful for finding out which node is causing the audio thread to miss
+        its deadline. The measurements can be read with getNodeTimingInfo().
+
+        Timing is done without locks, so it's safe to leave it enabled while the graph is
+        playing. When disabled, the graph does no timing at all.
+
+        Enabling or disabling timing will rebuild the graph's render sequence. Call this from
+        the message thread only.
+
+        @see isNodeTimingEnabled, getNodeTimingInfo
+    */
+    void setNodeTimingEnabled (bool shouldBeEnabled);
+
+    /** Returns true if the nodes in the graph are being timed.
+
+        @see setNodeTimingEnabled
+    */
+    bool isNodeTimingEnabled() const noexcept;
+
+    /** Holds the processing time measurements for a single node.
+
+        @see getNodeTimingInfo
+    */
+    struct NodeTimingInfo
+    {
+        /** The number of blocks that have been timed. */
+        int64 numBlocks = 0;
+
+        /** The shortest, mean, and longest time spent processing a single block. */
+        double minMilliseconds = 0.0, averageMilliseconds = 0.0, maxMilliseconds = 0.0;
+
+        /** 95% and 99% of blocks were processed in less than these times.
+            These are approximations, accurate to within about 10%.
+        */
+        double percentile95Milliseconds = 0.0, percentile99Milliseconds = 0.0;
+
+        /** The mean proportion of the available time that was spent in this node, where 1.0
+            means that the node took as long to process a block as it would take to play it.
+        */
+        double averageLoad = 0.0;
+
+        /** The largest proportion of the available time that was spent processing any single
+            block.
+        */
+        double maxLoad = 0.0;
+    };
+
+    /** Returns the measurements that have been made for a node since timing was enabled, or
+        since resetNodeTimingInfo() was last called.
+
+        If timing is disabled, or the node hasn't been processed, all of the returned values
+        will be 0.
+
+        Call this from the message thread only.
+
+        @see setNodeTimingEnabled, resetNodeTimingInfo
+    */
+    NodeTimingInfo getNodeTimingInfo (NodeID) const;
+
+    /** Discards the measurements that have been made for all nodes. */
+    void resetNodeTimingInfo();
+
     //==============================================================================
     /** A special type of AudioProcessor that can live inside an AudioProcessorGraph
         in order to use the audio that comes into and out of the graph itself.
@@ -419,6 +543,7 @@ public:
 
     void reset() override;
     void setNonRealtime (bool) noexcept override;
+    void audioWorkgroupContextChanged (const AudioWorkgroup&) override;
 
     double getTailLengthSeconds() const override;
     bool acceptsMidi() const override;
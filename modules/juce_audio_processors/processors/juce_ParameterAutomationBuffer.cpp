@@ -0,0 +1,192 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+void ParameterAutomationBuffer::ensureSize (size_t minimumNumEvents)
+{
+    events.reserve (minimumNumEvents);
+}
+
+void ParameterAutomationBuffer::addEvent (AudioProcessorParameter& parameter, float newValue, int samplePosition)
+{
+    const Event event { &parameter, newValue, jmax (0, samplePosition) };
+
+    // Hosts usually deliver the points for each parameter in order, so most events can be appended
+    if (events.empty() || events.back().samplePosition <= event.samplePosition)
+    {
+        events.push_back (event);
+        return;
+    }
+
+    const auto insertionPoint = std::upper_bound (events.begin(), events.end(), event, [] (const Event& a, const Event& b)
+    {
+        return a.samplePosition < b.samplePosition;
+    });
+
+    events.insert (insertionPoint, event);
+}
+
+Span<const ParameterAutomationBuffer::Event> ParameterAutomationBuffer::getEventsInRange (int startSample, int endSample) const noexcept
+{
+    const auto comparePosition = [] (const Event& e, int position) { return e.samplePosition < position; };
+
+    const auto first = std::lower_bound (events.begin(), events.end(), startSample, comparePosition);
+    const auto last  = std::lower_bound (first, events.end(), jmax (startSample, endSample), comparePosition);
+
+    return { first, (size_t) std::distance (first, last) };
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ParameterAutomationBufferTests final : public UnitTest
+{
+public:
+    ParameterAutomationBufferTests()
+        : UnitTest ("ParameterAutomationBuffer", UnitTestCategories::audioProcessorParameters) {}
+
+    void runTest() override
+    {
+        AudioParameterFloat a ("a", "A", 0.0f, 1.0f, 0.0f);
+        AudioParameterFloat b ("b", "B", 0.0f, 1.0f, 0.0f);
+
+        beginTest ("Events are sorted by position, keeping the order of simultaneous events");
+        {
+            ParameterAutomationBuffer buffer;
+            buffer.ensureSize (16);
+
+            buffer.addEvent (a, 0.1f, 0);
+            buffer.addEvent (a, 0.2f, 100);
+            buffer.addEvent (a, 0.3f, 200);
+            buffer.addEvent (b, 0.4f, 50);
+            buffer.addEvent (b, 0.5f, 100);
+            buffer.addEvent (b, 0.6f, -10);
+
+            expectEquals (buffer.getNumEvents(), 6);
+            expect (getPositions (buffer.getEvents()) == Array<int> { 0, 0, 50, 100, 100, 200 });
+            expect (getValues (buffer.getEvents()) == Array<float> { 0.1f, 0.6f, 0.4f, 0.2f, 0.5f, 0.3f });
+
+            expect (getPositions (buffer.getEventsInRange (50, 200)) == Array<int> { 50, 100, 100 });
+            expect (getPositions (buffer.getEventsInRange (60, 99)) == Array<int>{});
+            expect (getPositions (buffer.getEventsInRange (200, 100)) == Array<int>{});
+
+            const auto* storage = buffer.begin();
+            buffer.clear();
+            expect (buffer.isEmpty());
+
+            for (auto i = 0; i < 16; ++i)
+                buffer.addEvent (a, 0.0f, 15 - i);
+
+            expect (buffer.begin() == storage);
+        }
+
+        beginTest ("Segments start at each change and cover the whole block");
+        {
+            ParameterAutomationBuffer buffer;
+            buffer.addEvent (a, 0.5f, 10);
+            buffer.addEvent (b, 0.5f, 10);
+            buffer.addEvent (a, 1.0f, 30);
+            buffer.addEvent (a, 0.0f, 64);
+
+            Array<int> starts, lengths, numChanges;
+
+            buffer.forEachSegment (64, [&] (int start, int num, Span<const ParameterAutomationBuffer::Event> changes)
+            {
+                starts.add (start);
+                lengths.add (num);
+                numChanges.add ((int) changes.size());
+            });
+
+            expect (starts     == Array<int> { 0, 10, 30 });
+            expect (lengths    == Array<int> { 10, 20, 34 });
+            expect (numChanges == Array<int> { 0, 2, 1 });
+        }
+
+        beginTest ("Nearby changes are merged into one segment");
+        {
+            ParameterAutomationBuffer buffer;
+
+            for (auto i = 0; i < 64; i += 4)
+                buffer.addEvent (a, (float) i / 64.0f, i);
+
+            Array<int> starts, numChanges;
+
+            buffer.forEachSegment (64, [&] (int start, int, Span<const ParameterAutomationBuffer::Event> changes)
+            {
+                starts.add (start);
+                numChanges.add ((int) changes.size());
+            }, 16);
+
+            expect (starts     == Array<int> { 0, 16, 32, 48 });
+            expect (numChanges == Array<int> { 4, 4, 4, 4 });
+        }
+
+        beginTest ("A block without changes is a single segment");
+        {
+            ParameterAutomationBuffer buffer;
+            auto numSegments = 0;
+
+            buffer.forEachSegment (512, [&] (int start, int num, Span<const ParameterAutomationBuffer::Event> changes)
+            {
+                ++numSegments;
+                expectEquals (start, 0);
+                expectEquals (num, 512);
+                expect (changes.empty());
+            });
+
+            expectEquals (numSegments, 1);
+        }
+    }
+
+private:
+    static Array<int> getPositions (Span<const ParameterAutomationBuffer::Event> events)
+    {
+        Array<int> result;
+
+        for (const auto& e : events)
+            result.add (e.samplePosition);
+
+        return result;
+    }
+
+    static Array<float> getValues (Span<const ParameterAutomationBuffer::Event> events)
+    {
+        Array<float> result;
+
+        for (const auto& e : events)
+            result.add (e.value);
+
+        return result;
+    }
+};
+
+static ParameterAutomationBufferTests parameterAutomationBufferTests;
+
+#endif
+
+} // namespace juce
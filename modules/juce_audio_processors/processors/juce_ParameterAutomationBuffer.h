@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class AudioProcessorParameter;
+
+//==============================================================================
+/**
+    Holds the sample-accurate parameter changes that a host has scheduled within a
+    single block of audio.
+
+    Before calling AudioProcessor::processBlock(), the plugin wrappers fill the processor's
+    buffer (see AudioProcessor::getParameterAutomation()) with every point from the host's
+    parameter queues, and then set each automated parameter to the last value that it will
+    take in the block, exactly as they would if this buffer didn't exist. Processors that only
+    read parameter values once per block therefore behave as before, while processors that
+    want smooth automation can use the events to follow the host's curve within the block:
+
+    @code
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+    {
+        getParameterAutomation().forEachSegment (buffer.getNumSamples(),
+                                                 [&] (int start, int num, Span<const ParameterAutomationBuffer::Event> changes)
+        {
+            for (const auto& change : changes)
+                if (change.parameter == gainParameter)
+                    gain.setTargetValue (gainParameter->convertFrom0to1 (change.value));
+
+            gain.applyGain (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, num);
+        });
+    }
+    @endcode
+
+    The buffer keeps its events sorted by sample position. As long as enough space has
+    been reserved with ensureSize(), adding events and iterating over them never allocates.
+
+    @see AudioProcessor::getParameterAutomation, MidiBuffer
+
+    @tags{Audio}
+*/
+class JUCE_API  ParameterAutomationBuffer
+{
+public:
+    //==============================================================================
+    /** A single parameter change. */
+    struct Event
+    {
+        /** The parameter that changes. */
+        AudioProcessorParameter* parameter = nullptr;
+
+        /** The normalised value, in the range 0 to 1, that the parameter takes. */
+        float value = 0.0f;
+
+        /** The position within the block at which the parameter takes this value. */
+        int samplePosition = 0;
+    };
+
+    //==============================================================================
+    /** Creates an empty buffer. */
+    ParameterAutomationBuffer() = default;
+
+    /** Preallocates space for a number of events, so that adding up to that many events
+        won't allocate.
+    */
+    void ensureSize (size_t minimumNumEvents);
+
+    /** Removes all events from the buffer. This doesn't free any storage. */
+    void clear() noexcept                                   { events.clear(); }
+
+    /** Adds an event, keeping the events sorted by sample position.
+
+        Events at the same position are kept in the order in which they were added.
+        This will only allocate if the space reserved with ensureSize() has been used up.
+    */
+    void addEvent (AudioProcessorParameter& parameter, float newValue, int samplePosition);
+
+    /** Returns the number of events in the buffer. */
+    int getNumEvents() const noexcept                       { return (int) events.size(); }
+
+    /** Returns true if there are no events in the buffer. */
+    bool isEmpty() const noexcept                           { return events.empty(); }
+
+    /** Returns all of the events, sorted by sample position. */
+    Span<const Event> getEvents() const noexcept            { return events; }
+
+    /** Returns the events whose positions are in the range [startSample, endSample). */
+    Span<const Event> getEventsInRange (int startSample, int endSample) const noexcept;
+
+    const Event* begin() const noexcept                     { return events.data(); }
+    const Event* end() const noexcept                       { return events.data() + events.size(); }
+
+    //==============================================================================
+    /** Divides a block of numSamples samples into segments, each of which starts either at
+        the start of the block or at a position where one or more parameters change.
+
+        The callback is called once for each segment, in order, with the signature
+        @code
+        void (int startSample, int numSamples, Span<const ParameterAutomationBuffer::Event> changesAtStart)
+        @endcode
+        where changesAtStart holds the events at the segment's first sample, and will be empty
+        for a first segment without any changes. If there are no events, the callback is called
+        once for the whole block.
+
+        Events closer together than minimumSegmentLength are merged into one segment, so
+        that dense automation doesn't force tiny segments: their changes are all passed at
+        the start of the segment. Events at or after numSamples are ignored.
+
+        This doesn't allocate.
+    */
+    template <typename Callback>
+    void forEachSegment (int numSamples, Callback&& callback, int minimumSegmentLength = 1) const
+    {
+        jassert (minimumSegmentLength > 0);
+
+        auto it = begin();
+        const auto last = end();
+
+        for (auto start = 0; start < numSamples;)
+        {
+            const auto firstChange = it;
+            const auto mergeUntil = start + jmax (1, minimumSegmentLength);
+
+            while (it != last && it->samplePosition < jmin (mergeUntil, numSamples))
+                ++it;
+
+            const auto segmentEnd = it != last ? jmin (it->samplePosition, numSamples) : numSamples;
+
+            callback (start, segmentEnd - start, Span<const Event> (firstChange, (size_t) (it - firstChange)));
+            start = segmentEnd;
+        }
+    }
+
+private:
+    std::vector<Event> events;
+
+    JUCE_LEAK_DETECTOR (ParameterAutomationBuffer)
+};
+
+} // namespace juce
@@ -110,6 +110,61 @@ bool KnownPluginList::addType (const PluginDescription& type)
     return true;
 }
 
+int KnownPluginList::addTypes (const Array<PluginDescription>& typesToAdd)
+{
+    if (typesToAdd.isEmpty())
+        return 0;
+
+    int numAdded = 0;
+
+    {
+        ScopedLock lock (typesArrayLock);
+
+        // This uses the same fields as PluginDescription::isDuplicateOf()
+        const auto getKey = [] (const PluginDescription& d)
+        {
+            return std::make_tuple (d.fileOrIdentifier, d.deprecatedUid, d.uniqueId);
+        };
+
+        std::map<std::tuple<String, int, int>, int> existing;
+
+        for (int i = 0; i < types.size(); ++i)
+            existing.emplace (getKey (types.getReference (i)), i);
+
+        Array<PluginDescription> added;
+
+        for (auto& type : typesToAdd)
+        {
+            const auto [iter, isNew] = existing.emplace (getKey (type), -1 - added.size());
+
+            if (isNew)
+            {
+                added.add (type);
+                continue;
+            }
+
+            auto& desc = iter->second >= 0 ? types.getReference (iter->second)
+                                           : added.getReference (-1 - iter->second);
+
+            // strange - found a duplicate plugin with different info..
+            jassert (desc.name == type.name);
+            jassert (desc.isInstrument == type.isInstrument);
+
+            desc = type;
+        }
+
+        numAdded = added.size();
+
+        // New types go at the start of the list, in the same order that addType() would leave them
+        std::reverse (added.begin(), added.end());
+        added.addArray (types);
+        types.swapWith (added);
+    }
+
+    sendChangeMessage();
+    return numAdded;
+}
+
 void KnownPluginList::removeType (const PluginDescription& type)
 {
     {
@@ -123,12 +178,31 @@ void KnownPluginList::removeType (const PluginDescription& type)
     sendChangeMessage();
 }
 
+static std::optional<Array<PluginDescription>> findUpToDateCachedTypes (const PluginScanCache& cache,
+                                                                        AudioPluginFormat& format,
+                                                                        const String& fileOrIdentifier)
+{
+    auto cachedTypes = cache.findTypesFor (format.getName(), fileOrIdentifier);
+
+    // The cache can only see changes to plugin files and bundles, so the format still gets
+    // the final say. This matters for AudioUnits and LV2 plugins, whose identifiers aren't files.
+    if (cachedTypes.has_value())
+        for (auto& d : *cachedTypes)
+            if (format.pluginNeedsRescanning (d))
+                return {};
+
+    return cachedTypes;
+}
+
 bool KnownPluginList::isListingUpToDate (const String& fileOrIdentifier,
                                          AudioPluginFormat& formatToUse) const
 {
     if (getTypeForFile (fileOrIdentifier) == nullptr)
         return false;
 
+    if (scanCache != nullptr)
+        return findUpToDateCachedTypes (*scanCache, formatToUse, fileOrIdentifier).has_value();
+
     ScopedLock lock (typesArrayLock);
 
     for (auto& d : types)
@@ -144,6 +218,12 @@ void KnownPluginList::setCustomScanner (std::unique_ptr<CustomScanner> newScanne
         scanner = std::move (newScanner);
 }
 
+void KnownPluginList::setScanCache (std::unique_ptr<PluginScanCache> newCache)
+{
+    const ScopedLock sl (scanLock);
+    scanCache = std::move (newCache);
+}
+
 bool KnownPluginList::scanAndAddFile (const String& fileOrIdentifier,
                                       const bool dontRescanIfAlreadyInList,
                                       OwnedArray<PluginDescription>& typesFound,
@@ -151,8 +231,20 @@ bool KnownPluginList::scanAndAddFile (const String& fileOrIdentifier,
 {
     const ScopedLock sl (scanLock);
 
-    if (dontRescanIfAlreadyInList
-         && getTypeForFile (fileOrIdentifier) != nullptr)
+    if (dontRescanIfAlreadyInList && scanCache != nullptr)
+    {
+        if (auto cachedTypes = findUpToDateCachedTypes (*scanCache, format, fileOrIdentifier))
+        {
+            typesFound.ensureStorageAllocated (typesFound.size() + cachedTypes->size());
+
+            for (auto& desc : *cachedTypes)
+                typesFound.add (new PluginDescription (desc));
+
+            return addTypes (*cachedTypes) > 0;
+        }
+    }
+    else if (dontRescanIfAlreadyInList
+              && getTypeForFile (fileOrIdentifier) != nullptr)
     {
         bool needsRescanning = false;
 
@@ -177,13 +269,16 @@ bool KnownPluginList::scanAndAddFile (const String& fileOrIdentifier,
         return false;
 
     OwnedArray<PluginDescription> found;
+    bool crashed = false;
 
     {
         const ScopedUnlock sl2 (scanLock);
 
         if (scanner != nullptr)
         {
-            if (! scanner->findPluginTypesFor (format, found, fileOrIdentifier))
+            crashed = ! scanner->findPluginTypesFor (format, found, fileOrIdentifier);
+
+            if (crashed)
                 addToBlacklist (fileOrIdentifier);
         }
         else
@@ -204,6 +299,26 @@ bool KnownPluginList::scanAndAddFile (const String& fileOrIdentifier,
         typesFound.add (new PluginDescription (*desc));
     }
 
+    if (scanCache != nullptr)
+    {
+        // Plugins that didn't produce any types aren't cached, so that they'll be retried
+        // next time in case the failure was only temporary
+        if (crashed || found.isEmpty())
+        {
+            scanCache->removeTypesFor (format.getName(), fileOrIdentifier);
+        }
+        else
+        {
+            Array<PluginDescription> toCache;
+
+            for (auto* desc : found)
+                if (desc != nullptr)
+                    toCache.add (*desc);
+
+            scanCache->storeTypesFor (format.getName(), fileOrIdentifier, toCache);
+        }
+    }
+
     return ! found.isEmpty();
 }
 
@@ -248,6 +363,14 @@ void KnownPluginList::scanFinished()
 {
     if (scanner != nullptr)
         scanner->scanFinished();
+
+    const ScopedLock sl (scanLock);
+
+    if (scanCache != nullptr && scanCache->hasUnsavedChanges())
+    {
+        [[maybe_unused]] const auto result = scanCache->save();
+        jassert (result.wasOk()); // couldn't write the cache file
+    }
 }
 
 const StringArray& KnownPluginList::getBlacklistedFiles() const
@@ -383,6 +506,8 @@ void KnownPluginList::recreateFromXml (const XmlElement& xml)
 
     if (xml.hasTagName ("KNOWNPLUGINS"))
     {
+        Array<PluginDescription> loaded;
+
         for (auto* e : xml.getChildIterator())
         {
             PluginDescription info;
@@ -390,8 +515,10 @@ void KnownPluginList::recreateFromXml (const XmlElement& xml)
             if (e->hasTagName ("BLACKLISTED"))
                 blacklist.add (e->getStringAttribute ("id"));
             else if (info.loadFromXml (*e))
-                addType (info);
+                loaded.add (info);
         }
+
+        addTypes (loaded);
     }
 }
 
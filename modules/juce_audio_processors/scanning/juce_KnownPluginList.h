@@ -54,6 +54,15 @@ public:
     /** Adds a type manually from its description. */
     bool addType (const PluginDescription& type);
 
+    /** Adds a set of types, replacing any existing types that they duplicate.
+
+        This is much quicker than calling addType() for each one when adding a large number
+        of types, e.g. from PluginScanCache::getAllTypes().
+
+        Returns the number of types that weren't already in the list.
+    */
+    int addTypes (const Array<PluginDescription>& typesToAdd);
+
     /** Removes a type. */
     void removeType (const PluginDescription& type);
 
@@ -84,6 +93,10 @@ public:
         time has changed since the list was created. If dontRescanIfAlreadyInList is
         false, the file will always be reloaded and tested.
 
+        If a PluginScanCache has been set, then when dontRescanIfAlreadyInList is true the
+        cache is used instead of the list to decide whether the file needs to be loaded,
+        and the types found by any scan that does take place are stored in the cache.
+
         Returns true if any new types were added, and all the types found in this
         file (even if it was already known and hasn't been re-scanned) get returned
         in the array.
@@ -93,11 +106,16 @@ public:
                          OwnedArray<PluginDescription>& typesFound,
                          AudioPluginFormat& formatToUse);
 
-    /** Tells a custom scanner that a scan has finished, and it can release any resources. */
+    /** Tells a custom scanner that a scan has finished, and it can release any resources.
+        If a PluginScanCache has been set, any new results will be saved to it.
+    */
     void scanFinished();
 
     /** Returns true if the specified file is already known about and if it
         hasn't been modified since our entry was created.
+
+        If a PluginScanCache has been set, the cache's entry for the file is used to
+        decide whether it has been modified.
     */
     bool isListingUpToDate (const String& possiblePluginFileOrIdentifier,
                             AudioPluginFormat& formatToUse) const;
@@ -208,6 +226,24 @@ public:
     */
     void setCustomScanner (std::unique_ptr<CustomScanner> newScanner);
 
+    //==============================================================================
+    /** Supplies a cache of scan results to be used in future scans.
+
+        A cached entry is only used if the plugin's file or bundle hasn't changed, and the
+        format's AudioPluginFormat::pluginNeedsRescanning() returns false for all of its
+        types. Checking a bundle means listing every file inside it, so isListingUpToDate()
+        and scanAndAddFile() cost a directory walk per plugin, which is still much cheaper
+        than loading the plugin.
+
+        The KnownPluginList will take ownership of the object passed in. Pass nullptr to
+        stop using a cache.
+        @see PluginScanCache, scanAndAddFile
+    */
+    void setScanCache (std::unique_ptr<PluginScanCache> newCache);
+
+    /** Returns the cache that was set with setScanCache(), or nullptr if there isn't one. */
+    PluginScanCache* getScanCache() const noexcept       { return scanCache.get(); }
+
     //==============================================================================
    #ifndef DOXYGEN
     // These methods have been deprecated! When getting the list of plugin types you should instead use
@@ -232,6 +268,7 @@ private:
     Array<PluginDescription> types;
     StringArray blacklist;
     std::unique_ptr<CustomScanner> scanner;
+    std::unique_ptr<PluginScanCache> scanCache;
     CriticalSection scanLock, typesArrayLock;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (KnownPluginList)
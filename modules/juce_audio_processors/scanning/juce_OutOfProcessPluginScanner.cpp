@@ -0,0 +1,376 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  Requests hold the format name followed by the plugin's file or identifier.
+    Responses are a LIST element containing the descriptions that were found.
+*/
+static MemoryBlock createPluginScanRequest (const String& formatName, const String& fileOrIdentifier)
+{
+    MemoryBlock block;
+    MemoryOutputStream stream { block, false };
+    stream.writeString (formatName);
+    stream.writeString (fileOrIdentifier);
+    return block;
+}
+
+//==============================================================================
+/*  The coordinator side of a single worker process. */
+class OutOfProcessPluginScanner::WorkerProcess final : private ChildProcessCoordinator
+{
+public:
+    WorkerProcess (const File& executable, const String& commandLineUID)
+    {
+        // The worker's output isn't read, so it mustn't be redirected to a pipe that could fill up
+        launched = launchWorkerProcess (executable, commandLineUID, 0, 0);
+    }
+
+    ~WorkerProcess() override
+    {
+        killWorkerProcess();
+    }
+
+    bool isLaunched() const noexcept    { return launched; }
+
+    enum class Outcome
+    {
+        gotResult,
+        timedOut,
+        connectionLost,
+        cancelled
+    };
+
+    template <typename ShouldExit>
+    Outcome scan (const String& formatName,
+                  const String& fileOrIdentifier,
+                  int timeoutMs,
+                  ShouldExit&& shouldExit,
+                  OwnedArray<PluginDescription>& result)
+    {
+        {
+            const std::lock_guard<std::mutex> lock { mutex };
+            response.reset();
+        }
+
+        if (! sendMessageToWorker (createPluginScanRequest (formatName, fileOrIdentifier)))
+            return Outcome::connectionLost;
+
+        const auto deadline = Time::getMillisecondCounter() + (uint32) jmax (0, timeoutMs);
+
+        for (;;)
+        {
+            if (shouldExit())
+                return Outcome::cancelled;
+
+            if (timeoutMs > 0 && Time::getMillisecondCounter() >= deadline)
+                return Outcome::timedOut;
+
+            std::unique_lock<std::mutex> lock { mutex };
+
+            if (! condvar.wait_for (lock, std::chrono::milliseconds { 50 }, [&] { return response != nullptr || connectionLost; }))
+                continue;
+
+            if (response == nullptr)
+                return Outcome::connectionLost;
+
+            for (const auto* item : response->getChildIterator())
+            {
+                auto desc = std::make_unique<PluginDescription>();
+
+                if (desc->loadFromXml (*item))
+                    result.add (std::move (desc));
+            }
+
+            response.reset();
+            return Outcome::gotResult;
+        }
+    }
+
+private:
+    void handleMessageFromWorker (const MemoryBlock& mb) override
+    {
+        auto xml = parseXML (mb.toString());
+
+        if (xml == nullptr)
+            xml = std::make_unique<XmlElement> ("LIST");
+
+        const std::lock_guard<std::mutex> lock { mutex };
+        response = std::move (xml);
+        condvar.notify_one();
+    }
+
+    void handleConnectionLost() override
+    {
+        const std::lock_guard<std::mutex> lock { mutex };
+        connectionLost = true;
+        condvar.notify_one();
+    }
+
+    std::mutex mutex;
+    std::condition_variable condvar;
+    std::unique_ptr<XmlElement> response;
+    bool connectionLost = false;
+    bool launched = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkerProcess)
+};
+
+//==============================================================================
+OutOfProcessPluginScanner::OutOfProcessPluginScanner()
+    : OutOfProcessPluginScanner (Options{})
+{
+}
+
+OutOfProcessPluginScanner::OutOfProcessPluginScanner (const Options& optionsIn)
+    : options (optionsIn)
+{
+}
+
+OutOfProcessPluginScanner::~OutOfProcessPluginScanner()
+{
+    // All scans should have finished before the scanner is deleted
+    jassert (numWorkers == (int) idleWorkers.size());
+}
+
+bool OutOfProcessPluginScanner::findPluginTypesFor (AudioPluginFormat& format,
+                                                    OwnedArray<PluginDescription>& result,
+                                                    const String& fileOrIdentifier)
+{
+    auto worker = acquireWorker();
+
+    if (worker == nullptr)
+        return true;
+
+    if (! worker->isLaunched())
+    {
+        // The worker process couldn't be started. Make sure that the worker executable calls
+        // Worker::initialiseFromCommandLine() with a matching command-line ID.
+        jassertfalse;
+        releaseWorker (std::move (worker), false);
+        return true;
+    }
+
+    const auto outcome = worker->scan (format.getName(),
+                                       fileOrIdentifier,
+                                       options.getTimeoutMilliseconds(),
+                                       [this] { return shouldExit(); },
+                                       result);
+
+    // A worker that was cancelled may still send the result of its scan later on,
+    // so only a worker that has replied can be used again.
+    releaseWorker (std::move (worker), outcome == WorkerProcess::Outcome::gotResult);
+
+    return outcome == WorkerProcess::Outcome::gotResult
+        || outcome == WorkerProcess::Outcome::cancelled;
+}
+
+void OutOfProcessPluginScanner::scanFinished()
+{
+    std::vector<std::unique_ptr<WorkerProcess>> toDelete;
+
+    {
+        const std::lock_guard<std::mutex> lock { mutex };
+        numWorkers -= (int) idleWorkers.size();
+        std::swap (toDelete, idleWorkers);
+    }
+}
+
+std::unique_ptr<OutOfProcessPluginScanner::WorkerProcess> OutOfProcessPluginScanner::acquireWorker()
+{
+    {
+        std::unique_lock<std::mutex> lock { mutex };
+
+        for (;;)
+        {
+            if (! idleWorkers.empty())
+            {
+                auto worker = std::move (idleWorkers.back());
+                idleWorkers.pop_back();
+                return worker;
+            }
+
+            if (numWorkers < options.getMaximumNumberOfWorkers())
+            {
+                ++numWorkers;
+                break;
+            }
+
+            if (shouldExit())
+                return nullptr;
+
+            workerReleased.wait_for (lock, std::chrono::milliseconds { 50 });
+        }
+    }
+
+    return std::make_unique<WorkerProcess> (options.getWorkerExecutable(), options.getCommandLineUID());
+}
+
+void OutOfProcessPluginScanner::releaseWorker (std::unique_ptr<WorkerProcess> worker, bool canBeReused)
+{
+    {
+        const std::lock_guard<std::mutex> lock { mutex };
+
+        if (canBeReused)
+            idleWorkers.push_back (std::move (worker));
+        else
+            --numWorkers;
+    }
+
+    workerReleased.notify_one();
+}
+
+//==============================================================================
+class OutOfProcessPluginScanner::Worker::Impl final : private ChildProcessWorker,
+                                                      private AsyncUpdater
+{
+public:
+    Impl()
+    {
+        formatManager.addDefaultFormats();
+    }
+
+    AudioPluginFormatManager& getFormatManager() noexcept   { return formatManager; }
+
+    using ChildProcessWorker::initialiseFromCommandLine;
+
+private:
+    void handleMessageFromCoordinator (const MemoryBlock& mb) override
+    {
+        if (mb.isEmpty())
+            return;
+
+        if (! doScan (mb))
+        {
+            {
+                const std::lock_guard<std::mutex> lock (mutex);
+                pendingBlocks.emplace (mb);
+            }
+
+            triggerAsyncUpdate();
+        }
+    }
+
+    void handleConnectionLost() override
+    {
+        // The message thread may be stuck inside a plugin that has hung, and a worker
+        // has nothing that needs saving, so just exit straight away.
+        Process::terminate();
+    }
+
+    void handleAsyncUpdate() override
+    {
+        for (;;)
+        {
+            const auto block = [&]() -> MemoryBlock
+            {
+                const std::lock_guard<std::mutex> lock (mutex);
+
+                if (pendingBlocks.empty())
+                    return {};
+
+                auto out = std::move (pendingBlocks.front());
+                pendingBlocks.pop();
+                return out;
+            }();
+
+            if (block.isEmpty())
+                return;
+
+            doScan (block);
+        }
+    }
+
+    /*  Scans on the calling thread if the format allows it, otherwise returns false so that
+        the request can be handled on the message thread.
+    */
+    bool doScan (const MemoryBlock& block)
+    {
+        MemoryInputStream stream { block, false };
+        const auto formatName = stream.readString();
+        const auto identifier = stream.readString();
+
+        PluginDescription pd;
+        pd.fileOrIdentifier = identifier;
+        pd.uniqueId = pd.deprecatedUid = 0;
+
+        const auto matchingFormat = [&]() -> AudioPluginFormat*
+        {
+            for (auto* format : formatManager.getFormats())
+                if (format->getName() == formatName)
+                    return format;
+
+            return nullptr;
+        }();
+
+        if (matchingFormat != nullptr
+            && ! MessageManager::getInstance()->isThisTheMessageThread()
+            && ! matchingFormat->requiresUnblockedMessageThreadDuringCreation (pd))
+        {
+            return false;
+        }
+
+        OwnedArray<PluginDescription> results;
+
+        if (matchingFormat != nullptr)
+            matchingFormat->findAllTypesForFile (results, identifier);
+
+        XmlElement xml ("LIST");
+
+        for (const auto& desc : results)
+            xml.addChildElement (desc->createXml().release());
+
+        const auto str = xml.toString();
+        sendMessageToCoordinator ({ str.toRawUTF8(), str.getNumBytesAsUTF8() });
+        return true;
+    }
+
+    std::mutex mutex;
+    std::queue<MemoryBlock> pendingBlocks;
+
+    // After construction, this will only be accessed by doScan so there's no need
+    // to worry about synchronisation.
+    AudioPluginFormatManager formatManager;
+};
+
+OutOfProcessPluginScanner::Worker::Worker()
+    : impl (std::make_unique<Impl>())
+{
+}
+
+OutOfProcessPluginScanner::Worker::~Worker() = default;
+
+AudioPluginFormatManager& OutOfProcessPluginScanner::Worker::getFormatManager() noexcept
+{
+    return impl->getFormatManager();
+}
+
+bool OutOfProcessPluginScanner::Worker::initialiseFromCommandLine (const String& commandLine, const String& commandLineUID)
+{
+    return impl->initialiseFromCommandLine (commandLine, commandLineUID);
+}
+
+} // namespace juce
@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A KnownPluginList::CustomScanner that loads each plugin in a separate worker
+    process, so that a plugin that crashes or hangs while it's being scanned can't
+    take the host down with it.
+
+    Up to a fixed number of worker processes are launched on demand, and each one scans
+    one plugin at a time. If several threads scan at once (see
+    PluginListComponent::setNumberOfThreadsForScanning()), each thread is given its own
+    worker, so that plugins are scanned in parallel.
+
+    If a worker crashes, or doesn't finish scanning a plugin within the timeout, the worker
+    is discarded and the plugin is reported as having failed, which adds it to the
+    KnownPluginList's blacklist. A new worker will be launched for the next plugin.
+
+    The worker processes are started by launching the executable again with a special
+    command line. Your app must check for this at startup, before doing anything else,
+    by creating an OutOfProcessPluginScanner::Worker and calling its
+    initialiseFromCommandLine() method:
+
+    @code
+    void initialise (const String& commandLine) override
+    {
+        auto worker = std::make_unique<OutOfProcessPluginScanner::Worker>();
+
+        if (worker->initialiseFromCommandLine (commandLine))
+        {
+            scanWorker = std::move (worker);
+            return;
+        }
+
+        // ...normal startup...
+        knownPluginList.setCustomScanner (std::make_unique<OutOfProcessPluginScanner>());
+    }
+    @endcode
+
+    @see KnownPluginList::setCustomScanner, ChildProcessCoordinator
+
+    @tags{Audio}
+*/
+class JUCE_API  OutOfProcessPluginScanner  : public KnownPluginList::CustomScanner
+{
+public:
+    //==============================================================================
+    /** The command-line ID that is used to launch workers, unless a different one is
+        supplied to the Options.
+    */
+    static constexpr const char* defaultCommandLineUID = "jucePluginScanWorker";
+
+    /** Settings for the scanner. */
+    class Options
+    {
+    public:
+        /** The maximum number of worker processes that may run at once.
+            The default is the number of CPUs.
+        */
+        [[nodiscard]] Options withMaximumNumberOfWorkers (int newMaximum) const
+        {
+            jassert (newMaximum > 0);
+            return withMember (*this, &Options::maximumNumberOfWorkers, jmax (1, newMaximum));
+        }
+
+        /** The time that a worker may spend scanning a single plugin before the plugin is
+            treated as having hung. The default is 60 seconds.
+        */
+        [[nodiscard]] Options withTimeoutMilliseconds (int newTimeoutMs) const
+        {
+            return withMember (*this, &Options::timeoutMs, newTimeoutMs);
+        }
+
+        /** The executable to launch as a worker. This defaults to the current executable. */
+        [[nodiscard]] Options withWorkerExecutable (const File& newExecutable) const
+        {
+            return withMember (*this, &Options::workerExecutable, newExecutable);
+        }
+
+        /** The ID that is passed to the worker on its command line. This must match the ID
+            that the worker passes to Worker::initialiseFromCommandLine(), and must be a short
+            alphanumeric string without spaces.
+        */
+        [[nodiscard]] Options withCommandLineUID (const String& newUID) const
+        {
+            return withMember (*this, &Options::commandLineUID, newUID);
+        }
+
+        int getMaximumNumberOfWorkers() const           { return maximumNumberOfWorkers; }
+        int getTimeoutMilliseconds() const              { return timeoutMs; }
+        const File& getWorkerExecutable() const         { return workerExecutable; }
+        const String& getCommandLineUID() const         { return commandLineUID; }
+
+    private:
+        int maximumNumberOfWorkers = SystemStats::getNumCpus();
+        int timeoutMs = 60000;
+        File workerExecutable = File::getSpecialLocation (File::currentExecutableFile);
+        String commandLineUID = defaultCommandLineUID;
+    };
+
+    //==============================================================================
+    /** Creates a scanner with the default Options. */
+    OutOfProcessPluginScanner();
+
+    /** Creates a scanner with some custom Options. */
+    explicit OutOfProcessPluginScanner (const Options& options);
+
+    /** Destructor. This will terminate any worker processes that are still running. */
+    ~OutOfProcessPluginScanner() override;
+
+    //==============================================================================
+    /** @internal */
+    bool findPluginTypesFor (AudioPluginFormat&, OwnedArray<PluginDescription>&, const String&) override;
+    /** @internal */
+    void scanFinished() override;
+
+    //==============================================================================
+    /**
+        The worker side of an OutOfProcessPluginScanner.
+
+        Create one of these when your app starts, and call initialiseFromCommandLine().
+        If that returns true, the process has been launched as a scan worker, and the
+        Worker must be kept alive until the process quits. The Worker will quit the
+        process when its connection to the scanner is lost.
+    */
+    class JUCE_API  Worker
+    {
+    public:
+        /** Creates a worker that can scan the default formats for this platform. */
+        Worker();
+
+        /** Destructor. */
+        ~Worker();
+
+        /** Returns the format manager that will be used to scan plugins. If your host uses
+            any custom formats, add them to this before calling initialiseFromCommandLine().
+        */
+        AudioPluginFormatManager& getFormatManager() noexcept;
+
+        /** Checks whether this process was launched as a scan worker, and if so, connects
+            to the scanner that launched it.
+
+            Returns true if this process is a worker.
+        */
+        bool initialiseFromCommandLine (const String& commandLine,
+                                        const String& commandLineUID = defaultCommandLineUID);
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> impl;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+    };
+
+private:
+    //==============================================================================
+    class WorkerProcess;
+
+    std::unique_ptr<WorkerProcess> acquireWorker();
+    void releaseWorker (std::unique_ptr<WorkerProcess>, bool canBeReused);
+
+    const Options options;
+
+    std::mutex mutex;
+    std::condition_variable workerReleased;
+    std::vector<std::unique_ptr<WorkerProcess>> idleWorkers;
+    int numWorkers = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OutOfProcessPluginScanner)
+};
+
+} // namespace juce
@@ -0,0 +1,877 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  The cache file layout is:
+
+    - a file header: magic number, format version, number of entries, reserved
+    - a table of entries, sorted by key hash: key hash, content hash, data offset, data size
+    - the data for each entry, which is the format name and identifier that the entry
+      belongs to, followed by the serialised PluginDescriptions
+
+    All values are little-endian. Each table entry is 8-byte aligned so that the table can
+    be binary-searched directly in the mapped file.
+*/
+namespace PluginScanCacheHelpers
+{
+    constexpr uint32 magicNumber   = 0x4350534a; // "JSPC"
+    constexpr uint32 formatVersion = 1;
+    constexpr size_t fileHeaderSize = 16;
+    constexpr size_t entrySize = 24;
+
+    struct Fnv1a
+    {
+        void add (const void* data, size_t numBytes) noexcept
+        {
+            for (auto* p = static_cast<const uint8*> (data); numBytes > 0; --numBytes)
+                hash = (hash ^ *p++) * 0x100000001b3ull;
+        }
+
+        void add (const String& s) noexcept
+        {
+            add (s.toRawUTF8(), s.getNumBytesAsUTF8() + 1);
+        }
+
+        void add (int64 value) noexcept
+        {
+            const auto le = ByteOrder::swapIfBigEndian ((uint64) value);
+            add (&le, sizeof (le));
+        }
+
+        uint64 hash = 0xcbf29ce484222325ull;
+    };
+
+    static uint64 getKeyHash (const String& formatName, const String& fileOrIdentifier) noexcept
+    {
+        Fnv1a h;
+        h.add (formatName);
+        h.add (fileOrIdentifier);
+        return h.hash;
+    }
+
+    static void writeDescription (OutputStream& out, const PluginDescription& d)
+    {
+        out.writeString (d.name);
+        out.writeString (d.descriptiveName);
+        out.writeString (d.pluginFormatName);
+        out.writeString (d.category);
+        out.writeString (d.manufacturerName);
+        out.writeString (d.version);
+        out.writeString (d.fileOrIdentifier);
+        out.writeInt64 (d.lastFileModTime.toMilliseconds());
+        out.writeInt64 (d.lastInfoUpdateTime.toMilliseconds());
+        out.writeInt (d.deprecatedUid);
+        out.writeInt (d.uniqueId);
+        out.writeInt (d.numInputChannels);
+        out.writeInt (d.numOutputChannels);
+        out.writeByte ((char) ((d.isInstrument ? 1 : 0) | (d.hasSharedContainer ? 2 : 0) | (d.hasARAExtension ? 4 : 0)));
+    }
+
+    /*  Reads values straight out of the mapped file, which is much quicker than going
+        through an InputStream. Reading past the end of the data sets the failed flag.
+    */
+    struct DataReader
+    {
+        DataReader (const void* d, size_t s) noexcept
+            : data (static_cast<const char*> (d)), size (s) {}
+
+        const char* take (size_t numBytes) noexcept
+        {
+            if (failed || size - pos < numBytes)
+            {
+                failed = true;
+                return nullptr;
+            }
+
+            auto* p = data + pos;
+            pos += numBytes;
+            return p;
+        }
+
+        String readString()
+        {
+            auto* start = data + pos;
+            auto* terminator = failed ? nullptr : static_cast<const char*> (std::memchr (start, 0, size - pos));
+
+            if (terminator == nullptr)
+            {
+                failed = true;
+                return {};
+            }
+
+            pos += (size_t) (terminator - start) + 1;
+            return String::fromUTF8 (start, (int) (terminator - start));
+        }
+
+        int readInt() noexcept          { auto* p = take (4); return p != nullptr ? (int) ByteOrder::littleEndianInt (p) : 0; }
+        int64 readInt64() noexcept      { auto* p = take (8); return p != nullptr ? (int64) ByteOrder::littleEndianInt64 (p) : 0; }
+        uint8 readByte() noexcept       { auto* p = take (1); return p != nullptr ? (uint8) *p : 0; }
+
+        const char* data;
+        size_t size, pos = 0;
+        bool failed = false;
+    };
+
+    static PluginDescription readDescription (DataReader& in)
+    {
+        PluginDescription d;
+        d.name               = in.readString();
+        d.descriptiveName    = in.readString();
+        d.pluginFormatName   = in.readString();
+        d.category           = in.readString();
+        d.manufacturerName   = in.readString();
+        d.version            = in.readString();
+        d.fileOrIdentifier   = in.readString();
+        d.lastFileModTime    = Time (in.readInt64());
+        d.lastInfoUpdateTime = Time (in.readInt64());
+        d.deprecatedUid      = in.readInt();
+        d.uniqueId           = in.readInt();
+        d.numInputChannels   = in.readInt();
+        d.numOutputChannels  = in.readInt();
+
+        const auto flags = in.readByte();
+        d.isInstrument       = (flags & 1) != 0;
+        d.hasSharedContainer = (flags & 2) != 0;
+        d.hasARAExtension    = (flags & 4) != 0;
+        return d;
+    }
+
+    static MemoryBlock createEntryData (const String& formatName,
+                                        const String& fileOrIdentifier,
+                                        const Array<PluginDescription>& types)
+    {
+        MemoryOutputStream out;
+        out.writeString (formatName);
+        out.writeString (fileOrIdentifier);
+        out.writeInt (types.size());
+
+        for (auto& d : types)
+            writeDescription (out, d);
+
+        return out.getMemoryBlock();
+    }
+
+    /*  Reads an entry's data, checking that it belongs to the expected plugin in case of
+        a key hash collision. If the names are null, the check is skipped.
+    */
+    static std::optional<Array<PluginDescription>> readEntryData (const void* data, size_t size,
+                                                                  const String* formatName,
+                                                                  const String* fileOrIdentifier)
+    {
+        DataReader in (data, size);
+
+        const auto storedFormatName = in.readString();
+        const auto storedIdentifier = in.readString();
+
+        if ((formatName != nullptr && storedFormatName != *formatName)
+             || (fileOrIdentifier != nullptr && storedIdentifier != *fileOrIdentifier))
+            return {};
+
+        const auto numTypes = in.readInt();
+
+        if (in.failed || numTypes < 0)
+            return {};
+
+        Array<PluginDescription> result;
+
+        for (int i = 0; i < numTypes && ! in.failed; ++i)
+            result.add (readDescription (in));
+
+        if (in.failed)
+            return {};
+
+        return result;
+    }
+}
+
+//==============================================================================
+struct PluginScanCache::EntryHeader
+{
+    uint64 getKeyHash() const noexcept      { return ByteOrder::littleEndianInt64 (bytes); }
+    uint64 getContentHash() const noexcept  { return ByteOrder::littleEndianInt64 (bytes + 8); }
+    uint32 getDataOffset() const noexcept   { return ByteOrder::littleEndianInt (bytes + 16); }
+    uint32 getDataSize() const noexcept     { return ByteOrder::littleEndianInt (bytes + 20); }
+
+    uint8 bytes[PluginScanCacheHelpers::entrySize];
+};
+
+struct PluginScanCache::PendingEntry
+{
+    uint64 contentHash = 0;
+    MemoryBlock data;
+    bool removed = false;
+};
+
+//==============================================================================
+PluginScanCache::PluginScanCache (const File& cacheFile)
+    : file (cacheFile)
+{
+    mapFile();
+}
+
+PluginScanCache::~PluginScanCache() = default;
+
+void PluginScanCache::mapFile()
+{
+    using namespace PluginScanCacheHelpers;
+    static_assert (sizeof (EntryHeader) == entrySize);
+
+    mappedEntries = nullptr;
+    numMappedEntries = 0;
+    mappedFile.reset();
+
+    if (! file.existsAsFile())
+        return;
+
+    auto mapped = std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readOnly);
+    auto* data = static_cast<const char*> (mapped->getData());
+    const auto size = mapped->getSize();
+
+    if (data == nullptr || size < fileHeaderSize
+         || ByteOrder::littleEndianInt (data) != magicNumber
+         || ByteOrder::littleEndianInt (data + 4) != formatVersion)
+        return;
+
+    const auto numEntries = ByteOrder::littleEndianInt (data + 8);
+
+    if (fileHeaderSize + (size_t) numEntries * entrySize > size)
+        return;
+
+    mappedFile = std::move (mapped);
+    mappedEntries = reinterpret_cast<const EntryHeader*> (data + fileHeaderSize);
+    numMappedEntries = numEntries;
+}
+
+const PluginScanCache::EntryHeader* PluginScanCache::findMappedEntry (uint64 keyHash) const
+{
+    if (pendingClear)
+        return nullptr;
+
+    const auto* end = mappedEntries + numMappedEntries;
+    const auto* e = std::lower_bound (mappedEntries, end, keyHash,
+                                      [] (const EntryHeader& entry, uint64 key) { return entry.getKeyHash() < key; });
+
+    if (e != end && e->getKeyHash() == keyHash)
+    {
+        if ((size_t) e->getDataOffset() + e->getDataSize() <= mappedFile->getSize())
+            return e;
+
+        jassertfalse; // the cache file seems to be damaged
+    }
+
+    return nullptr;
+}
+
+const PluginScanCache::PendingEntry* PluginScanCache::findPendingEntry (uint64 keyHash) const
+{
+    const auto iter = pendingEntries.find (keyHash);
+    return iter != pendingEntries.end() ? &iter->second : nullptr;
+}
+
+Array<PluginDescription> PluginScanCache::readMappedTypes (const EntryHeader& entry) const
+{
+    auto* data = static_cast<const char*> (mappedFile->getData()) + entry.getDataOffset();
+
+    if (auto types = PluginScanCacheHelpers::readEntryData (data, entry.getDataSize(), nullptr, nullptr))
+        return *types;
+
+    return {};
+}
+
+//==============================================================================
+std::optional<Array<PluginDescription>> PluginScanCache::findTypesFor (const String& formatName,
+                                                                       const String& fileOrIdentifier) const
+{
+    const auto keyHash = PluginScanCacheHelpers::getKeyHash (formatName, fileOrIdentifier);
+    const void* data = nullptr;
+    size_t size = 0;
+    uint64 contentHash = 0;
+
+    const ScopedLock sl (lock);
+
+    if (auto* pending = findPendingEntry (keyHash))
+    {
+        if (pending->removed)
+            return {};
+
+        data = pending->data.getData();
+        size = pending->data.getSize();
+        contentHash = pending->contentHash;
+    }
+    else if (auto* entry = findMappedEntry (keyHash))
+    {
+        data = static_cast<const char*> (mappedFile->getData()) + entry->getDataOffset();
+        size = entry->getDataSize();
+        contentHash = entry->getContentHash();
+    }
+    else
+    {
+        return {};
+    }
+
+    if (contentHash != calculateContentHash (fileOrIdentifier))
+        return {};
+
+    return PluginScanCacheHelpers::readEntryData (data, size, &formatName, &fileOrIdentifier);
+}
+
+bool PluginScanCache::isUpToDate (const String& formatName, const String& fileOrIdentifier) const
+{
+    return findTypesFor (formatName, fileOrIdentifier).has_value();
+}
+
+void PluginScanCache::storeTypesFor (const String& formatName,
+                                     const String& fileOrIdentifier,
+                                     const Array<PluginDescription>& typesFound)
+{
+    PendingEntry entry;
+    entry.contentHash = calculateContentHash (fileOrIdentifier);
+    entry.data = PluginScanCacheHelpers::createEntryData (formatName, fileOrIdentifier, typesFound);
+
+    const ScopedLock sl (lock);
+    pendingEntries[PluginScanCacheHelpers::getKeyHash (formatName, fileOrIdentifier)] = std::move (entry);
+}
+
+void PluginScanCache::removeTypesFor (const String& formatName, const String& fileOrIdentifier)
+{
+    PendingEntry entry;
+    entry.removed = true;
+
+    const ScopedLock sl (lock);
+    pendingEntries[PluginScanCacheHelpers::getKeyHash (formatName, fileOrIdentifier)] = std::move (entry);
+}
+
+void PluginScanCache::clear()
+{
+    const ScopedLock sl (lock);
+    pendingEntries.clear();
+    pendingClear = true;
+}
+
+//==============================================================================
+int PluginScanCache::getNumEntries() const
+{
+    const ScopedLock sl (lock);
+
+    auto num = pendingClear ? 0 : (int) numMappedEntries;
+
+    for (auto& [keyHash, pending] : pendingEntries)
+    {
+        const auto isMapped = findMappedEntry (keyHash) != nullptr;
+
+        if (pending.removed)
+            num -= isMapped ? 1 : 0;
+        else
+            num += isMapped ? 0 : 1;
+    }
+
+    return num;
+}
+
+Array<PluginDescription> PluginScanCache::getAllTypes() const
+{
+    Array<PluginDescription> result;
+
+    const ScopedLock sl (lock);
+
+    if (! pendingClear)
+    {
+        result.ensureStorageAllocated ((int) numMappedEntries);
+
+        for (uint32 i = 0; i < numMappedEntries; ++i)
+        {
+            const auto& entry = mappedEntries[i];
+
+            if (findPendingEntry (entry.getKeyHash()) == nullptr && findMappedEntry (entry.getKeyHash()) != nullptr)
+                result.addArray (readMappedTypes (entry));
+        }
+    }
+
+    for (auto& [keyHash, pending] : pendingEntries)
+        if (! pending.removed)
+            if (auto types = PluginScanCacheHelpers::readEntryData (pending.data.getData(), pending.data.getSize(), nullptr, nullptr))
+                result.addArray (*types);
+
+    return result;
+}
+
+bool PluginScanCache::hasUnsavedChanges() const
+{
+    const ScopedLock sl (lock);
+    return pendingClear || ! pendingEntries.empty();
+}
+
+Result PluginScanCache::save()
+{
+    using namespace PluginScanCacheHelpers;
+
+    const ScopedLock sl (lock);
+
+    if (! hasUnsavedChanges() && file.existsAsFile())
+        return Result::ok();
+
+    struct OutputEntry
+    {
+        uint64 keyHash, contentHash;
+        const void* data;
+        size_t size;
+    };
+
+    std::vector<OutputEntry> entries;
+    entries.reserve (numMappedEntries + pendingEntries.size());
+
+    // Both the mapped table and the pending entries are sorted, so they can be merged in order
+    auto pending = pendingEntries.cbegin();
+    const auto numMapped = pendingClear ? 0 : numMappedEntries;
+
+    const auto addPending = [&entries] (uint64 keyHash, const PendingEntry& p)
+    {
+        if (! p.removed)
+            entries.push_back ({ keyHash, p.contentHash, p.data.getData(), p.data.getSize() });
+    };
+
+    for (uint32 i = 0; i < numMapped; ++i)
+    {
+        const auto& entry = mappedEntries[i];
+
+        for (; pending != pendingEntries.cend() && pending->first < entry.getKeyHash(); ++pending)
+            addPending (pending->first, pending->second);
+
+        if (pending != pendingEntries.cend() && pending->first == entry.getKeyHash())
+        {
+            addPending (pending->first, pending->second);
+            ++pending;
+        }
+        else if (findMappedEntry (entry.getKeyHash()) != nullptr)
+        {
+            entries.push_back ({ entry.getKeyHash(), entry.getContentHash(),
+                                 static_cast<const char*> (mappedFile->getData()) + entry.getDataOffset(),
+                                 entry.getDataSize() });
+        }
+    }
+
+    for (; pending != pendingEntries.cend(); ++pending)
+        addPending (pending->first, pending->second);
+
+    TemporaryFile tempFile (file);
+
+    {
+        FileOutputStream out (tempFile.getFile());
+
+        if (! out.openedOk())
+            return Result::fail ("Couldn't write to " + tempFile.getFile().getFullPathName());
+
+        out.writeInt ((int) magicNumber);
+        out.writeInt ((int) formatVersion);
+        out.writeInt ((int) entries.size());
+        out.writeInt (0);
+
+        auto dataOffset = (uint64) (fileHeaderSize + entries.size() * entrySize);
+
+        for (auto& e : entries)
+        {
+            if (dataOffset + e.size > std::numeric_limits<uint32>::max())
+                return Result::fail ("The plugin scan cache is too large");
+
+            out.writeInt64 ((int64) e.keyHash);
+            out.writeInt64 ((int64) e.contentHash);
+            out.writeInt ((int) dataOffset);
+            out.writeInt ((int) e.size);
+            dataOffset += e.size;
+        }
+
+        for (auto& e : entries)
+            out.write (e.data, e.size);
+
+        out.flush();
+
+        if (out.getStatus().failed())
+            return out.getStatus();
+    }
+
+    // The entries point into the mapped file, so it can only be released once they've been written
+    entries.clear();
+    mappedEntries = nullptr;
+    numMappedEntries = 0;
+    mappedFile.reset();
+
+    if (! tempFile.overwriteTargetFileWithTemporary())
+    {
+        mapFile();
+        return Result::fail ("Couldn't replace " + file.getFullPathName());
+    }
+
+    pendingEntries.clear();
+    pendingClear = false;
+    mapFile();
+
+    return Result::ok();
+}
+
+//==============================================================================
+uint64 PluginScanCache::calculateContentHash (const String& fileOrIdentifier)
+{
+    PluginScanCacheHelpers::Fnv1a h;
+    h.add (fileOrIdentifier);
+
+    if (! File::isAbsolutePath (fileOrIdentifier))
+        return h.hash;
+
+    const File f (fileOrIdentifier);
+
+    if (f.isDirectory())
+    {
+        struct Item
+        {
+            String path;
+            int64 size, modTime;
+        };
+
+        std::vector<Item> items;
+
+        for (const auto& entry : RangedDirectoryIterator (f, true, "*", File::findFiles))
+            items.push_back ({ entry.getFile().getRelativePathFrom (f),
+                               entry.getFileSize(),
+                               entry.getModificationTime().toMilliseconds() });
+
+        // The order of directory iteration isn't defined, so sort to get a stable hash
+        std::sort (items.begin(), items.end(), [] (const Item& a, const Item& b) { return a.path < b.path; });
+
+        for (auto& item : items)
+        {
+            h.add (item.path);
+            h.add (item.size);
+            h.add (item.modTime);
+        }
+    }
+    else if (f.existsAsFile())
+    {
+        h.add (f.getSize());
+        h.add (f.getLastModificationTime().toMilliseconds());
+    }
+
+    return h.hash;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PluginScanCacheTests  : public UnitTest
+{
+public:
+    PluginScanCacheTests()
+        : UnitTest ("PluginScanCache", UnitTestCategories::audioProcessors) {}
+
+    void runTest() override
+    {
+        const auto folder = File::getSpecialLocation (File::tempDirectory).getNonexistentChildFile ("PluginScanCacheTests", {}, false);
+        folder.createDirectory();
+        const ScopeGuard deleteFolder { [&] { folder.deleteRecursively(); } };
+
+        const auto cacheFile = folder.getChildFile ("cache.bin");
+
+        beginTest ("Stored types can be found after the cache has been saved and reopened");
+        {
+            const auto bundle = createBundle (folder, "A");
+            const auto types = createTypes (bundle.getFullPathName(), 3);
+
+            {
+                PluginScanCache cache (cacheFile);
+                expect (! cache.findTypesFor ("Fake", bundle.getFullPathName()).has_value());
+
+                cache.storeTypesFor ("Fake", bundle.getFullPathName(), types);
+                expect (cache.hasUnsavedChanges());
+                expect (matches (cache.findTypesFor ("Fake", bundle.getFullPathName()), types));
+                expect (! cache.findTypesFor ("Other", bundle.getFullPathName()).has_value());
+
+                expect (cache.save().wasOk());
+                expect (! cache.hasUnsavedChanges());
+                expect (matches (cache.findTypesFor ("Fake", bundle.getFullPathName()), types));
+            }
+
+            PluginScanCache reopened (cacheFile);
+            expectEquals (reopened.getNumEntries(), 1);
+            expect (matches (reopened.findTypesFor ("Fake", bundle.getFullPathName()), types));
+            expect (matches (reopened.getAllTypes(), types));
+        }
+
+        beginTest ("Changing a bundle only invalidates its own entry");
+        {
+            cacheFile.deleteFile();
+
+            const auto bundleA = createBundle (folder, "A");
+            const auto bundleB = createBundle (folder, "B");
+
+            {
+                PluginScanCache cache (cacheFile);
+                cache.storeTypesFor ("Fake", bundleA.getFullPathName(), createTypes (bundleA.getFullPathName(), 1));
+                cache.storeTypesFor ("Fake", bundleB.getFullPathName(), createTypes (bundleB.getFullPathName(), 1));
+                expect (cache.save().wasOk());
+            }
+
+            bundleB.getChildFile ("Contents").getChildFile ("binary").appendText ("changed");
+
+            PluginScanCache cache (cacheFile);
+            expectEquals (cache.getNumEntries(), 2);
+            expect (cache.isUpToDate ("Fake", bundleA.getFullPathName()));
+            expect (! cache.isUpToDate ("Fake", bundleB.getFullPathName()));
+
+            cache.storeTypesFor ("Fake", bundleB.getFullPathName(), createTypes (bundleB.getFullPathName(), 2));
+            expect (cache.isUpToDate ("Fake", bundleB.getFullPathName()));
+            expectEquals (cache.getAllTypes().size(), 3);
+        }
+
+        beginTest ("Removed entries are removed from the file");
+        {
+            PluginScanCache cache (cacheFile);
+            cache.removeTypesFor ("Fake", folder.getChildFile ("A").getFullPathName());
+            expectEquals (cache.getNumEntries(), 1);
+            expect (cache.save().wasOk());
+
+            expectEquals (PluginScanCache (cacheFile).getNumEntries(), 1);
+
+            cache.clear();
+            expectEquals (cache.getNumEntries(), 0);
+            expect (cache.save().wasOk());
+
+            expectEquals (PluginScanCache (cacheFile).getNumEntries(), 0);
+        }
+
+        beginTest ("Scanning uses the cache instead of loading unchanged plugins");
+        {
+            cacheFile.deleteFile();
+
+            const auto bundleA = createBundle (folder, "A");
+            const auto bundleB = createBundle (folder, "B");
+            FakeFormat format;
+
+            KnownPluginList list;
+            auto* scanner = new CountingScanner();
+            list.setCustomScanner (std::unique_ptr<CountingScanner> (scanner));
+            list.setScanCache (std::make_unique<PluginScanCache> (cacheFile));
+
+            for (auto& bundle : { bundleA, bundleB })
+            {
+                OwnedArray<PluginDescription> found;
+
+                if (! list.isListingUpToDate (bundle.getFullPathName(), format))
+                    list.scanAndAddFile (bundle.getFullPathName(), true, found, format);
+            }
+
+            list.scanFinished();
+
+            expectEquals (scanner->numScans, 2);
+            expectEquals (list.getNumTypes(), 2);
+            expect (cacheFile.existsAsFile());
+
+            // A new list, as it would be on a cold start
+            KnownPluginList newList;
+            auto* newScanner = new CountingScanner();
+            newList.setCustomScanner (std::unique_ptr<CountingScanner> (newScanner));
+            newList.setScanCache (std::make_unique<PluginScanCache> (cacheFile));
+
+            bundleB.getChildFile ("Contents").getChildFile ("binary").appendText ("changed");
+
+            for (auto& bundle : { bundleA, bundleB })
+            {
+                OwnedArray<PluginDescription> found;
+                expect (newList.scanAndAddFile (bundle.getFullPathName(), true, found, format));
+                expectEquals (found.size(), 1);
+            }
+
+            expectEquals (newScanner->numScans, 1);
+            expectEquals (newList.getNumTypes(), 2);
+        }
+
+        beginTest ("Plugins whose identifiers aren't files are rescanned when the format says they've changed");
+        {
+            cacheFile.deleteFile();
+
+            const String identifier ("fake:plugin");
+            FakeFormat format;
+
+            KnownPluginList list;
+            auto* scanner = new CountingScanner();
+            list.setCustomScanner (std::unique_ptr<CountingScanner> (scanner));
+            list.setScanCache (std::make_unique<PluginScanCache> (cacheFile));
+
+            OwnedArray<PluginDescription> found;
+            expect (list.scanAndAddFile (identifier, true, found, format));
+            expect (list.isListingUpToDate (identifier, format));
+
+            found.clear();
+            list.scanAndAddFile (identifier, true, found, format);
+            expectEquals (scanner->numScans, 1);
+
+            format.needsRescanning = true;
+            expect (! list.isListingUpToDate (identifier, format));
+
+            found.clear();
+            list.scanAndAddFile (identifier, true, found, format);
+            expectEquals (scanner->numScans, 2);
+            expectEquals (found.size(), 1);
+        }
+
+        beginTest ("A large list can be restored quickly");
+        {
+            cacheFile.deleteFile();
+
+            constexpr int numPlugins = 5000;
+            Array<PluginDescription> allTypes;
+
+            {
+                PluginScanCache cache (cacheFile);
+
+                for (int i = 0; i < numPlugins; ++i)
+                {
+                    const auto types = createTypes ("Plugin" + String (i), 1);
+                    cache.storeTypesFor ("Fake", types.getFirst().fileOrIdentifier, types);
+                    allTypes.addArray (types);
+                }
+
+                expect (cache.save().wasOk());
+            }
+
+            const auto cacheStart = Time::getMillisecondCounterHiRes();
+
+            KnownPluginList fromCache;
+            fromCache.setScanCache (std::make_unique<PluginScanCache> (cacheFile));
+            fromCache.addTypes (fromCache.getScanCache()->getAllTypes());
+
+            const auto cacheTime = Time::getMillisecondCounterHiRes() - cacheStart;
+            expectEquals (fromCache.getNumTypes(), numPlugins);
+
+            KnownPluginList original;
+            original.addTypes (allTypes);
+            const auto xmlText = original.createXml()->toString();
+
+            const auto xmlStart = Time::getMillisecondCounterHiRes();
+
+            KnownPluginList fromXml;
+            fromXml.recreateFromXml (*parseXML (xmlText));
+
+            const auto xmlTime = Time::getMillisecondCounterHiRes() - xmlStart;
+            expectEquals (fromXml.getNumTypes(), numPlugins);
+
+            logMessage ("Restoring " + String (numPlugins) + " types took " + String (cacheTime, 2) + " ms from the cache, "
+                          + String (xmlTime, 2) + " ms from XML");
+        }
+    }
+
+private:
+    struct FakeFormat  : public AudioPluginFormat
+    {
+        String getName() const override                                                  { return "Fake"; }
+        void findAllTypesForFile (OwnedArray<PluginDescription>&, const String&) override {}
+        bool fileMightContainThisPluginType (const String&) override                     { return true; }
+        String getNameOfPluginFromIdentifier (const String& id) override                 { return id; }
+        bool pluginNeedsRescanning (const PluginDescription&) override                   { return needsRescanning; }
+        bool doesPluginStillExist (const PluginDescription&) override                    { return true; }
+        bool canScanForPlugins() const override                                          { return true; }
+        bool isTrivialToScan() const override                                            { return true; }
+        StringArray searchPathsForPlugins (const FileSearchPath&, bool, bool) override   { return {}; }
+        FileSearchPath getDefaultLocationsToSearch() override                            { return {}; }
+        bool requiresUnblockedMessageThreadDuringCreation (const PluginDescription&) const override { return false; }
+
+        void createPluginInstance (const PluginDescription&, double, int, PluginCreationCallback callback) override
+        {
+            callback (nullptr, "Not supported");
+        }
+
+        bool needsRescanning = false;
+    };
+
+    struct CountingScanner  : public KnownPluginList::CustomScanner
+    {
+        bool findPluginTypesFor (AudioPluginFormat&, OwnedArray<PluginDescription>& result, const String& fileOrIdentifier) override
+        {
+            ++numScans;
+
+            for (auto& d : createTypes (fileOrIdentifier, 1))
+                result.add (new PluginDescription (d));
+
+            return true;
+        }
+
+        int numScans = 0;
+    };
+
+    static File createBundle (const File& parent, const String& name)
+    {
+        const auto bundle = parent.getChildFile (name);
+        bundle.getChildFile ("Contents").createDirectory();
+        bundle.getChildFile ("Contents").getChildFile ("binary").replaceWithText ("binary " + name);
+        bundle.getChildFile ("Contents").getChildFile ("Info.plist").replaceWithText ("info " + name);
+        return bundle;
+    }
+
+    static Array<PluginDescription> createTypes (const String& fileOrIdentifier, int num)
+    {
+        Array<PluginDescription> result;
+
+        for (int i = 0; i < num; ++i)
+        {
+            PluginDescription d;
+            d.name = "Plugin " + String (i);
+            d.descriptiveName = "A plugin";
+            d.pluginFormatName = "Fake";
+            d.category = "Effect";
+            d.manufacturerName = "Manufacturer";
+            d.version = "1.0." + String (i);
+            d.fileOrIdentifier = fileOrIdentifier;
+            d.lastFileModTime = Time (1700000000000 + i);
+            d.lastInfoUpdateTime = Time (1700000001000 + i);
+            d.uniqueId = d.deprecatedUid = fileOrIdentifier.hashCode() + i;
+            d.numInputChannels = 2;
+            d.numOutputChannels = i + 1;
+            d.isInstrument = (i % 2) != 0;
+            d.hasSharedContainer = true;
+            result.add (d);
+        }
+
+        return result;
+    }
+
+    static bool matches (const std::optional<Array<PluginDescription>>& a, const Array<PluginDescription>& b)
+    {
+        if (! a.has_value() || a->size() != b.size())
+            return false;
+
+        for (int i = 0; i < b.size(); ++i)
+            if (! a->getReference (i).createXml()->isEquivalentTo (b.getReference (i).createXml().get(), false))
+                return false;
+
+        return true;
+    }
+};
+
+static PluginScanCacheTests pluginScanCacheTests;
+
+#endif
+
+} // namespace juce
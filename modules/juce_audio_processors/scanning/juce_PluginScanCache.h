@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A persistent, binary cache of plugin scan results.
+
+    Each entry holds the PluginDescriptions that a scan found for a single plugin file
+    or identifier, along with a hash of the plugin's bundle contents that was taken at
+    the time of the scan. When the plugin is scanned again, the cached descriptions are
+    only used if the bundle still has the same hash, so unchanged plugins don't need to
+    be loaded again, and changed plugins are invalidated individually.
+
+    The cache file is memory-mapped and its entries are sorted by key, so opening a cache
+    and looking up an entry doesn't require the whole file to be parsed. This makes it much
+    quicker to restore a large list than going through KnownPluginList::recreateFromXml().
+
+    To use it, give a cache to a KnownPluginList with KnownPluginList::setScanCache().
+    KnownPluginList::scanAndAddFile() will then consult the cache before loading a plugin,
+    record the results of each scan, and save the cache when the scan has finished.
+
+    @code
+    knownPluginList.setScanCache (std::make_unique<PluginScanCache> (appDataFolder.getChildFile ("PluginScanCache.bin")));
+
+    // On startup, the known types can be restored straight from the cache:
+    knownPluginList.addTypes (knownPluginList.getScanCache()->getAllTypes());
+    @endcode
+
+    @see KnownPluginList
+
+    @tags{Audio}
+*/
+class JUCE_API  PluginScanCache
+{
+public:
+    //==============================================================================
+    /** Opens a cache that is stored in the given file. If the file doesn't exist, or isn't
+        a valid cache, the cache will start off empty and the file will be created the
+        next time save() is called.
+    */
+    explicit PluginScanCache (const File& cacheFile);
+
+    /** Destructor. This doesn't save any unsaved changes. */
+    ~PluginScanCache();
+
+    /** Returns the file that this cache is stored in. */
+    const File& getFile() const noexcept        { return file; }
+
+    //==============================================================================
+    /** Looks for the results of an earlier scan of a plugin.
+
+        If the cache has an entry for this plugin, and the plugin's bundle hasn't changed
+        since the entry was stored, this returns the types that were found. The array may
+        be empty if the plugin was scanned and found to contain no types. If there's no
+        entry, or the entry is out of date, this returns nullopt.
+    */
+    std::optional<Array<PluginDescription>> findTypesFor (const String& formatName,
+                                                          const String& fileOrIdentifier) const;
+
+    /** Returns true if the cache has an entry for this plugin which matches the current
+        state of its bundle.
+    */
+    bool isUpToDate (const String& formatName, const String& fileOrIdentifier) const;
+
+    /** Stores the results of scanning a plugin, along with the current hash of its bundle.
+        Any previous entry for the plugin is replaced.
+    */
+    void storeTypesFor (const String& formatName,
+                        const String& fileOrIdentifier,
+                        const Array<PluginDescription>& typesFound);
+
+    /** Removes the entry for a plugin, if there is one. */
+    void removeTypesFor (const String& formatName, const String& fileOrIdentifier);
+
+    /** Removes all entries. */
+    void clear();
+
+    //==============================================================================
+    /** Returns the number of plugins that have entries in the cache. */
+    int getNumEntries() const;
+
+    /** Returns all of the types stored in the cache.
+
+        This doesn't check whether the entries are up to date, so it's cheap enough to call
+        on startup to restore a KnownPluginList. Any stale entries will be picked up by the
+        next scan.
+    */
+    Array<PluginDescription> getAllTypes() const;
+
+    /** Returns true if there are changes that haven't been saved yet. */
+    bool hasUnsavedChanges() const;
+
+    /** Writes any changes to the cache file.
+        The file is replaced atomically, so a crash while saving won't corrupt the cache.
+    */
+    Result save();
+
+    //==============================================================================
+    /** Calculates the hash that's used to decide whether a plugin has changed.
+
+        For a plugin file, or a bundle directory, this combines the relative path, size and
+        modification time of each file that it contains. Bundles are walked recursively
+        every time this is called, so findTypesFor() and isUpToDate() cost one directory
+        listing per plugin. That's fine for an occasional scan, but not for calling in a
+        tight loop.
+
+        For identifiers that aren't files, such as AudioUnit or LV2 identifiers, only the
+        identifier itself is hashed, so the cache can't tell when those plugins have
+        changed. KnownPluginList deals with this by also asking the format's
+        AudioPluginFormat::pluginNeedsRescanning() about each cached type.
+    */
+    static uint64 calculateContentHash (const String& fileOrIdentifier);
+
+private:
+    //==============================================================================
+    struct EntryHeader;
+    struct PendingEntry;
+
+    const EntryHeader* findMappedEntry (uint64 keyHash) const;
+    const PendingEntry* findPendingEntry (uint64 keyHash) const;
+    Array<PluginDescription> readMappedTypes (const EntryHeader&) const;
+    void mapFile();
+
+    File file;
+    std::unique_ptr<MemoryMappedFile> mappedFile;
+    const EntryHeader* mappedEntries = nullptr;
+    uint32 numMappedEntries = 0;
+    std::map<uint64, PendingEntry> pendingEntries;
+    bool pendingClear = false;
+    CriticalSection lock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginScanCache)
+};
+
+} // namespace juce
@@ -59,6 +59,90 @@ void AudioProcessorValueTreeState::Parameter::valueChanged (float newValue)
     NullCheckedInvocation::invoke (onValueChanged);
 }
 
+//==============================================================================
+/*  Records which parameters have changed since their values were last written to the
+    ValueTree, so that a flush only visits the parameters that actually changed, and an idle
+    flush costs a single atomic exchange.
+
+    Parameters may be marked as changed from any thread. Adding parameters and visiting the
+    changed ones must only happen on the message thread.
+*/
+class AudioProcessorValueTreeState::DirtyParameterSet
+{
+public:
+    /*  Marks a single parameter as changed. A default-constructed Flag does nothing. */
+    class Flag
+    {
+    public:
+        Flag() = default;
+
+        Flag (DirtyParameterSet& ownerIn, size_t index)
+            : owner (&ownerIn),
+              word (&ownerIn.words[index / bitsPerWord]),
+              mask ((uint32) 1 << (index % bitsPerWord))
+        {
+        }
+
+        void mark() const noexcept
+        {
+            if (owner == nullptr)
+                return;
+
+            word->fetch_or (mask, std::memory_order_release);
+            owner->anyDirty.store (true, std::memory_order_release);
+        }
+
+    private:
+        DirtyParameterSet* owner = nullptr;
+        std::atomic<uint32>* word = nullptr;
+        uint32 mask = 0;
+    };
+
+    Flag add (ParameterAdapter& adapter)
+    {
+        const auto index = adapters.size();
+        adapters.push_back (&adapter);
+
+        // A deque never moves its elements when it grows, so existing Flags stay valid
+        if (index % bitsPerWord == 0)
+            words.emplace_back (0u);
+
+        return { *this, index };
+    }
+
+    /*  Calls the callback for each parameter that has been marked since the last call, and
+        returns true if there were any.
+    */
+    template <typename Callback>
+    bool forEachDirty (Callback&& callback)
+    {
+        if (! anyDirty.exchange (false, std::memory_order_acq_rel))
+            return false;
+
+        size_t firstIndex = 0;
+
+        for (auto& word : words)
+        {
+            if (word.load (std::memory_order_relaxed) != 0)
+            {
+                for (auto bits = word.exchange (0, std::memory_order_acq_rel); bits != 0; bits &= bits - 1)
+                    callback (*adapters[firstIndex + (size_t) findHighestSetBit (bits & (~bits + 1))]);
+            }
+
+            firstIndex += bitsPerWord;
+        }
+
+        return true;
+    }
+
+private:
+    static constexpr size_t bitsPerWord = 32;
+
+    std::vector<ParameterAdapter*> adapters;
+    std::deque<std::atomic<uint32>> words;
+    std::atomic<bool> anyDirty { false };
+};
+
 //==============================================================================
 class AudioProcessorValueTreeState::ParameterAdapter final : private AudioProcessorParameter::Listener
 {
@@ -108,13 +192,17 @@ public:
     float getDenormalisedValue() const                { return unnormalisedValue; }
     std::atomic<float>& getRawDenormalisedValue()     { return unnormalisedValue; }
 
-    bool flushToTree (const Identifier& key, UndoManager* um)
+    /*  Must be called before any other thread can change the parameter.
+        The parameter is initially marked as changed, so that its value gets written to the tree.
+    */
+    void setDirtyFlag (DirtyParameterSet::Flag newFlag)
     {
-        auto needsUpdateTestValue = true;
-
-        if (! needsUpdate.compare_exchange_strong (needsUpdateTestValue, false))
-            return false;
+        dirtyFlag = newFlag;
+        dirtyFlag.mark();
+    }
 
+    void flushToTree (const Identifier& key, UndoManager* um)
+    {
         if (auto* valueProperty = tree.getPropertyPointer (key))
         {
             if (! approximatelyEqual ((float) *valueProperty, unnormalisedValue.load()))
@@ -127,8 +215,6 @@ public:
         {
             tree.setProperty (key, unnormalisedValue.load(), nullptr);
         }
-
-        return true;
     }
 
     ValueTree tree;
@@ -146,7 +232,7 @@ private:
         unnormalisedValue = newValue;
         listeners.call ([this] (Listener& l) { l.parameterChanged (parameter.paramID, unnormalisedValue); });
         listenersNeedCalling = false;
-        needsUpdate = true;
+        dirtyFlag.mark();
     }
 
     float denormalise (float normalised) const
@@ -197,7 +283,8 @@ private:
     RangedAudioParameter& parameter;
     LockedListeners listeners;
     std::atomic<float> unnormalisedValue { 0.0f };
-    std::atomic<bool> needsUpdate { true }, listenersNeedCalling { true };
+    std::atomic<bool> listenersNeedCalling { true };
+    DirtyParameterSet::Flag dirtyFlag;
     bool ignoreParameterChangedCallbacks { false };
 };
 
@@ -260,7 +347,7 @@ AudioProcessorValueTreeState::AudioProcessorValueTreeState (AudioProcessor& proc
 }
 
 AudioProcessorValueTreeState::AudioProcessorValueTreeState (AudioProcessor& p, UndoManager* um)
-    : processor (p), undoManager (um)
+    : processor (p), undoManager (um), dirtyParameters (std::make_unique<DirtyParameterSet>())
 {
     startTimerHz (10);
     state.addListener (this);
@@ -323,7 +410,9 @@ RangedAudioParameter* AudioProcessorValueTreeState::createAndAddParameter (std::
 //==============================================================================
 void AudioProcessorValueTreeState::addParameterAdapter (RangedAudioParameter& param)
 {
-    adapterTable.emplace (param.paramID, std::make_unique<ParameterAdapter> (param));
+    auto adapter = std::make_unique<ParameterAdapter> (param);
+    adapter->setDirtyFlag (dirtyParameters->add (*adapter));
+    adapterTable.emplace (param.paramID, std::move (adapter));
 }
 
 AudioProcessorValueTreeState::ParameterAdapter* AudioProcessorValueTreeState::getParameterAdapter (StringRef paramID) const
@@ -452,12 +541,10 @@ bool AudioProcessorValueTreeState::flushParameterValuesToValueTree()
 {
     ScopedLock lock (valueTreeChanging);
 
-    bool anyUpdated = false;
-
-    for (auto& p : adapterTable)
-        anyUpdated |= p.second->flushToTree (valuePropertyID, undoManager);
-
-    return anyUpdated;
+    return dirtyParameters->forEachDirty ([this] (ParameterAdapter& adapter)
+    {
+        adapter.flushToTree (valuePropertyID, undoManager);
+    });
 }
 
 void AudioProcessorValueTreeState::timerCallback()
@@ -649,6 +736,38 @@ private:
         float value{};
     };
 
+    struct PropertyChangeCounter final : public ValueTree::Listener
+    {
+        explicit PropertyChangeCounter (ValueTree treeIn)
+            : tree (treeIn)
+        {
+            tree.addListener (this);
+        }
+
+        ~PropertyChangeCounter() override
+        {
+            tree.removeListener (this);
+        }
+
+        void valueTreePropertyChanged (ValueTree&, const Identifier&) override
+        {
+            ++numChanges;
+        }
+
+        ValueTree tree;
+        int numChanges = 0;
+    };
+
+    static ParameterLayout createLayoutWithFloatParameters (int numParameters)
+    {
+        ParameterLayout layout;
+
+        for (auto i = 0; i < numParameters; ++i)
+            layout.add (std::make_unique<AudioParameterFloat> (ParameterID { "p" + String (i), 1 }, "", NormalisableRange<float>{}, 0.0f));
+
+        return layout;
+    }
+
 public:
     AudioProcessorValueTreeStateTests()
         : UnitTest ("Audio Processor Value Tree State", UnitTestCategories::audioProcessorParameters)
@@ -977,6 +1096,65 @@ public:
             expectEquals (listener.value, newValue);
             expectEquals (listener.id, String (key));
         }
+
+        beginTest ("Only changed parameters are written to the state");
+        {
+            constexpr auto numParameters = 10000;
+            TestAudioProcessor proc (createLayoutWithFloatParameters (numParameters));
+
+            expect (! proc.state.flushParameterValuesToValueTree());
+
+            PropertyChangeCounter counter { proc.state.state };
+
+            for (const auto index : { 0, 31, 32, 5000, numParameters - 1 })
+                proc.getParameters()[index]->setValueNotifyingHost (0.5f);
+
+            expect (proc.state.flushParameterValuesToValueTree());
+            expectEquals (counter.numChanges, 5);
+
+            for (const auto index : { 0, 31, 32, 5000, numParameters - 1 })
+                expectEquals ((float) proc.state.state.getChildWithProperty ("id", "p" + String (index)).getProperty ("value"), 0.5f);
+
+            expect (! proc.state.flushParameterValuesToValueTree());
+            expectEquals (counter.numChanges, 5);
+        }
+
+        beginTest ("Flushing cost when idle and when busy");
+        {
+            constexpr auto numParameters = 10000;
+            TestAudioProcessor proc (createLayoutWithFloatParameters (numParameters));
+            const auto& parameters = proc.getParameters();
+
+            constexpr auto numIdleFlushes = 1000;
+            const auto idleStart = Time::getHighResolutionTicks();
+
+            for (auto i = 0; i < numIdleFlushes; ++i)
+                proc.state.flushParameterValuesToValueTree();
+
+            const auto idleSeconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - idleStart) / numIdleFlushes;
+
+            constexpr auto numBusyFlushes = 10;
+            double busySeconds = 0.0;
+
+            for (auto i = 0; i < numBusyFlushes; ++i)
+            {
+                for (auto* parameter : parameters)
+                    parameter->setValueNotifyingHost ((float) (i % 2));
+
+                const auto busyStart = Time::getHighResolutionTicks();
+                expect (proc.state.flushParameterValuesToValueTree());
+                busySeconds += Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - busyStart);
+            }
+
+            expect (std::all_of (proc.state.state.begin(), proc.state.state.end(), [] (const auto& child)
+            {
+                return exactlyEqual ((float) child.getProperty ("value"), 1.0f);
+            }));
+
+            logMessage ("Flushing " + String (numParameters) + " parameters: "
+                        + String (idleSeconds * 1.0e6, 3) + " us when idle, "
+                        + String (busySeconds * 1.0e3 / numBusyFlushes, 3) + " ms when all have changed");
+        }
     }
     JUCE_END_IGNORE_WARNINGS_MSVC
 };
@@ -413,6 +413,7 @@ public:
 private:
     //==============================================================================
     class ParameterAdapter;
+    class DirtyParameterSet;
 
 public:
     //==============================================================================
@@ -629,6 +630,7 @@ private:
     //==============================================================================
    #if JUCE_UNIT_TESTS
     friend struct ParameterAdapterTests;
+    friend class AudioProcessorValueTreeStateTests;
    #endif
 
     void addParameterAdapter (RangedAudioParameter&);
@@ -650,6 +652,7 @@ private:
         bool operator() (StringRef a, StringRef b) const noexcept { return a.text.compare (b.text) < 0; }
     };
 
+    std::unique_ptr<DirtyParameterSet> dirtyParameters;
     std::map<StringRef, std::unique_ptr<ParameterAdapter>, StringRefLessThan> adapterTable;
 
     CriticalSection valueTreeChanging;
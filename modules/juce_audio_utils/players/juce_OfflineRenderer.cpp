@@ -0,0 +1,599 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  Writes rendered blocks to an AudioFormatWriter on a background thread.
+
+    A fixed pool of blocks is allocated up-front. The rendering thread takes a free block,
+    renders into it and submits it, and the writer thread returns each block to the pool once
+    it has been written. If the writer falls behind, the rendering thread waits for a block to
+    become free.
+*/
+class OfflineRenderer::BlockWriter final : private Thread
+{
+public:
+    BlockWriter (AudioFormatWriter& w, int numChannels, int numWriterChannelsIn, int blockSize, int numBlocks)
+        : Thread ("Offline Render Writer"),
+          writer (w),
+          numWriterChannels (numWriterChannelsIn)
+    {
+        for (auto i = 0; i < numBlocks; ++i)
+            blocks.emplace_back (numChannels, blockSize);
+
+        for (auto& block : blocks)
+            freeBlocks.push_back (&block);
+
+        startThread();
+    }
+
+    ~BlockWriter() override
+    {
+        finish();
+    }
+
+    /*  Returns a block to render into, waiting for one to become free if necessary. */
+    AudioBuffer<float>& getFreeBlock()
+    {
+        for (;;)
+        {
+            {
+                const ScopedLock sl (lock);
+
+                if (! freeBlocks.empty())
+                {
+                    auto* block = freeBlocks.back();
+                    freeBlocks.pop_back();
+                    return *block;
+                }
+            }
+
+            blockFreed.wait (-1);
+        }
+    }
+
+    /*  Queues the first numSamples samples of a block that was returned by getFreeBlock(). */
+    void submit (AudioBuffer<float>& block, int numSamples)
+    {
+        {
+            const ScopedLock sl (lock);
+            pendingBlocks.push_back ({ &block, numSamples });
+        }
+
+        notify();
+    }
+
+    /*  Waits until all of the submitted blocks have been written.
+        Returns false if any of them couldn't be written.
+    */
+    bool finish()
+    {
+        {
+            const ScopedLock sl (lock);
+            finishing = true;
+        }
+
+        notify();
+        stopThread (-1);
+        return ! hasFailed();
+    }
+
+    bool hasFailed() const noexcept     { return failed; }
+
+private:
+    struct PendingBlock
+    {
+        AudioBuffer<float>* block;
+        int numSamples;
+    };
+
+    void run() override
+    {
+        for (;;)
+        {
+            std::optional<PendingBlock> next;
+            bool isFinishing = false;
+
+            {
+                const ScopedLock sl (lock);
+                isFinishing = finishing;
+
+                if (! pendingBlocks.empty())
+                {
+                    next = pendingBlocks.front();
+                    pendingBlocks.pop_front();
+                }
+            }
+
+            if (! next.has_value())
+            {
+                if (isFinishing)
+                    return;
+
+                wait (-1);
+                continue;
+            }
+
+            if (! failed)
+            {
+                const AudioBuffer<float> toWrite (next->block->getArrayOfWritePointers(), numWriterChannels, next->numSamples);
+
+                if (! writer.writeFromAudioSampleBuffer (toWrite, 0, next->numSamples))
+                    failed = true;
+            }
+
+            {
+                const ScopedLock sl (lock);
+                freeBlocks.push_back (next->block);
+            }
+
+            blockFreed.signal();
+        }
+    }
+
+    AudioFormatWriter& writer;
+    const int numWriterChannels;
+
+    std::deque<AudioBuffer<float>> blocks;
+    std::vector<AudioBuffer<float>*> freeBlocks;
+    std::deque<PendingBlock> pendingBlocks;
+    CriticalSection lock;
+    WaitableEvent blockFreed;
+    bool finishing = false;
+    std::atomic<bool> failed { false };
+
+    JUCE_DECLARE_NON_COPYABLE (BlockWriter)
+};
+
+//==============================================================================
+/*  Reports a playing transport at the start of the block being rendered. */
+class OfflineRenderer::TransportPlayHead final : public AudioPlayHead
+{
+public:
+    TransportPlayHead (double sampleRateIn, double bpmIn)
+        : sampleRate (sampleRateIn), bpm (bpmIn)
+    {
+        info.setBpm (bpm);
+        info.setTimeSignature (TimeSignature{});
+        info.setIsPlaying (true);
+        setPosition (0);
+    }
+
+    void setPosition (int64 sample)
+    {
+        const auto seconds = (double) sample / sampleRate;
+        info.setTimeInSamples (sample);
+        info.setTimeInSeconds (seconds);
+        info.setPpqPosition (seconds * bpm / 60.0);
+    }
+
+    Optional<PositionInfo> getPosition() const override
+    {
+        return info;
+    }
+
+private:
+    const double sampleRate, bpm;
+    PositionInfo info;
+};
+
+//==============================================================================
+OfflineRenderer::OfflineRenderer (AudioProcessor& processorToRender)
+    : processor (processorToRender)
+{
+}
+
+OfflineRenderer::Report OfflineRenderer::render (AudioFormatWriter& writer, Range<int64> range, const Options& options)
+{
+    const auto startTime = Time::getMillisecondCounterHiRes();
+
+    const auto sampleRate = writer.getSampleRate();
+    const auto blockSize = options.getBlockSize();
+    const auto numInputChannels = processor.getTotalNumInputChannels();
+    const auto numWriterChannels = (int) writer.getNumChannels();
+    const auto numChannels = jmax (numInputChannels, processor.getTotalNumOutputChannels(), numWriterChannels);
+
+    jassert (sampleRate > 0.0 && numWriterChannels > 0);
+
+    TransportPlayHead playHead (sampleRate, options.getTempo());
+    auto* previousPlayHead = processor.getPlayHead();
+    const auto wasNonRealtime = processor.isNonRealtime();
+
+    processor.setNonRealtime (true);
+    processor.setPlayHead (&playHead);
+    processor.setRateAndBufferSizeDetails (sampleRate, blockSize);
+    processor.prepareToPlay (sampleRate, blockSize);
+
+    std::unique_ptr<TimeSliceThread> readAheadThread;
+    std::unique_ptr<BufferingAudioReader> input;
+
+    if (auto* source = options.getInput(); source != nullptr && numInputChannels > 0)
+    {
+        readAheadThread = std::make_unique<TimeSliceThread> ("Offline Render Read-Ahead");
+        readAheadThread->startThread();
+
+        input = std::make_unique<BufferingAudioReader> (new AudioSubsectionReader (source, 0, source->lengthInSamples, false),
+                                                        *readAheadThread,
+                                                        jmax (options.getInputReadAhead(), blockSize * 2));
+        input->setReadTimeout (-1);
+    }
+
+    const auto maxTailSamples = (int64) std::round (options.getMaximumTailLength() * sampleRate);
+    const auto silenceThreshold = Decibels::decibelsToGain (options.getSilenceThreshold());
+    const auto* midiInput = options.getMidiInput();
+    auto nextMidiEvent = midiInput != nullptr ? midiInput->getNextIndexAtTime ((double) range.getStart()) : 0;
+
+    Report report;
+    MidiBuffer midi;
+    BlockWriter blockWriter (writer, numChannels, numWriterChannels, blockSize, options.getMaximumBlocksInFlight());
+
+    for (auto position = range.getStart();;)
+    {
+        const auto isTail = position >= range.getEnd();
+        const auto end = isTail ? range.getEnd() + maxTailSamples : range.getEnd();
+
+        if (position >= end)
+            break;
+
+        const auto numSamples = (int) jmin ((int64) blockSize, end - position);
+        auto& block = blockWriter.getFreeBlock();
+        AudioBuffer<float> audio (block.getArrayOfWritePointers(), numChannels, numSamples);
+
+        audio.clear();
+        midi.clear();
+
+        // The blocks never straddle the end of the range, so the tail only gets silence
+        // and no MIDI, however far the input goes beyond the range
+        if (input != nullptr && ! isTail)
+            input->read (audio.getArrayOfWritePointers(), numInputChannels, position, numSamples);
+
+        if (midiInput != nullptr && ! isTail)
+        {
+            for (; nextMidiEvent < midiInput->getNumEvents(); ++nextMidiEvent)
+            {
+                const auto& message = midiInput->getEventPointer (nextMidiEvent)->message;
+                const auto offset = message.getTimeStamp() - (double) position;
+
+                if (offset >= (double) numSamples)
+                    break;
+
+                midi.addEvent (message, jmax (0, (int) offset));
+            }
+        }
+
+        playHead.setPosition (position);
+
+        {
+            const ScopedLock sl (processor.getCallbackLock());
+
+            if (processor.isSuspended())
+                audio.clear();
+            else
+                processor.processBlock (audio, midi);
+        }
+
+        if (isTail)
+        {
+            auto level = 0.0f;
+
+            for (auto channel = 0; channel < numWriterChannels; ++channel)
+                level = jmax (level, audio.getMagnitude (channel, 0, numSamples));
+
+            if (level < silenceThreshold)
+                break;
+        }
+
+        blockWriter.submit (block, numSamples);
+        position += numSamples;
+        report.numSamplesWritten += numSamples;
+
+        if (blockWriter.hasFailed())
+            break;
+
+        if (const auto& callback = options.getProgressCallback())
+        {
+            const auto progress = range.isEmpty() ? 1.0
+                                                  : jmin (1.0, (double) (position - range.getStart()) / (double) range.getLength());
+
+            if (! callback (progress))
+            {
+                report.result = Result::fail ("The render was cancelled");
+                break;
+            }
+        }
+    }
+
+    if (! blockWriter.finish())
+        report.result = Result::fail ("The rendered audio could not be written");
+
+    writer.flush();
+
+    input.reset();
+    readAheadThread.reset();
+
+    processor.releaseResources();
+    processor.setPlayHead (previousPlayHead);
+    processor.setNonRealtime (wasNonRealtime);
+
+    report.audioSeconds = (double) report.numSamplesWritten / sampleRate;
+    report.renderSeconds = (Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    return report;
+}
+
+OfflineRenderer::Report OfflineRenderer::render (AudioFormatWriter& writer, Range<int64> range)
+{
+    return render (writer, range, {});
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class OfflineRendererTests final : public UnitTest
+{
+public:
+    OfflineRendererTests()
+        : UnitTest ("OfflineRenderer", UnitTestCategories::audio) {}
+
+    void runTest() override
+    {
+        beginTest ("The range is rendered with input and play head positions");
+        {
+            constexpr auto inputLength = 20000;
+            MemoryBlock inputData;
+            writeWav (inputData, 2, [] (auto& writer)
+            {
+                AudioBuffer<float> ramp (2, inputLength);
+
+                for (auto i = 0; i < inputLength; ++i)
+                {
+                    ramp.setSample (0, i, getInputSample (i));
+                    ramp.setSample (1, i, -getInputSample (i));
+                }
+
+                writer.writeFromAudioSampleBuffer (ramp, 0, inputLength);
+            });
+
+            auto inputReader = readWav (inputData);
+            expect (inputReader != nullptr);
+
+            TestProcessor processor (2);
+            const Range<int64> range { 1000, 1000 + 10000 };
+
+            MemoryBlock output;
+            OfflineRenderer::Report report;
+
+            writeWav (output, 2, [&] (auto& writer)
+            {
+                report = OfflineRenderer (processor).render (writer,
+                                                             range,
+                                                             OfflineRenderer::Options().withBlockSize (4096)
+                                                                                       .withInput (inputReader.get()));
+            });
+
+            expect (report.result.wasOk());
+            expectEquals (report.numSamplesWritten, range.getLength());
+            expect (report.getRealtimeMultiple() > 0.0);
+            expect (! processor.isNonRealtime());
+            expect (processor.getPlayHead() == nullptr);
+
+            auto outputReader = readWav (output);
+            expectEquals (outputReader->lengthInSamples, range.getLength());
+
+            AudioBuffer<float> rendered (2, (int) range.getLength());
+            outputReader->read (&rendered, 0, rendered.getNumSamples(), 0, true, true);
+
+            auto allCorrect = true;
+
+            for (auto i = 0; i < rendered.getNumSamples(); ++i)
+            {
+                const auto timelineSample = range.getStart() + i;
+                const auto expected = getInputSample ((int) timelineSample) * 0.5f + TestProcessor::getLevelForPosition (timelineSample);
+
+                allCorrect = allCorrect && exactlyEqual (rendered.getSample (0, i), expected);
+            }
+
+            expect (allCorrect);
+        }
+
+        beginTest ("Rendering continues until the tail is silent");
+        {
+            TestProcessor processor (0);
+            const Range<int64> range { 0, TestProcessor::decayStart };
+
+            const auto renderLength = [&] (const OfflineRenderer::Options& options)
+            {
+                MemoryBlock output;
+                OfflineRenderer::Report report;
+
+                writeWav (output, 1, [&] (auto& writer)
+                {
+                    report = OfflineRenderer (processor).render (writer, range, options);
+                });
+
+                expect (report.result.wasOk());
+                return report.numSamplesWritten;
+            };
+
+            const auto options = OfflineRenderer::Options().withBlockSize (256);
+            expectEquals (renderLength (options), range.getLength());
+
+            // The decay drops below -90 dB after 962 samples
+            const auto withTail = renderLength (options.withMaximumTailLength (1.0));
+            expect (withTail >= range.getLength() + 962);
+            expect (withTail < range.getLength() + 962 + 256);
+
+            expectEquals (renderLength (options.withMaximumTailLength (500.0 / 44100.0)), range.getLength() + 500);
+        }
+
+        beginTest ("The tail doesn't use any input or MIDI from beyond the range");
+        {
+            MemoryBlock inputData;
+            writeWav (inputData, 1, [] (auto& writer)
+            {
+                constexpr auto inputLength = 20000;
+                AudioBuffer<float> constant (1, inputLength);
+                FloatVectorOperations::fill (constant.getWritePointer (0), 1.0f, inputLength);
+                writer.writeFromAudioSampleBuffer (constant, 0, inputLength);
+            });
+
+            auto inputReader = readWav (inputData);
+
+            MidiMessageSequence midiInput;
+            midiInput.addEvent (MidiMessage::noteOn (1, 60, 1.0f), 100.0);
+            midiInput.addEvent (MidiMessage::noteOff (1, 60), (double) TestProcessor::decayStart + 100.0);
+
+            TestProcessor processor (1);
+            MemoryBlock output;
+            OfflineRenderer::Report report;
+
+            writeWav (output, 1, [&] (auto& writer)
+            {
+                report = OfflineRenderer (processor).render (writer,
+                                                             { 0, TestProcessor::decayStart },
+                                                             OfflineRenderer::Options().withBlockSize (256)
+                                                                                       .withMaximumTailLength (1.0)
+                                                                                       .withInput (inputReader.get())
+                                                                                       .withMidiInput (&midiInput));
+            });
+
+            // The input carries on past the range, but the tail should still end as soon
+            // as the processor's own signal has decayed
+            expect (report.result.wasOk());
+            expect (report.numSamplesWritten < TestProcessor::decayStart + 962 + 256);
+            expectEquals (processor.numMidiEventsReceived, 1);
+        }
+
+        beginTest ("The progress callback can cancel a render");
+        {
+            TestProcessor processor (0);
+            MemoryBlock output;
+            OfflineRenderer::Report report;
+            auto numCallbacks = 0;
+
+            writeWav (output, 1, [&] (auto& writer)
+            {
+                report = OfflineRenderer (processor).render (writer,
+                                                             { 0, 100000 },
+                                                             OfflineRenderer::Options().withBlockSize (1000)
+                                                                                       .withProgressCallback ([&] (double) { return ++numCallbacks < 3; }));
+            });
+
+            expect (report.result.failed());
+            expectEquals (report.numSamplesWritten, (int64) 3000);
+        }
+    }
+
+private:
+    static float getInputSample (int index)
+    {
+        return (float) (index % 1000) / 1000.0f;
+    }
+
+    template <typename Callback>
+    static void writeWav (MemoryBlock& block, int numChannels, Callback&& callback)
+    {
+        std::unique_ptr<AudioFormatWriter> writer (WavAudioFormat().createWriterFor (new MemoryOutputStream (block, false),
+                                                                                     44100.0,
+                                                                                     (unsigned int) numChannels,
+                                                                                     32,
+                                                                                     {},
+                                                                                     0));
+        callback (*writer);
+    }
+
+    static std::unique_ptr<AudioFormatReader> readWav (const MemoryBlock& block)
+    {
+        return std::unique_ptr<AudioFormatReader> (WavAudioFormat().createReaderFor (new MemoryInputStream (block, false), true));
+    }
+
+    /*  Applies a gain of 0.5 to its input, and adds a signal based on the play head position. */
+    class TestProcessor final : public AudioProcessor
+    {
+    public:
+        static constexpr int64 decayStart = 5000;
+
+        explicit TestProcessor (int numInputs)
+            : AudioProcessor (getBuses (numInputs)) {}
+
+        static float getLevelForPosition (int64 position)
+        {
+            return position < decayStart ? 0.5f : 0.5f * std::pow (0.99f, (float) (position - decayStart));
+        }
+
+        const String getName() const override                         { return "Test Processor"; }
+        double getTailLengthSeconds() const override                  { return {}; }
+        bool acceptsMidi() const override                             { return false; }
+        bool producesMidi() const override                            { return false; }
+        AudioProcessorEditor* createEditor() override                 { return {}; }
+        bool hasEditor() const override                               { return {}; }
+        int getNumPrograms() override                                 { return 1; }
+        int getCurrentProgram() override                              { return {}; }
+        void setCurrentProgram (int) override                         {}
+        const String getProgramName (int) override                    { return {}; }
+        void changeProgramName (int, const String&) override          {}
+        void getStateInformation (juce::MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override          {}
+        void prepareToPlay (double, int) override                     {}
+        void releaseResources() override                              {}
+
+        void processBlock (AudioBuffer<float>& audio, MidiBuffer& midi) override
+        {
+            jassert (isNonRealtime());
+
+            numMidiEventsReceived += midi.getNumEvents();
+
+            const auto position = getPlayHead()->getPosition()->getTimeInSamples().orFallback (0);
+
+            for (auto channel = 0; channel < audio.getNumChannels(); ++channel)
+            {
+                auto* data = audio.getWritePointer (channel);
+
+                for (auto i = 0; i < audio.getNumSamples(); ++i)
+                    data[i] = data[i] * 0.5f + getLevelForPosition (position + i);
+            }
+        }
+
+        using AudioProcessor::processBlock;
+
+        int numMidiEventsReceived = 0;
+
+    private:
+        static BusesProperties getBuses (int numInputs)
+        {
+            const auto outputOnly = BusesProperties().withOutput ("out", AudioChannelSet::stereo());
+            return numInputs > 0 ? outputOnly.withInput ("in", AudioChannelSet::canonicalChannelSet (numInputs))
+                                 : outputOnly;
+        }
+    };
+};
+
+static OfflineRendererTests offlineRendererTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,223 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Renders the output of an AudioProcessor, such as an AudioProcessorGraph, to an
+    AudioFormatWriter as quickly as possible.
+
+    The processor is put into non-realtime mode and driven with large blocks, so that it
+    doesn't have to keep up with an audio device. While one block is being rendered, the
+    previous blocks are encoded and written on a background thread, and any input audio is
+    read ahead on another thread, so that disk access and encoding overlap with processing.
+
+    The processor is given an AudioPlayHead that reports a playing transport at the position
+    of each block, so tempo-synced processors behave as they would during playback.
+
+    @code
+    AudioProcessorGraph graph;
+    // ...add nodes...
+
+    std::unique_ptr<AudioFormatWriter> writer (WavAudioFormat().createWriterFor (stream, 48000.0, 2, 24, {}, 0));
+
+    OfflineRenderer renderer (graph);
+    const auto report = renderer.render (*writer, { 0, 48000 * 60 },
+                                         OfflineRenderer::Options().withMaximumTailLength (10.0));
+
+    DBG (report.getRealtimeMultiple() << "x realtime");
+    @endcode
+
+    @see AudioProcessorPlayer
+
+    @tags{Audio}
+*/
+class JUCE_API  OfflineRenderer
+{
+public:
+    //==============================================================================
+    /** Settings that control how a render is carried out. */
+    class Options
+    {
+    public:
+        /** The number of samples that the processor will be asked to render in each block.
+            Larger blocks are usually more efficient. The default is 4096.
+        */
+        [[nodiscard]] Options withBlockSize (int newBlockSize) const
+        {
+            jassert (newBlockSize > 0);
+            return withMember (*this, &Options::blockSize, jmax (1, newBlockSize));
+        }
+
+        /** After the end of the range has been reached, rendering will continue until the
+            processor's output falls silent, or until this many seconds of extra audio have been
+            written. The default is 0, which means that the output stops at the end of the range.
+
+            @see withSilenceThreshold
+        */
+        [[nodiscard]] Options withMaximumTailLength (double newMaximumTailSeconds) const
+        {
+            return withMember (*this, &Options::maximumTailSeconds, jmax (0.0, newMaximumTailSeconds));
+        }
+
+        /** While rendering the tail, a block whose samples are all below this level is treated
+            as silence, and ends the render. The default is -90 dB.
+        */
+        [[nodiscard]] Options withSilenceThreshold (float newThresholdDecibels) const
+        {
+            return withMember (*this, &Options::silenceThresholdDecibels, newThresholdDecibels);
+        }
+
+        /** Audio to feed to the processor's inputs. Sample n of the render range will be read
+            from sample n of this reader. The reader isn't owned, and must stay alive until the
+            render has finished.
+        */
+        [[nodiscard]] Options withInput (AudioFormatReader* newInput) const
+        {
+            return withMember (*this, &Options::input, newInput);
+        }
+
+        /** The number of samples of input to read ahead of the render position. The default
+            is 5 seconds at 48 kHz.
+        */
+        [[nodiscard]] Options withInputReadAhead (int newNumSamplesToReadAhead) const
+        {
+            return withMember (*this, &Options::inputReadAheadSamples, jmax (0, newNumSamplesToReadAhead));
+        }
+
+        /** MIDI to send to the processor. The timestamps of the events are in samples, using the
+            same timeline as the render range. The sequence isn't owned, and must stay alive until
+            the render has finished.
+        */
+        [[nodiscard]] Options withMidiInput (const MidiMessageSequence* newMidiInput) const
+        {
+            return withMember (*this, &Options::midiInput, newMidiInput);
+        }
+
+        /** The tempo that the play head will report. The default is 120 bpm. */
+        [[nodiscard]] Options withTempo (double newBpm) const
+        {
+            jassert (newBpm > 0.0);
+            return withMember (*this, &Options::bpm, newBpm);
+        }
+
+        /** The maximum number of rendered blocks that may be waiting to be written at once.
+            When the writer falls this far behind, rendering waits for it to catch up.
+            The default is 8.
+        */
+        [[nodiscard]] Options withMaximumBlocksInFlight (int newMaximumBlocks) const
+        {
+            return withMember (*this, &Options::maximumBlocksInFlight, jmax (1, newMaximumBlocks));
+        }
+
+        /** A function that will be called on the rendering thread after each block, with the
+            proportion of the range that has been rendered so far.
+            If it returns false, the render will stop.
+        */
+        [[nodiscard]] Options withProgressCallback (std::function<bool (double)> newCallback) const
+        {
+            return withMember (*this, &Options::progressCallback, std::move (newCallback));
+        }
+
+        int getBlockSize() const                                        { return blockSize; }
+        double getMaximumTailLength() const                             { return maximumTailSeconds; }
+        float getSilenceThreshold() const                               { return silenceThresholdDecibels; }
+        AudioFormatReader* getInput() const                             { return input; }
+        int getInputReadAhead() const                                   { return inputReadAheadSamples; }
+        const MidiMessageSequence* getMidiInput() const                 { return midiInput; }
+        double getTempo() const                                         { return bpm; }
+        int getMaximumBlocksInFlight() const                            { return maximumBlocksInFlight; }
+        const std::function<bool (double)>& getProgressCallback() const { return progressCallback; }
+
+    private:
+        int blockSize = 4096;
+        double maximumTailSeconds = 0.0;
+        float silenceThresholdDecibels = -90.0f;
+        AudioFormatReader* input = nullptr;
+        int inputReadAheadSamples = 48000 * 5;
+        const MidiMessageSequence* midiInput = nullptr;
+        double bpm = 120.0;
+        int maximumBlocksInFlight = 8;
+        std::function<bool (double)> progressCallback;
+    };
+
+    //==============================================================================
+    /** Describes the outcome of a render. */
+    struct Report
+    {
+        /** Indicates whether the render completed. This will be a failure if the writer
+            couldn't write some data, or if the render was stopped by the progress callback.
+        */
+        Result result = Result::ok();
+
+        /** The number of samples written to the writer, including any tail. */
+        int64 numSamplesWritten = 0;
+
+        /** The duration of the audio that was written. */
+        double audioSeconds = 0.0;
+
+        /** The time taken to render and write the audio. */
+        double renderSeconds = 0.0;
+
+        /** Returns how many times faster than real time the render was. */
+        double getRealtimeMultiple() const      { return renderSeconds > 0.0 ? audioSeconds / renderSeconds : 0.0; }
+    };
+
+    //==============================================================================
+    /** Creates a renderer for a processor. The processor isn't owned, and must outlive the
+        renderer.
+    */
+    explicit OfflineRenderer (AudioProcessor& processorToRender);
+
+    /** Renders a range of the timeline, given in samples, to a writer.
+
+        The processor will be prepared with the writer's sample rate and the requested block
+        size, and its resources will be released when the render has finished. The processor's
+        non-realtime flag and play head are restored afterwards.
+
+        If the processor is an AudioProcessorGraph, this should be called on the message
+        thread, or while the message thread is running, so that the graph can be rebuilt after
+        it has been prepared.
+
+        This call blocks until all of the audio has been written.
+    */
+    Report render (AudioFormatWriter& writer, Range<int64> range, const Options& options);
+
+    /** Renders a range of the timeline to a writer, using the default Options. */
+    Report render (AudioFormatWriter& writer, Range<int64> range);
+
+private:
+    //==============================================================================
+    class BlockWriter;
+    class TransportPlayHead;
+
+    AudioProcessor& processor;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OfflineRenderer)
+};
+
+} // namespace juce
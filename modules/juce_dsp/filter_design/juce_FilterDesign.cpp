@@ -289,6 +289,68 @@ typename FIR::Coefficients<FloatType>::Ptr
     return *result;
 }
 
+template <typename FloatType>
+typename FIR::Coefficients<FloatType>::Ptr
+    FilterDesign<FloatType>::designFIRLowpassHalfBandMinimumPhaseMethod (FloatType normalisedTransitionWidth,
+                                                                         FloatType amplitudedB)
+{
+    auto linearPhase = designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidth, amplitudedB);
+    auto* h = linearPhase->getRawCoefficients();
+    auto numTaps = (int) linearPhase->getFilterOrder() + 1;
+
+    // The cepstrum is calculated with a much larger FFT than the filter length,
+    // to keep its time-aliasing well below the stop band
+    auto order = jmax (10, (int) std::ceil (std::log2 ((double) numTaps * 32.0)));
+    auto size = 1 << order;
+    FFT fft (order);
+
+    std::vector<Complex<float>> data ((size_t) size), spectrum ((size_t) size);
+
+    for (int i = 0; i < numTaps; ++i)
+        data[(size_t) i] = (float) h[i];
+
+    fft.perform (data.data(), spectrum.data(), false);
+
+    // The linear phase filter has zeros on the unit circle, so its magnitude is
+    // clipped to a floor well below the stop band before taking the logarithm
+    auto floor = (float) Decibels::decibelsToGain (amplitudedB - (FloatType) 40, (FloatType) -400);
+
+    for (auto& bin : spectrum)
+        bin = std::log (jmax (floor, std::abs (bin)));
+
+    fft.perform (spectrum.data(), data.data(), true);
+
+    // Folding the real cepstrum onto positive quefrencies gives the complex
+    // cepstrum of the minimum phase filter with the same magnitude
+    for (int i = 1; i < size / 2; ++i)
+    {
+        data[(size_t) i] = 2.0f * data[(size_t) i].real();
+        data[(size_t) (size - i)] = 0.0f;
+    }
+
+    data[0] = data[0].real();
+    data[(size_t) size / 2] = data[(size_t) size / 2].real();
+
+    fft.perform (data.data(), spectrum.data(), false);
+
+    for (auto& bin : spectrum)
+        bin = std::exp (bin);
+
+    fft.perform (spectrum.data(), data.data(), true);
+
+    auto* result = new typename FIR::Coefficients<FloatType> ((size_t) numTaps);
+    auto* c = result->getRawCoefficients();
+    double sum = 0.0;
+
+    for (int i = 0; i < numTaps; ++i)
+        sum += data[(size_t) i].real();
+
+    for (int i = 0; i < numTaps; ++i)
+        c[i] = static_cast<FloatType> (data[(size_t) i].real() / sum);
+
+    return *result;
+}
+
 template <typename FloatType>
 Array<double> FilterDesign<FloatType>::getPartialImpulseResponseHn (int n, double kp)
 {
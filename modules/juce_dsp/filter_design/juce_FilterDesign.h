@@ -139,6 +139,22 @@ struct FilterDesign
     static FIRCoefficientsPtr designFIRLowpassHalfBandEquirippleMethod (FloatType normalisedTransitionWidth,
                                                                         FloatType amplitudedB);
 
+    /** This method generates a FIR::Coefficients for a low-pass filter, with
+        a cutoff frequency at half band, which has the same magnitude response as the
+        one returned by designFIRLowpassHalfBandEquirippleMethod, but minimum phase.
+
+        The minimum phase impulse response is calculated from the magnitude response
+        of the equiripple filter using the homomorphic (cepstrum) method. Most of its
+        energy is at the start of the impulse response, so its latency is much lower
+        than the latency of the linear phase filter.
+
+        @param normalisedTransitionWidth    the normalised size between 0 and 0.5 of the transition
+                                            between the pass band and the stop band
+        @param amplitudedB                  the maximum amplitude in dB expected in the stop band (must be negative)
+    */
+    static FIRCoefficientsPtr designFIRLowpassHalfBandMinimumPhaseMethod (FloatType normalisedTransitionWidth,
+                                                                          FloatType amplitudedB);
+
     //==============================================================================
     /** This method returns an array of IIR::Coefficients, made to be used in
         cascaded IIRFilters, providing a minimum phase low-pass filter without any
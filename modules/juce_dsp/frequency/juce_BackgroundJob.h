@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+//==============================================================================
+// A unit of work that the audio thread hands over to a background thread, and
+// collects again later. The audio thread posts the job and wakes the background
+// thread, which calls runIfPending() each time it wakes up. Before touching any of
+// the job's data again, the audio thread must call waitUntilFinished().
+class BackgroundJob
+{
+public:
+    void post() noexcept
+    {
+        pending.store (true, std::memory_order_release);
+    }
+
+    template <typename Fn>
+    void runIfPending (Fn&& fn)
+    {
+        if (! pending.load (std::memory_order_acquire))
+            return;
+
+        fn();
+        pending.store (false, std::memory_order_release);
+        finished.signal();
+    }
+
+    void waitUntilFinished() noexcept
+    {
+        // The audio thread needs the results now, so if the background thread is
+        // running late, blocking here is the only option left
+        while (pending.load (std::memory_order_acquire))
+            finished.wait (-1);
+    }
+
+private:
+    std::atomic<bool> pending { false };
+    WaitableEvent finished;
+};
+
+} // namespace juce::dsp
@@ -144,62 +144,262 @@ ConvolutionMessageQueue::ConvolutionMessageQueue (ConvolutionMessageQueue&&) noe
 ConvolutionMessageQueue& ConvolutionMessageQueue::operator= (ConvolutionMessageQueue&&) noexcept = default;
 
 //==============================================================================
-struct ConvolutionEngine
+// The frequency-domain partitions of an impulse response, in the layout produced by
+// ConvolutionEngine::prepareForConvolution. These never change once they have been
+// created, so they can be shared between any engines using the same impulse response
+// and partitioning.
+struct ImpulseResponseSpectra
 {
-    ConvolutionEngine (const float* samples,
-                       size_t numSamples,
-                       size_t maxBlockSize)
-        : blockSize ((size_t) nextPowerOfTwo ((int) maxBlockSize)),
-          fftSize (blockSize > 128 ? 2 * blockSize : 4 * blockSize),
-          fftObject (std::make_unique<FFT> (roundToInt (std::log2 (fftSize)))),
-          numSegments (numSamples / (fftSize - blockSize) + 1u),
-          numInputSegments ((blockSize > 128 ? numSegments : 3 * numSegments)),
-          bufferInput      (1, static_cast<int> (fftSize)),
-          bufferOutput     (1, static_cast<int> (fftSize * 2)),
-          bufferTempOutput (1, static_cast<int> (fftSize * 2)),
-          bufferOverlap    (1, static_cast<int> (fftSize))
+    ImpulseResponseSpectra (const float* samples, size_t numSamples, size_t blockSize, size_t fftSize)
     {
-        bufferOutput.clear();
+        const auto segmentSize = fftSize - blockSize;
+        const auto numSegments = numSamples / segmentSize + 1u;
 
-        auto updateSegmentsIfNecessary = [this] (size_t numSegmentsToUpdate,
-                                                 std::vector<AudioBuffer<float>>& segments)
+        // Only the first fftSize + 1 values of each spectrum are used. The rest is padding,
+        // which keeps every spectrum SIMD-aligned.
+        segments = AudioBlock<float> (storage, numSegments, (fftSize + 1 + alignmentMask) & ~alignmentMask);
+
+        FFT fft (roundToInt (std::log2 (fftSize)));
+        HeapBlock<float> scratch (fftSize * 2);
+        size_t currentPtr = 0;
+
+        for (size_t i = 0; i < numSegments; ++i)
         {
-            if (numSegmentsToUpdate == 0
-                || numSegmentsToUpdate != (size_t) segments.size()
-                || (size_t) segments[0].getNumSamples() != fftSize * 2)
-            {
-                segments.clear();
+            FloatVectorOperations::clear (scratch.get(), static_cast<int> (fftSize * 2));
 
-                for (size_t i = 0; i < numSegmentsToUpdate; ++i)
-                    segments.push_back ({ 1, static_cast<int> (fftSize * 2) });
-            }
-        };
+            if (i == 0)
+                scratch[0] = 1.0f;
 
-        updateSegmentsIfNecessary (numInputSegments, buffersInputSegments);
-        updateSegmentsIfNecessary (numSegments,      buffersImpulseSegments);
+            FloatVectorOperations::copy (scratch.get(),
+                                         samples + currentPtr,
+                                         static_cast<int> (jmin (segmentSize, numSamples - currentPtr)));
 
-        auto FFTTempObject = std::make_unique<FFT> (roundToInt (std::log2 (fftSize)));
-        size_t currentPtr = 0;
+            fft.performRealOnlyForwardTransform (scratch.get());
+            prepareForConvolution (scratch.get(), fftSize);
+
+            FloatVectorOperations::copy (segments.getChannelPointer (i), scratch.get(), static_cast<int> (fftSize + 1));
+
+            currentPtr += segmentSize;
+        }
+    }
+
+    // After each FFT, this function is called to allow convolution to be performed with only 4 SIMD functions calls.
+    static void prepareForConvolution (float* samples, size_t fftSize) noexcept
+    {
+        auto FFTSizeDiv2 = fftSize / 2;
+
+        for (size_t i = 0; i < FFTSizeDiv2; i++)
+            samples[i] = samples[i << 1];
+
+        samples[FFTSizeDiv2] = 0;
+
+        for (size_t i = 1; i < FFTSizeDiv2; i++)
+            samples[i + FFTSizeDiv2] = -samples[((fftSize - i) << 1) + 1];
+    }
+
+    size_t getNumSegments() const noexcept                  { return segments.getNumChannels(); }
+    const float* getSegment (size_t index) const noexcept   { return segments.getChannelPointer (index); }
+
+    static constexpr size_t alignmentMask = 15;
+
+    HeapBlock<char> storage;
+    AudioBlock<float> segments;
+};
+
+// A process-wide cache of impulse response spectra. Engines that load the same impulse
+// response with the same partitioning, whether they belong to the same Convolution or
+// not, share a single copy of its spectra. Each entry is released when the last engine
+// using it is destroyed.
+// Entries are looked up by a hash of the samples, but each one also keeps a copy of the
+// samples it was made from, so that a hash collision can never hand out the wrong spectra.
+class ImpulseResponseSpectraCache
+{
+public:
+    std::shared_ptr<const ImpulseResponseSpectra> getSpectra (const float* samples,
+                                                              size_t numSamples,
+                                                              size_t blockSize,
+                                                              size_t fftSize)
+    {
+        const Key key { hashSamples (samples, numSamples), numSamples, blockSize, fftSize };
 
-        for (auto& buf : buffersImpulseSegments)
         {
-            buf.clear();
+            const std::lock_guard<std::mutex> lock (mutex);
 
-            auto* impulseResponse = buf.getWritePointer (0);
+            if (auto existing = findEntry (key, samples))
+                return existing;
+        }
 
-            if (&buf == &buffersImpulseSegments.front())
-                impulseResponse[0] = 1.0f;
+        // Other loads can carry on while the spectra are calculated
+        auto created = std::make_shared<const Entry> (samples, numSamples, blockSize, fftSize);
 
-            FloatVectorOperations::copy (impulseResponse,
-                                         samples + currentPtr,
-                                         static_cast<int> (jmin (fftSize - blockSize, numSamples - currentPtr)));
+        const std::lock_guard<std::mutex> lock (mutex);
+
+        if (auto existing = findEntry (key, samples))
+            return existing;
+
+        removeExpiredEntries();
+        entries.emplace (key, created);
+        return { created, &created->spectra };
+    }
 
-            FFTTempObject->performRealOnlyForwardTransform (impulseResponse);
-            prepareForConvolution (impulseResponse);
+    // Returns the number of spectra that are currently in use
+    size_t getNumSpectraInUse() const
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
 
-            currentPtr += (fftSize - blockSize);
+        return (size_t) std::count_if (entries.begin(), entries.end(), [] (const auto& entry)
+        {
+            return ! entry.second.expired();
+        });
+    }
+
+private:
+    struct Key
+    {
+        uint64 hash;
+        size_t numSamples, blockSize, fftSize;
+
+        auto tie() const noexcept                       { return std::tie (hash, numSamples, blockSize, fftSize); }
+        bool operator< (const Key& other) const noexcept { return tie() < other.tie(); }
+    };
+
+    struct Entry
+    {
+        Entry (const float* samplesIn, size_t numSamples, size_t blockSize, size_t fftSize)
+            : samples (samplesIn, samplesIn + numSamples),
+              spectra (samplesIn, numSamples, blockSize, fftSize)
+        {}
+
+        // The samples are compared bit by bit, in the same way that they're hashed
+        bool matches (const float* other) const noexcept
+        {
+            return samples.empty() || std::memcmp (samples.data(), other, samples.size() * sizeof (float)) == 0;
+        }
+
+        const std::vector<float> samples;
+        const ImpulseResponseSpectra spectra;
+    };
+
+    static uint64 hashSamples (const float* samples, size_t numSamples) noexcept
+    {
+        // 64-bit FNV-1a over the bits of each sample
+        uint64 hash = 0xcbf29ce484222325ull;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            uint32 bits;
+            std::memcpy (&bits, samples + i, sizeof (bits));
+            hash = (hash ^ bits) * 0x100000001b3ull;
         }
 
+        return hash;
+    }
+
+    std::shared_ptr<const ImpulseResponseSpectra> findEntry (const Key& key, const float* samples) const
+    {
+        const auto range = entries.equal_range (key);
+
+        for (auto iter = range.first; iter != range.second; ++iter)
+            if (auto entry = iter->second.lock())
+                if (entry->matches (samples))
+                    return { entry, &entry->spectra };
+
+        return nullptr;
+    }
+
+    void removeExpiredEntries()
+    {
+        for (auto iter = entries.begin(); iter != entries.end();)
+            iter = iter->second.expired() ? entries.erase (iter) : std::next (iter);
+    }
+
+    std::multimap<Key, std::weak_ptr<const Entry>> entries;
+    mutable std::mutex mutex;
+};
+
+//==============================================================================
+// Accumulates the products of several pairs of spectra into an output spectrum, in the
+// layout produced by ConvolutionEngine::prepareForConvolution.
+// Each pair is handled in a single pass which updates the real and imaginary parts together,
+// rather than in four separate passes over the output. The output stays in the cache while
+// the pairs are streamed through it one after another.
+static void multiplyAccumulateSpectra (float* output,
+                                       const float* const* inputs,
+                                       const float* const* impulses,
+                                       size_t numPairs,
+                                       size_t fftSize) noexcept
+{
+    const auto numBins = fftSize / 2;
+    auto* outRe = output;
+    auto* outIm = output + numBins;
+
+    for (size_t i = 0; i < numPairs; ++i)
+    {
+        const auto* inRe = inputs[i];
+        const auto* inIm = inputs[i] + numBins;
+        const auto* irRe = impulses[i];
+        const auto* irIm = impulses[i] + numBins;
+        size_t bin = 0;
+
+       #if JUCE_USE_SIMD
+        using Register = SIMDRegister<float>;
+
+        // The imaginary parts start half way through each spectrum, so they're only aligned
+        // when the number of bins is a multiple of the register size
+        if (numBins % Register::SIMDNumElements == 0)
+        {
+            for (; bin < numBins; bin += Register::SIMDNumElements)
+            {
+                const auto aRe = Register::fromRawArray (inRe + bin);
+                const auto aIm = Register::fromRawArray (inIm + bin);
+                const auto bRe = Register::fromRawArray (irRe + bin);
+                const auto bIm = Register::fromRawArray (irIm + bin);
+
+                const auto re = Register::multiplyAdd (Register::fromRawArray (outRe + bin), aRe, bRe) - aIm * bIm;
+                const auto im = Register::multiplyAdd (Register::multiplyAdd (Register::fromRawArray (outIm + bin), aRe, bIm), aIm, bRe);
+
+                re.copyToRawArray (outRe + bin);
+                im.copyToRawArray (outIm + bin);
+            }
+        }
+       #endif
+
+        for (; bin < numBins; ++bin)
+        {
+            const auto re = inRe[bin] * irRe[bin] - inIm[bin] * irIm[bin];
+            const auto im = inRe[bin] * irIm[bin] + inIm[bin] * irRe[bin];
+
+            outRe[bin] += re;
+            outIm[bin] += im;
+        }
+
+        output[fftSize] += inputs[i][fftSize] * impulses[i][fftSize];
+    }
+}
+
+//==============================================================================
+struct ConvolutionEngine
+{
+    ConvolutionEngine (const float* samples,
+                       size_t numSamples,
+                       size_t maxBlockSize)
+        : blockSize ((size_t) nextPowerOfTwo ((int) maxBlockSize)),
+          fftSize (blockSize > 128 ? 2 * blockSize : 4 * blockSize),
+          fftObject (std::make_unique<FFT> (roundToInt (std::log2 (fftSize)))),
+          impulseSpectra (spectraCache->getSpectra (samples, numSamples, blockSize, fftSize)),
+          numSegments (impulseSpectra->getNumSegments()),
+          numInputSegments ((blockSize > 128 ? numSegments : 3 * numSegments)),
+          bufferInput (1, static_cast<int> (fftSize)),
+          bufferOutput     (bufferOutputStorage,     1, fftSize * 2),
+          bufferTempOutput (bufferTempOutputStorage, 1, fftSize * 2),
+          bufferOverlap (1, static_cast<int> (fftSize)),
+          buffersInputSegments (buffersInputSegmentsStorage, numInputSegments, fftSize * 2),
+          batchInputs (numSegments),
+          batchImpulses (numSegments)
+    {
+        for (size_t i = 0; i < numSegments; ++i)
+            batchImpulses[i] = impulseSpectra->getSegment (i);
+
         reset();
     }
 
@@ -209,9 +409,7 @@ struct ConvolutionEngine
         bufferOverlap.clear();
         bufferTempOutput.clear();
         bufferOutput.clear();
-
-        for (auto& buf : buffersInputSegments)
-            buf.clear();
+        buffersInputSegments.clear();
 
         currentSegment = 0;
         inputDataPos = 0;
@@ -222,11 +420,9 @@ struct ConvolutionEngine
         // Overlap-add, zero latency convolution algorithm with uniform partitioning
         size_t numSamplesProcessed = 0;
 
-        auto indexStep = numInputSegments / numSegments;
-
         auto* inputData      = bufferInput.getWritePointer (0);
-        auto* outputTempData = bufferTempOutput.getWritePointer (0);
-        auto* outputData     = bufferOutput.getWritePointer (0);
+        auto* outputTempData = bufferTempOutput.getChannelPointer (0);
+        auto* outputData     = bufferOutput.getChannelPointer (0);
         auto* overlapData    = bufferOverlap.getWritePointer (0);
 
         while (numSamplesProcessed < numSamples)
@@ -236,7 +432,7 @@ struct ConvolutionEngine
 
             FloatVectorOperations::copy (inputData + inputDataPos, input + numSamplesProcessed, static_cast<int> (numSamplesToProcess));
 
-            auto* inputSegmentData = buffersInputSegments[currentSegment].getWritePointer (0);
+            auto* inputSegmentData = buffersInputSegments.getChannelPointer (currentSegment);
             FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (fftSize));
 
             fftObject->performRealOnlyForwardTransform (inputSegmentData);
@@ -246,26 +442,13 @@ struct ConvolutionEngine
             if (inputDataWasEmpty)
             {
                 FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (fftSize + 1));
-
-                auto index = currentSegment;
-
-                for (size_t i = 1; i < numSegments; ++i)
-                {
-                    index += indexStep;
-
-                    if (index >= numInputSegments)
-                        index -= numInputSegments;
-
-                    convolutionProcessingAndAccumulate (buffersInputSegments[index].getWritePointer (0),
-                                                        buffersImpulseSegments[i].getWritePointer (0),
-                                                        outputTempData);
-                }
+                accumulatePreviousSegments (outputTempData);
             }
 
             FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (fftSize + 1));
 
             convolutionProcessingAndAccumulate (inputSegmentData,
-                                                buffersImpulseSegments.front().getWritePointer (0),
+                                                impulseSpectra->getSegment (0),
                                                 outputData);
 
             updateSymmetricFrequencyDomainData (outputData);
@@ -302,11 +485,9 @@ struct ConvolutionEngine
         // Overlap-add, zero latency convolution algorithm with uniform partitioning
         size_t numSamplesProcessed = 0;
 
-        auto indexStep = numInputSegments / numSegments;
-
         auto* inputData      = bufferInput.getWritePointer (0);
-        auto* outputTempData = bufferTempOutput.getWritePointer (0);
-        auto* outputData     = bufferOutput.getWritePointer (0);
+        auto* outputTempData = bufferTempOutput.getChannelPointer (0);
+        auto* outputData     = bufferOutput.getChannelPointer (0);
         auto* overlapData    = bufferOverlap.getWritePointer (0);
 
         while (numSamplesProcessed < numSamples)
@@ -324,7 +505,7 @@ struct ConvolutionEngine
             if (inputDataPos == blockSize)
             {
                 // Copy input data in input segment
-                auto* inputSegmentData = buffersInputSegments[currentSegment].getWritePointer (0);
+                auto* inputSegmentData = buffersInputSegments.getChannelPointer (currentSegment);
                 FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (fftSize));
 
                 fftObject->performRealOnlyForwardTransform (inputSegmentData);
@@ -332,25 +513,12 @@ struct ConvolutionEngine
 
                 // Complex multiplication
                 FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (fftSize + 1));
-
-                auto index = currentSegment;
-
-                for (size_t i = 1; i < numSegments; ++i)
-                {
-                    index += indexStep;
-
-                    if (index >= numInputSegments)
-                        index -= numInputSegments;
-
-                    convolutionProcessingAndAccumulate (buffersInputSegments[index].getWritePointer (0),
-                                                        buffersImpulseSegments[i].getWritePointer (0),
-                                                        outputTempData);
-                }
+                accumulatePreviousSegments (outputTempData);
 
                 FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (fftSize + 1));
 
                 convolutionProcessingAndAccumulate (inputSegmentData,
-                                                    buffersImpulseSegments.front().getWritePointer (0),
+                                                    impulseSpectra->getSegment (0),
                                                     outputData);
 
                 updateSymmetricFrequencyDomainData (outputData);
@@ -375,32 +543,42 @@ struct ConvolutionEngine
         }
     }
 
-    // After each FFT, this function is called to allow convolution to be performed with only 4 SIMD functions calls.
-    void prepareForConvolution (float *samples) noexcept
+    // Returns the time-domain output that will be produced during the next block, when
+    // using processSamplesWithAddedLatency.
+    const float* getNextOutputBlock() const noexcept   { return bufferOutput.getChannelPointer (0); }
+
+    // Multiplies every impulse segment except the first by the input segment that it
+    // applies to, and adds the results to the output, in a single batch.
+    void accumulatePreviousSegments (float* output) noexcept
     {
-        auto FFTSizeDiv2 = fftSize / 2;
+        if (numSegments < 2)
+            return;
 
-        for (size_t i = 0; i < FFTSizeDiv2; i++)
-            samples[i] = samples[i << 1];
+        auto indexStep = numInputSegments / numSegments;
+        auto index = currentSegment;
 
-        samples[FFTSizeDiv2] = 0;
+        for (size_t i = 1; i < numSegments; ++i)
+        {
+            index += indexStep;
 
-        for (size_t i = 1; i < FFTSizeDiv2; i++)
-            samples[i + FFTSizeDiv2] = -samples[((fftSize - i) << 1) + 1];
-    }
+            if (index >= numInputSegments)
+                index -= numInputSegments;
 
-    // Does the convolution operation itself only on half of the frequency domain samples.
-    void convolutionProcessingAndAccumulate (const float *input, const float *impulse, float *output)
-    {
-        auto FFTSizeDiv2 = fftSize / 2;
+            batchInputs[i] = buffersInputSegments.getChannelPointer (index);
+        }
 
-        FloatVectorOperations::addWithMultiply      (output, input, impulse, static_cast<int> (FFTSizeDiv2));
-        FloatVectorOperations::subtractWithMultiply (output, &(input[FFTSizeDiv2]), &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
+        multiplyAccumulateSpectra (output, batchInputs.data() + 1, batchImpulses.data() + 1, numSegments - 1, fftSize);
+    }
 
-        FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), input, &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
-        FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), &(input[FFTSizeDiv2]), impulse, static_cast<int> (FFTSizeDiv2));
+    void prepareForConvolution (float* samples) noexcept
+    {
+        ImpulseResponseSpectra::prepareForConvolution (samples, fftSize);
+    }
 
-        output[fftSize] += input[fftSize] * impulse[fftSize];
+    // Does the convolution operation itself only on half of the frequency domain samples.
+    void convolutionProcessingAndAccumulate (const float* input, const float* impulse, float* output) noexcept
+    {
+        multiplyAccumulateSpectra (output, &input, &impulse, 1, fftSize);
     }
 
     // Undoes the re-organization of samples from the function prepareForConvolution.
@@ -426,15 +604,206 @@ struct ConvolutionEngine
     }
 
     //==============================================================================
+    SharedResourcePointer<ImpulseResponseSpectraCache> spectraCache;
+
     const size_t blockSize;
     const size_t fftSize;
     const std::unique_ptr<FFT> fftObject;
+    const std::shared_ptr<const ImpulseResponseSpectra> impulseSpectra;
     const size_t numSegments;
     const size_t numInputSegments;
     size_t currentSegment = 0, inputDataPos = 0;
 
-    AudioBuffer<float> bufferInput, bufferOutput, bufferTempOutput, bufferOverlap;
-    std::vector<AudioBuffer<float>> buffersInputSegments, buffersImpulseSegments;
+    // The frequency-domain buffers are SIMD-aligned for multiplyAccumulateSpectra
+    HeapBlock<char> bufferOutputStorage, bufferTempOutputStorage, buffersInputSegmentsStorage;
+    AudioBuffer<float> bufferInput;
+    AudioBlock<float> bufferOutput, bufferTempOutput;
+    AudioBuffer<float> bufferOverlap;
+    AudioBlock<float> buffersInputSegments;
+    std::vector<const float*> batchInputs, batchImpulses;
+};
+
+//==============================================================================
+// Describes one stage of a multi-stage non-uniform partitioned convolution.
+// Each stage convolves the input with a section of the impulse response, using
+// partitions that grow with the offset of the section, so that the end of a long
+// impulse response is processed with a small number of large partitions.
+struct ConvolutionStageLayout
+{
+    int offset, length, partitionSize, latency;
+    bool runsInBackground;
+};
+
+static std::vector<ConvolutionStageLayout> createStageLayout (int irSize,
+                                                              int headSize,
+                                                              int maxPartitionSize,
+                                                              bool useBackgroundThread)
+{
+    // Smaller partitions are computed on the audio thread, as the cost of handing them
+    // over to the background thread would outweigh the benefit
+    constexpr auto minBackgroundPartitionSize = 1024;
+
+    std::vector<ConvolutionStageLayout> result;
+
+    for (auto offset = headSize; offset < irSize;)
+    {
+        // A stage's output is delayed by one partition. When running in the background,
+        // it's delayed by another partition to give the background thread time to finish,
+        // so the stage's offset must be at least twice as large as its partitions.
+        const auto runsInBackground = useBackgroundThread && offset / 2 >= minBackgroundPartitionSize;
+        const auto partitionSize = jmin (runsInBackground ? offset / 2 : offset, maxPartitionSize);
+        const auto end = partitionSize == maxPartitionSize ? irSize : jmin (irSize, offset * 4);
+
+        result.push_back ({ offset,
+                            end - offset,
+                            partitionSize,
+                            runsInBackground ? 2 * partitionSize : partitionSize,
+                            runsInBackground });
+        offset = end;
+    }
+
+    return result;
+}
+
+//==============================================================================
+// Runs the convolution stages with the largest partitions on a background thread.
+// Each time a whole partition of input has been collected, it is handed to the
+// background thread, which has until the next partition has been collected to
+// compute the stage's output.
+class BackgroundConvolutionStages  : private Thread
+{
+public:
+    BackgroundConvolutionStages()
+        : Thread ("Convolution tail")
+    {}
+
+    ~BackgroundConvolutionStages() override
+    {
+        signalThreadShouldExit();
+        notify();
+        stopThread (-1);
+    }
+
+    // The impulse response segment should already include the stage's latency
+    void addStage (const AudioBuffer<float>& segment, int numChannels, int partitionSize)
+    {
+        auto stage = std::make_unique<Stage>();
+        stage->partitionSize = partitionSize;
+
+        for (auto channel = 0; channel < numChannels; ++channel)
+            stage->engines.push_back (std::make_unique<ConvolutionEngine> (segment.getReadPointer (jmin (segment.getNumChannels() - 1, channel)),
+                                                                           (size_t) segment.getNumSamples(),
+                                                                           (size_t) partitionSize));
+
+        for (auto* buffer : { &stage->input, &stage->pendingInput, &stage->output, &stage->pendingOutput })
+        {
+            buffer->setSize (numChannels, partitionSize);
+            buffer->clear();
+        }
+
+        stage->scratch.setSize (1, partitionSize);
+        stages.push_back (std::move (stage));
+    }
+
+    void start()
+    {
+        if (! stages.empty())
+            startThread (Priority::high);
+    }
+
+    void reset()
+    {
+        for (auto& stage : stages)
+        {
+            stage->job.waitUntilFinished();
+
+            for (auto& engine : stage->engines)
+                engine->reset();
+
+            for (auto* buffer : { &stage->input, &stage->pendingInput, &stage->output, &stage->pendingOutput })
+                buffer->clear();
+
+            stage->position = 0;
+        }
+    }
+
+    // Adds the output of the stages to the output block
+    void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output, size_t numChannels, size_t numSamples)
+    {
+        for (auto& stage : stages)
+        {
+            for (size_t done = 0; done < numSamples;)
+            {
+                const auto num = jmin (numSamples - done, (size_t) (stage->partitionSize - stage->position));
+
+                for (size_t channel = 0; channel < numChannels; ++channel)
+                {
+                    FloatVectorOperations::copy (stage->input.getWritePointer ((int) channel, stage->position),
+                                                 input.getChannelPointer (channel) + done,
+                                                 (int) num);
+                    FloatVectorOperations::add (output.getChannelPointer (channel) + done,
+                                                stage->output.getReadPointer ((int) channel, stage->position),
+                                                (int) num);
+                }
+
+                done += num;
+                stage->position += (int) num;
+
+                if (stage->position == stage->partitionSize)
+                {
+                    stage->job.waitUntilFinished();
+
+                    std::swap (stage->input, stage->pendingInput);
+                    std::swap (stage->output, stage->pendingOutput);
+                    stage->numPendingChannels = (int) numChannels;
+                    stage->position = 0;
+
+                    stage->job.post();
+                    notify();
+                }
+            }
+        }
+    }
+
+private:
+    struct Stage
+    {
+        std::vector<std::unique_ptr<ConvolutionEngine>> engines;
+        AudioBuffer<float> input, pendingInput, output, pendingOutput, scratch;
+        int partitionSize = 0, position = 0, numPendingChannels = 0;
+        BackgroundJob job;
+    };
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            wait (-1);
+
+            for (auto& stage : stages)
+                stage->job.runIfPending ([&stage] { processJob (*stage); });
+        }
+    }
+
+    static void processJob (Stage& stage)
+    {
+        for (auto channel = 0; channel < stage.numPendingChannels; ++channel)
+        {
+            auto& engine = *stage.engines[(size_t) channel];
+
+            engine.processSamplesWithAddedLatency (stage.pendingInput.getReadPointer (channel),
+                                                   stage.scratch.getWritePointer (0),
+                                                   (size_t) stage.partitionSize);
+
+            // Once a whole partition has been processed, the engine's output buffer holds
+            // the output for the next partition, which is what gets played next
+            stage.pendingOutput.copyFrom (channel, 0, engine.getNextOutputBlock(), stage.partitionSize);
+        }
+    }
+
+    std::vector<std::unique_ptr<Stage>> stages;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BackgroundConvolutionStages)
 };
 
 //==============================================================================
@@ -445,15 +814,14 @@ public:
                         int maxBlockSize,
                         int maxBufferSize,
                         Convolution::NonUniform headSizeIn,
+                        const std::optional<Convolution::MultiStage>& multiStage,
                         bool isZeroDelayIn)
-        : tailBuffer (1, maxBlockSize),
+        : tailBuffer (2, maxBlockSize),
           latency (isZeroDelayIn ? 0 : maxBufferSize),
           irSize (buf.getNumSamples()),
           blockSize (maxBlockSize),
           isZeroDelay (isZeroDelayIn)
     {
-        constexpr auto numChannels = 2;
-
         const auto makeEngine = [&] (int channel, int offset, int length, uint32 thisBlockSize)
         {
             return std::make_unique<ConvolutionEngine> (buf.getReadPointer (jmin (buf.getNumChannels() - 1, channel), offset),
@@ -461,22 +829,66 @@ public:
                                                         static_cast<size_t> (thisBlockSize));
         };
 
-        if (headSizeIn.headSizeInSamples == 0)
+        if (multiStage.has_value())
+        {
+            // The multi-stage algorithm always runs with zero latency
+            jassert (isZeroDelay);
+
+            const auto headBlockSize = nextPowerOfTwo (maxBufferSize);
+            const auto headSize = jmin (buf.getNumSamples(), 4 * headBlockSize);
+            const auto maxPartitionSize = jmax (headBlockSize, nextPowerOfTwo (multiStage->maximumPartitionSizeInSamples));
+
+            for (int i = 0; i < numEngineChannels; ++i)
+                head.emplace_back (makeEngine (i, 0, headSize, static_cast<uint32> (maxBufferSize)));
+
+            for (const auto& stage : createStageLayout (buf.getNumSamples(), headSize, maxPartitionSize, multiStage->useBackgroundThread))
+            {
+                // Pad the start of the segment so that the stage's output lines up with its offset
+                const auto padding = stage.offset - stage.latency;
+                AudioBuffer<float> segment (buf.getNumChannels(), padding + stage.length);
+                segment.clear();
+
+                for (int channel = 0; channel < buf.getNumChannels(); ++channel)
+                    segment.copyFrom (channel, padding, buf, channel, stage.offset, stage.length);
+
+                if (stage.runsInBackground)
+                {
+                    if (backgroundStages == nullptr)
+                        backgroundStages = std::make_unique<BackgroundConvolutionStages>();
+
+                    backgroundStages->addStage (segment, numEngineChannels, stage.partitionSize);
+                }
+                else
+                {
+                    for (int i = 0; i < numEngineChannels; ++i)
+                        tail.push_back (std::make_unique<ConvolutionEngine> (segment.getReadPointer (jmin (segment.getNumChannels() - 1, i)),
+                                                                             (size_t) segment.getNumSamples(),
+                                                                             (size_t) stage.partitionSize));
+                }
+            }
+
+            if (backgroundStages != nullptr)
+            {
+                backgroundBuffer.setSize (numEngineChannels, maxBlockSize);
+                backgroundStages->start();
+            }
+        }
+        else if (headSizeIn.headSizeInSamples == 0)
         {
-            for (int i = 0; i < numChannels; ++i)
+            for (int i = 0; i < numEngineChannels; ++i)
                 head.emplace_back (makeEngine (i, 0, buf.getNumSamples(), static_cast<uint32> (maxBufferSize)));
         }
         else
         {
             const auto size = jmin (buf.getNumSamples(), headSizeIn.headSizeInSamples);
 
-            for (int i = 0; i < numChannels; ++i)
+            for (int i = 0; i < numEngineChannels; ++i)
                 head.emplace_back (makeEngine (i, 0, size, static_cast<uint32> (maxBufferSize)));
 
             const auto tailBufferSize = static_cast<uint32> (headSizeIn.headSizeInSamples + (isZeroDelay ? 0 : maxBufferSize));
 
             if (size != buf.getNumSamples())
-                for (int i = 0; i < numChannels; ++i)
+                for (int i = 0; i < numEngineChannels; ++i)
                     tail.emplace_back (makeEngine (i, size, buf.getNumSamples() - size, tailBufferSize));
         }
     }
@@ -488,6 +900,9 @@ public:
 
         for (const auto& e : tail)
             e->reset();
+
+        if (backgroundStages != nullptr)
+            backgroundStages->reset();
     }
 
     void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output)
@@ -496,16 +911,34 @@ public:
         const auto numSamples  = jmin (input.getNumSamples(), output.getNumSamples());
 
         const AudioBlock<float> fullTailBlock (tailBuffer);
-        const auto tailBlock = fullTailBlock.getSubBlock (0, (size_t) numSamples);
+        const auto tailBlock  = fullTailBlock.getSubBlock (0, (size_t) numSamples).getSingleChannelBlock (0);
+        const auto stageBlock = fullTailBlock.getSubBlock (0, (size_t) numSamples).getSingleChannelBlock (1);
+
+        // The input and output may be the same, so the background stages have to read
+        // the input before the head overwrites it
+        const AudioBlock<float> fullBackgroundBlock (backgroundBuffer);
+        auto backgroundBlock = fullBackgroundBlock.getSubBlock (0, (size_t) numSamples);
+
+        if (backgroundStages != nullptr)
+        {
+            backgroundBlock.clear();
+            backgroundStages->processSamples (input, backgroundBlock, numChannels, numSamples);
+        }
 
         const auto isUniform = tail.empty();
 
         for (size_t channel = 0; channel < numChannels; ++channel)
         {
-            if (! isUniform)
-                tail[channel]->processSamplesWithAddedLatency (input.getChannelPointer (channel),
-                                                               tailBlock.getChannelPointer (0),
-                                                               numSamples);
+            // There is one tail engine per channel for each stage
+            for (auto i = channel; i < tail.size(); i += (size_t) numEngineChannels)
+            {
+                tail[i]->processSamplesWithAddedLatency (input.getChannelPointer (channel),
+                                                         (i == channel ? tailBlock : stageBlock).getChannelPointer (0),
+                                                         numSamples);
+
+                if (i != channel)
+                    tailBlock += stageBlock;
+            }
 
             if (isZeroDelay)
                 head[channel]->processSamples (input.getChannelPointer (channel),
@@ -518,6 +951,9 @@ public:
 
             if (! isUniform)
                 output.getSingleChannelBlock (channel) += tailBlock;
+
+            if (backgroundStages != nullptr)
+                output.getSingleChannelBlock (channel) += backgroundBlock.getSingleChannelBlock (channel);
         }
 
         const auto numOutputChannels = output.getNumChannels();
@@ -531,8 +967,11 @@ public:
     int getBlockSize() const noexcept  { return blockSize; }
 
 private:
+    static constexpr int numEngineChannels = 2;
+
     std::vector<std::unique_ptr<ConvolutionEngine>> head, tail;
-    AudioBuffer<float> tailBuffer;
+    std::unique_ptr<BackgroundConvolutionStages> backgroundStages;
+    AudioBuffer<float> tailBuffer, backgroundBuffer;
 
     const int latency;
     const int irSize;
@@ -729,9 +1168,11 @@ class ConvolutionEngineFactory
 {
 public:
     ConvolutionEngineFactory (Convolution::Latency requiredLatency,
-                              Convolution::NonUniform requiredHeadSize)
+                              Convolution::NonUniform requiredHeadSize,
+                              const std::optional<Convolution::MultiStage>& requiredMultiStage)
         : latency  { (requiredLatency.latencyInSamples   <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredLatency.latencyInSamples)) },
           headSize { (requiredHeadSize.headSizeInSamples <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredHeadSize.headSizeInSamples)) },
+          multiStage (requiredMultiStage),
           shouldBeZeroLatency (requiredLatency.latencyInSamples == 0)
     {}
 
@@ -790,6 +1231,7 @@ private:
                                                      processSpec.maximumBlockSize,
                                                      maxBufferSize,
                                                      headSize,
+                                                     multiStage,
                                                      shouldBeZeroLatency);
     }
 
@@ -806,6 +1248,7 @@ private:
     Convolution::Normalise wantsNormalise = Convolution::Normalise::no;
     const Convolution::Latency latency;
     const Convolution::NonUniform headSize;
+    const std::optional<Convolution::MultiStage> multiStage;
     const bool shouldBeZeroLatency;
 
     TryLockedPtr<MultichannelEngine> engine;
@@ -848,8 +1291,9 @@ class ConvolutionEngineQueue final : public std::enable_shared_from_this<Convolu
 public:
     ConvolutionEngineQueue (BackgroundMessageQueue& queue,
                             Convolution::Latency latencyIn,
-                            Convolution::NonUniform headSizeIn)
-        : messageQueue (queue), factory (latencyIn, headSizeIn) {}
+                            Convolution::NonUniform headSizeIn,
+                            const std::optional<Convolution::MultiStage>& multiStageIn)
+        : messageQueue (queue), factory (latencyIn, headSizeIn, multiStageIn) {}
 
     void loadImpulseResponse (AudioBuffer<float>&& buffer,
                               double sr,
@@ -1013,11 +1457,13 @@ class Convolution::Impl
 public:
     Impl (Latency requiredLatency,
           NonUniform requiredHeadSize,
+          const std::optional<MultiStage>& requiredMultiStage,
           OptionalQueue&& queue)
         : messageQueue (std::move (queue)),
           engineQueue (std::make_shared<ConvolutionEngineQueue> (*messageQueue->pimpl,
                                                                  requiredLatency,
-                                                                 requiredHeadSize))
+                                                                 requiredHeadSize,
+                                                                 requiredMultiStage))
     {}
 
     void reset()
@@ -1204,6 +1650,7 @@ Convolution::Convolution (ConvolutionMessageQueue& queue)
 
 Convolution::Convolution (const Latency& requiredLatency)
     : Convolution (requiredLatency,
+                   {},
                    {},
                    OptionalQueue { std::make_unique<ConvolutionMessageQueue>() })
 {}
@@ -1211,21 +1658,34 @@ Convolution::Convolution (const Latency& requiredLatency)
 Convolution::Convolution (const NonUniform& nonUniform)
     : Convolution ({},
                    nonUniform,
+                   {},
+                   OptionalQueue { std::make_unique<ConvolutionMessageQueue>() })
+{}
+
+Convolution::Convolution (const MultiStage& multiStage)
+    : Convolution ({},
+                   {},
+                   multiStage,
                    OptionalQueue { std::make_unique<ConvolutionMessageQueue>() })
 {}
 
 Convolution::Convolution (const Latency& requiredLatency, ConvolutionMessageQueue& queue)
-    : Convolution (requiredLatency, {}, OptionalQueue { queue })
+    : Convolution (requiredLatency, {}, {}, OptionalQueue { queue })
 {}
 
 Convolution::Convolution (const NonUniform& nonUniform, ConvolutionMessageQueue& queue)
-    : Convolution ({}, nonUniform, OptionalQueue { queue })
+    : Convolution ({}, nonUniform, {}, OptionalQueue { queue })
+{}
+
+Convolution::Convolution (const MultiStage& multiStage, ConvolutionMessageQueue& queue)
+    : Convolution ({}, {}, multiStage, OptionalQueue { queue })
 {}
 
 Convolution::Convolution (const Latency& latency,
                           const NonUniform& nonUniform,
+                          const std::optional<MultiStage>& multiStage,
                           OptionalQueue&& queue)
-    : pimpl (std::make_unique<Impl> (latency, nonUniform, std::move (queue)))
+    : pimpl (std::make_unique<Impl> (latency, nonUniform, multiStage, std::move (queue)))
 {}
 
 Convolution::~Convolution() noexcept = default;
@@ -85,8 +85,9 @@ private:
     Note: The default operation of this class uses zero latency and a uniform
     partitioned algorithm. If the impulse response size is large, or if the
     algorithm is too CPU intensive, it is possible to use either a fixed
-    latency version of the algorithm, or a simple non-uniform partitioned
-    convolution algorithm.
+    latency version of the algorithm, a simple non-uniform partitioned
+    convolution algorithm, or a multi-stage non-uniform partitioned algorithm
+    which is best suited to very long impulse responses such as reverbs.
 
     Threading: It is not safe to interleave calls to the methods of this
     class. If you need to load new impulse responses during processing the
@@ -143,6 +144,36 @@ public:
      */
     explicit Convolution (const NonUniform& requiredHeadSize);
 
+    /** Contains configuration information for a multi-stage non-uniform convolution. */
+    struct MultiStage
+    {
+        /** The size of the largest partitions, which are used for the end of the impulse
+            response. This will be rounded up to a power of two.
+        */
+        int maximumPartitionSizeInSamples = 8192;
+
+        /** If true, the stages with large partitions will be computed on a background
+            thread, which spreads their cost evenly across the audio callbacks instead of
+            computing each large partition within a single callback.
+        */
+        bool useBackgroundThread = false;
+    };
+
+    /** Initialises an object for performing zero latency convolution in the frequency
+        domain using a multi-stage non-uniform partitioned algorithm.
+
+        The start of the impulse response is processed with partitions the size of the
+        processing block, and later sections use partitions which grow geometrically up to
+        the maximum partition size. This is much more efficient than uniform partitioning
+        for impulse responses that are many times longer than the block size.
+
+        If the background thread is enabled, the audio thread will only wait for it if it
+        falls behind by a whole partition.
+
+        @param options                the partitioning and threading options
+    */
+    explicit Convolution (const MultiStage& options);
+
     /** Behaves the same as the constructor taking a single Latency argument,
         but with a shared background message queue.
 
@@ -159,6 +190,14 @@ public:
     */
     Convolution (const NonUniform&, ConvolutionMessageQueue&);
 
+    /** Behaves the same as the constructor taking a single MultiStage argument,
+        but with a shared background message queue.
+
+        IMPORTANT: the queue *must* remain alive throughout the lifetime of the
+        Convolution.
+    */
+    Convolution (const MultiStage&, ConvolutionMessageQueue&);
+
     ~Convolution() noexcept;
 
     //==============================================================================
@@ -267,6 +306,7 @@ private:
     //==============================================================================
     Convolution (const Latency&,
                  const NonUniform&,
+                 const std::optional<MultiStage>&,
                  OptionalScopedPointer<ConvolutionMessageQueue>&&);
 
     void processSamples (const AudioBlock<const float>&, AudioBlock<float>&, bool isBypassed) noexcept;
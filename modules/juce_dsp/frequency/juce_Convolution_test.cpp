@@ -120,6 +120,11 @@ class ConvolutionTest final : public UnitTest
 
     void checkLatency (const Convolution&, const Convolution::NonUniform&) {}
 
+    void checkLatency (const Convolution& convolution, const Convolution::MultiStage&)
+    {
+        expect (convolution.getLatency() == 0);
+    }
+
     template <typename ConvolutionConfig>
     void testConvolution (const ProcessSpec& spec,
                           const ConvolutionConfig& config,
@@ -546,6 +551,26 @@ public:
             }
         }
 
+        beginTest ("Multi-stage non-uniform convolutions work");
+        {
+            const auto ramp = makeRamp (static_cast<int> (spec.maximumBlockSize) * 64);
+
+            for (auto useBackgroundThread : { false, true })
+            {
+                for (auto maxPartitionSize : { 4096, 65536 })
+                {
+                    testConvolution (spec,
+                                     Convolution::MultiStage { maxPartitionSize, useBackgroundThread },
+                                     ramp,
+                                     spec.sampleRate,
+                                     Convolution::Stereo::yes,
+                                     Convolution::Trim::no,
+                                     Convolution::Normalise::no,
+                                     ramp);
+                }
+            }
+        }
+
         beginTest ("Convolutions with latency work");
         {
             const auto ramp = makeRamp (static_cast<int> (spec.maximumBlockSize) * 8);
@@ -567,6 +592,52 @@ public:
                                  ramp);
             }
         }
+
+        beginTest ("Engines using the same impulse response share its spectra");
+        {
+            SharedResourcePointer<ImpulseResponseSpectraCache> cache;
+            const auto numInUse = cache->getNumSpectraInUse();
+
+            const auto* samples = impulseData.getReadPointer (0);
+            const auto numSamples = (size_t) impulseData.getNumSamples();
+
+            {
+                ConvolutionEngine a (samples, numSamples, spec.maximumBlockSize);
+                ConvolutionEngine b (samples, numSamples, spec.maximumBlockSize);
+                expect (a.impulseSpectra == b.impulseSpectra);
+                expectEquals (cache->getNumSpectraInUse(), numInUse + 1);
+
+                ConvolutionEngine c (samples, numSamples, spec.maximumBlockSize / 2);
+                ConvolutionEngine d (impulseData.getReadPointer (1), numSamples, spec.maximumBlockSize);
+                expect (a.impulseSpectra != c.impulseSpectra);
+                expect (a.impulseSpectra != d.impulseSpectra);
+                expectEquals (cache->getNumSpectraInUse(), numInUse + 3);
+            }
+
+            expectEquals (cache->getNumSpectraInUse(), numInUse);
+        }
+
+        beginTest ("Impulse responses with the same hash don't share spectra");
+        {
+            SharedResourcePointer<ImpulseResponseSpectraCache> cache;
+
+            // These two impulse responses have the same 64-bit FNV-1a hash
+            const auto makeSamples = [] (std::array<uint32, 3> bits)
+            {
+                std::array<float, 3> result;
+                std::memcpy (result.data(), bits.data(), sizeof (result));
+                return result;
+            };
+
+            const auto a = makeSamples ({ 0x3cd58fb9, 0x3fecb0e8, 0x3f000000 });
+            const auto b = makeSamples ({ 0x3c9a261e, 0x3cd08491, 0x8ea1f544 });
+
+            const auto spectraA = cache->getSpectra (a.data(), a.size(), 4, 8);
+            const auto spectraB = cache->getSpectra (b.data(), b.size(), 4, 8);
+            expect (spectraA != spectraB);
+            expect (spectraA == cache->getSpectra (a.data(), a.size(), 4, 8));
+            expect (spectraB == cache->getSpectra (b.data(), b.size(), 4, 8));
+        }
     }
 };
 
@@ -32,6 +32,30 @@ struct FFT::Instance
     virtual void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept = 0;
     virtual void performRealOnlyForwardTransform (float*, bool) const noexcept = 0;
     virtual void performRealOnlyInverseTransform (float*) const noexcept = 0;
+
+    // Engines can override these when they have a faster way of transforming many frames
+    virtual void performBatch (const Complex<float>* input, Complex<float>* output,
+                               int numFrames, int frameStride, bool inverse) const noexcept
+    {
+        for (int i = 0; i < numFrames; ++i)
+            perform (input + i * frameStride, output + i * frameStride, inverse);
+    }
+
+    virtual void performRealOnlyForwardTransformBatch (float* d, int numFrames, int frameStride,
+                                                       float* /*scratch*/, bool ignoreNegativeFreqs) const noexcept
+    {
+        for (int i = 0; i < numFrames; ++i)
+            performRealOnlyForwardTransform (d + i * frameStride, ignoreNegativeFreqs);
+    }
+
+    virtual void performRealOnlyInverseTransformBatch (float* d, int numFrames, int frameStride,
+                                                       float* /*scratch*/) const noexcept
+    {
+        for (int i = 0; i < numFrames; ++i)
+            performRealOnlyInverseTransform (d + i * frameStride);
+    }
+
+    virtual int getBatchScratchSize() const noexcept    { return 0; }
 };
 
 struct FFT::Engine
@@ -164,6 +188,33 @@ struct FFTFallback final : public FFT::Instance
         }
     }
 
+    void performRealOnlyForwardTransformBatch (float* d, int numFrames, int frameStride,
+                                               float* scratch, bool ignoreNegativeFreqs) const noexcept override
+    {
+        if (scratch == nullptr || size == 1)
+        {
+            FFT::Instance::performRealOnlyForwardTransformBatch (d, numFrames, frameStride, scratch, ignoreNegativeFreqs);
+            return;
+        }
+
+        for (int i = 0; i < numFrames; ++i)
+            performRealOnlyForwardTransform (reinterpret_cast<Complex<float>*> (scratch), d + i * frameStride);
+    }
+
+    void performRealOnlyInverseTransformBatch (float* d, int numFrames, int frameStride, float* scratch) const noexcept override
+    {
+        if (scratch == nullptr || size == 1)
+        {
+            FFT::Instance::performRealOnlyInverseTransformBatch (d, numFrames, frameStride, scratch);
+            return;
+        }
+
+        for (int i = 0; i < numFrames; ++i)
+            performRealOnlyInverseTransform (reinterpret_cast<Complex<float>*> (scratch), d + i * frameStride);
+    }
+
+    int getBatchScratchSize() const noexcept override    { return size * 2; }
+
     void performRealOnlyForwardTransform (Complex<float>* scratch, float* d) const noexcept
     {
         for (int i = 0; i < size; ++i)
@@ -429,6 +480,456 @@ struct FFTFallback final : public FFT::Instance
 
 FFT::EngineImpl<FFTFallback> fftFallback;
 
+//==============================================================================
+//==============================================================================
+#if JUCE_USE_SIMD
+// A radix-4 Stockham FFT that works on separate arrays of real and imaginary parts, so
+// that each butterfly can be computed for a whole SIMDRegister of values at once.
+// Real-only transforms are performed using a complex transform of half the size.
+struct FFTSIMD final : public FFT::Instance
+{
+    // faster than the fallback engine, but slower than any of the platform libraries
+    static constexpr int priority = 0;
+
+    static FFTSIMD* create (int order)
+    {
+        // the fallback engine is good enough for very small transforms
+        if (order < 3)
+            return nullptr;
+
+        return new FFTSIMD (order);
+    }
+
+    explicit FFTSIMD (int order)
+        : size (1 << order),
+          fullTransform (size),
+          halfTransform (size / 2),
+          workspace (allocateAligned (workspaceStorage, (size_t) size * 4)),
+          realTwiddles (allocateAligned (realTwiddleStorage, (size_t) size))
+    {
+        const auto halfSize = size / 2;
+
+        for (int i = 0; i < halfSize; ++i)
+        {
+            const auto phase = -MathConstants<double>::twoPi * i / size;
+            realTwiddles[i]            = (float) std::cos (phase);
+            realTwiddles[i + halfSize] = (float) std::sin (phase);
+        }
+    }
+
+    void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+        performLocked (input, output, inverse);
+    }
+
+    void performRealOnlyForwardTransform (float* d, bool ignoreNegativeFreqs) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+        performRealOnlyForwardTransformLocked (d, ignoreNegativeFreqs);
+    }
+
+    void performRealOnlyInverseTransform (float* d) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+        performRealOnlyInverseTransformLocked (d);
+    }
+
+    // The batch functions only need to take the lock once
+    void performBatch (const Complex<float>* input, Complex<float>* output,
+                       int numFrames, int frameStride, bool inverse) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        for (int i = 0; i < numFrames; ++i)
+            performLocked (input + i * frameStride, output + i * frameStride, inverse);
+    }
+
+    void performRealOnlyForwardTransformBatch (float* d, int numFrames, int frameStride,
+                                               float*, bool ignoreNegativeFreqs) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        for (int i = 0; i < numFrames; ++i)
+            performRealOnlyForwardTransformLocked (d + i * frameStride, ignoreNegativeFreqs);
+    }
+
+    void performRealOnlyInverseTransformBatch (float* d, int numFrames, int frameStride, float*) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        for (int i = 0; i < numFrames; ++i)
+            performRealOnlyInverseTransformLocked (d + i * frameStride);
+    }
+
+private:
+    using Register = SIMDRegister<float>;
+    static constexpr int registerSize = (int) Register::SIMDNumElements;
+
+    //==============================================================================
+    void performLocked (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept
+    {
+        auto* re = workspace;
+        auto* im = re + size;
+        auto* scratchRe = im + size;
+        auto* scratchIm = scratchRe + size;
+
+        for (int i = 0; i < size; ++i)
+        {
+            re[i] = input[i].real();
+            im[i] = input[i].imag();
+        }
+
+        // The inverse transform is the forward transform with the real and imaginary parts swapped
+        const auto resultIsInScratch = inverse ? fullTransform.perform (im, re, scratchIm, scratchRe)
+                                               : fullTransform.perform (re, im, scratchRe, scratchIm);
+
+        const auto* resultRe = resultIsInScratch ? scratchRe : re;
+        const auto* resultIm = resultIsInScratch ? scratchIm : im;
+        const auto scale = inverse ? 1.0f / (float) size : 1.0f;
+
+        for (int i = 0; i < size; ++i)
+            output[i] = { resultRe[i] * scale, resultIm[i] * scale };
+    }
+
+    void performRealOnlyForwardTransformLocked (float* d, bool ignoreNegativeFreqs) const noexcept
+    {
+        const auto halfSize = size / 2;
+        auto* re = workspace;
+        auto* im = re + halfSize;
+        auto* scratchRe = im + halfSize;
+        auto* scratchIm = scratchRe + halfSize;
+
+        // Pack the even samples into the real parts and the odd samples into the imaginary parts
+        for (int i = 0; i < halfSize; ++i)
+        {
+            re[i] = d[2 * i];
+            im[i] = d[2 * i + 1];
+        }
+
+        const auto resultIsInScratch = halfTransform.perform (re, im, scratchRe, scratchIm);
+        const auto* zRe = resultIsInScratch ? scratchRe : re;
+        const auto* zIm = resultIsInScratch ? scratchIm : im;
+        const auto* twRe = realTwiddles;
+        const auto* twIm = realTwiddles + halfSize;
+
+        // Separate the spectra of the even and odd samples, and combine them
+        for (int k = 1; k < halfSize; ++k)
+        {
+            const auto aRe = zRe[k],            aIm = zIm[k];
+            const auto bRe = zRe[halfSize - k], bIm = -zIm[halfSize - k];
+
+            const auto evenRe = 0.5f * (aRe + bRe), evenIm = 0.5f * (aIm + bIm);
+            const auto oddRe  = 0.5f * (aIm - bIm), oddIm  = -0.5f * (aRe - bRe);
+
+            d[2 * k]     = evenRe + oddRe * twRe[k] - oddIm * twIm[k];
+            d[2 * k + 1] = evenIm + oddRe * twIm[k] + oddIm * twRe[k];
+        }
+
+        const auto dc = zRe[0], nyquist = zIm[0];
+
+        d[0] = dc + nyquist;
+        d[1] = 0.0f;
+        d[size] = dc - nyquist;
+        d[size + 1] = 0.0f;
+
+        if (! ignoreNegativeFreqs)
+        {
+            for (int k = 1; k < halfSize; ++k)
+            {
+                d[2 * (size - k)]     =  d[2 * k];
+                d[2 * (size - k) + 1] = -d[2 * k + 1];
+            }
+        }
+    }
+
+    void performRealOnlyInverseTransformLocked (float* d) const noexcept
+    {
+        const auto halfSize = size / 2;
+        auto* re = workspace;
+        auto* im = re + halfSize;
+        auto* scratchRe = im + halfSize;
+        auto* scratchIm = scratchRe + halfSize;
+        const auto* twRe = realTwiddles;
+        const auto* twIm = realTwiddles + halfSize;
+        const auto scale = 1.0f / (float) size;
+
+        // Rebuild the spectrum of the packed even and odd samples, including the scaling
+        for (int k = 0; k < halfSize; ++k)
+        {
+            const auto aRe = d[2 * k],              aIm = d[2 * k + 1];
+            const auto bRe = d[2 * (halfSize - k)], bIm = -d[2 * (halfSize - k) + 1];
+
+            const auto sumRe  = aRe + bRe, sumIm  = aIm + bIm;
+            const auto diffRe = aRe - bRe, diffIm = aIm - bIm;
+
+            const auto oddRe = diffRe * twRe[k] + diffIm * twIm[k];
+            const auto oddIm = diffIm * twRe[k] - diffRe * twIm[k];
+
+            re[k] = (sumRe - oddIm) * scale;
+            im[k] = (sumIm + oddRe) * scale;
+        }
+
+        const auto resultIsInScratch = halfTransform.perform (im, re, scratchIm, scratchRe);
+        const auto* resultRe = resultIsInScratch ? scratchRe : re;
+        const auto* resultIm = resultIsInScratch ? scratchIm : im;
+
+        for (int i = 0; i < halfSize; ++i)
+        {
+            d[2 * i]     = resultRe[i];
+            d[2 * i + 1] = resultIm[i];
+        }
+    }
+
+    static float* allocateAligned (HeapBlock<float>& storage, size_t numElements)
+    {
+        storage.calloc (numElements + Register::SIMDNumElements);
+        return Register::getNextSIMDAlignedPtr (storage.get());
+    }
+
+    // Each table of twiddle factors is padded, so that the next one will be aligned too
+    static int getPaddedSize (int numElements) noexcept     { return (numElements + 15) & ~15; }
+
+    //==============================================================================
+    // A complex forward transform of a fixed size
+    struct Plan
+    {
+        explicit Plan (int sizeToUse)
+            : planSize (sizeToUse)
+        {
+            size_t numTwiddles = 0;
+
+            for (auto n = planSize; n >= 4; n /= 4)
+                numTwiddles += 6 * (size_t) getPaddedSize (n / 4);
+
+            twiddles = allocateAligned (twiddleStorage, numTwiddles);
+
+            auto* tw = twiddles;
+
+            for (auto n = planSize; n >= 4; n /= 4)
+            {
+                const auto m = n / 4, padded = getPaddedSize (m);
+
+                for (int p = 0; p < m; ++p)
+                {
+                    for (int k = 1; k <= 3; ++k)
+                    {
+                        const auto phase = -MathConstants<double>::twoPi * k * p / n;
+                        tw[(2 * k - 2) * padded + p] = (float) std::cos (phase);
+                        tw[(2 * k - 1) * padded + p] = (float) std::sin (phase);
+                    }
+                }
+
+                tw += 6 * padded;
+            }
+        }
+
+        // Transforms the data in (re, im), using (scratchRe, scratchIm) as working space.
+        // Returns true if the result has ended up in the scratch arrays.
+        bool perform (float* re, float* im, float* scratchRe, float* scratchIm) const noexcept
+        {
+            auto resultIsInScratch = false;
+            const auto* tw = twiddles;
+
+            for (int n = planSize, stride = 1; n > 1;)
+            {
+                if (n == 2)
+                {
+                    radix2Stage (stride, re, im, scratchRe, scratchIm);
+                    n = 1;
+                }
+                else
+                {
+                    const auto m = n / 4;
+                    radix4Stage (m, stride, tw, getPaddedSize (m), re, im, scratchRe, scratchIm);
+                    tw += 6 * getPaddedSize (m);
+                    n = m;
+                    stride *= 4;
+                }
+
+                std::swap (re, scratchRe);
+                std::swap (im, scratchIm);
+                resultIsInScratch = ! resultIsInScratch;
+            }
+
+            return resultIsInScratch;
+        }
+
+        //==============================================================================
+        template <typename Type>
+        struct Butterfly
+        {
+            // Computes a radix-4 butterfly on the inputs a, b, c and d, and applies the twiddle
+            // factors w1, w2 and w3 to the last three outputs
+            Butterfly (Type aRe, Type aIm, Type bRe, Type bIm, Type cRe, Type cIm, Type dRe, Type dIm,
+                       const Type (&w)[6]) noexcept
+            {
+                const auto apcRe = aRe + cRe, apcIm = aIm + cIm;
+                const auto amcRe = aRe - cRe, amcIm = aIm - cIm;
+                const auto bpdRe = bRe + dRe, bpdIm = bIm + dIm;
+                const auto bmdRe = bRe - dRe, bmdIm = bIm - dIm;
+
+                outRe[0] = apcRe + bpdRe;
+                outIm[0] = apcIm + bpdIm;
+
+                multiply (amcRe + bmdIm, amcIm - bmdRe, w[0], w[1], outRe[1], outIm[1]);
+                multiply (apcRe - bpdRe, apcIm - bpdIm, w[2], w[3], outRe[2], outIm[2]);
+                multiply (amcRe - bmdIm, amcIm + bmdRe, w[4], w[5], outRe[3], outIm[3]);
+            }
+
+            static void multiply (Type re, Type im, Type wRe, Type wIm, Type& resultRe, Type& resultIm) noexcept
+            {
+                resultRe = re * wRe - im * wIm;
+                resultIm = re * wIm + im * wRe;
+            }
+
+            Type outRe[4], outIm[4];
+        };
+
+        static void radix4Stage (int m, int stride, const float* tw, int padded,
+                                 const float* re, const float* im, float* outRe, float* outIm) noexcept
+        {
+            const auto quarter = m * stride;
+
+            if (stride % registerSize == 0)
+            {
+                // Process neighbouring butterflies, which share the same twiddle factors, together
+                for (int p = 0; p < m; ++p)
+                {
+                    const Register w[] = { Register::expand (tw[p]),              Register::expand (tw[padded + p]),
+                                           Register::expand (tw[2 * padded + p]), Register::expand (tw[3 * padded + p]),
+                                           Register::expand (tw[4 * padded + p]), Register::expand (tw[5 * padded + p]) };
+
+                    for (int q = 0; q < stride; q += registerSize)
+                    {
+                        const auto in = q + stride * p;
+
+                        const Butterfly<Register> b (Register::fromRawArray (re + in),               Register::fromRawArray (im + in),
+                                                     Register::fromRawArray (re + in + quarter),     Register::fromRawArray (im + in + quarter),
+                                                     Register::fromRawArray (re + in + 2 * quarter), Register::fromRawArray (im + in + 2 * quarter),
+                                                     Register::fromRawArray (re + in + 3 * quarter), Register::fromRawArray (im + in + 3 * quarter),
+                                                     w);
+
+                        for (int k = 0; k < 4; ++k)
+                        {
+                            const auto out = q + stride * (4 * p + k);
+                            b.outRe[k].copyToRawArray (outRe + out);
+                            b.outIm[k].copyToRawArray (outIm + out);
+                        }
+                    }
+                }
+            }
+            else if (stride == 1 && m % registerSize == 0)
+            {
+                // In the first stage, the inputs of consecutive butterflies are adjacent, but
+                // their outputs are interleaved
+                alignas (Register) float results[8][registerSize];
+
+                for (int p = 0; p < m; p += registerSize)
+                {
+                    const Register w[] = { Register::fromRawArray (tw + p),              Register::fromRawArray (tw + padded + p),
+                                           Register::fromRawArray (tw + 2 * padded + p), Register::fromRawArray (tw + 3 * padded + p),
+                                           Register::fromRawArray (tw + 4 * padded + p), Register::fromRawArray (tw + 5 * padded + p) };
+
+                    const Butterfly<Register> b (Register::fromRawArray (re + p),         Register::fromRawArray (im + p),
+                                                 Register::fromRawArray (re + p + m),     Register::fromRawArray (im + p + m),
+                                                 Register::fromRawArray (re + p + 2 * m), Register::fromRawArray (im + p + 2 * m),
+                                                 Register::fromRawArray (re + p + 3 * m), Register::fromRawArray (im + p + 3 * m),
+                                                 w);
+
+                    for (int k = 0; k < 4; ++k)
+                    {
+                        b.outRe[k].copyToRawArray (results[k]);
+                        b.outIm[k].copyToRawArray (results[k + 4]);
+                    }
+
+                    for (int j = 0; j < registerSize; ++j)
+                    {
+                        for (int k = 0; k < 4; ++k)
+                        {
+                            outRe[4 * (p + j) + k] = results[k][j];
+                            outIm[4 * (p + j) + k] = results[k + 4][j];
+                        }
+                    }
+                }
+            }
+            else
+            {
+                for (int p = 0; p < m; ++p)
+                {
+                    const float w[] = { tw[p], tw[padded + p], tw[2 * padded + p],
+                                        tw[3 * padded + p], tw[4 * padded + p], tw[5 * padded + p] };
+
+                    for (int q = 0; q < stride; ++q)
+                    {
+                        const auto in = q + stride * p;
+
+                        const Butterfly<float> b (re[in],               im[in],
+                                                  re[in + quarter],     im[in + quarter],
+                                                  re[in + 2 * quarter], im[in + 2 * quarter],
+                                                  re[in + 3 * quarter], im[in + 3 * quarter],
+                                                  w);
+
+                        for (int k = 0; k < 4; ++k)
+                        {
+                            const auto out = q + stride * (4 * p + k);
+                            outRe[out] = b.outRe[k];
+                            outIm[out] = b.outIm[k];
+                        }
+                    }
+                }
+            }
+        }
+
+        static void radix2Stage (int stride, const float* re, const float* im, float* outRe, float* outIm) noexcept
+        {
+            int q = 0;
+
+            if (stride % registerSize == 0)
+            {
+                for (; q < stride; q += registerSize)
+                {
+                    const auto aRe = Register::fromRawArray (re + q),          aIm = Register::fromRawArray (im + q);
+                    const auto bRe = Register::fromRawArray (re + q + stride), bIm = Register::fromRawArray (im + q + stride);
+
+                    (aRe + bRe).copyToRawArray (outRe + q);
+                    (aIm + bIm).copyToRawArray (outIm + q);
+                    (aRe - bRe).copyToRawArray (outRe + q + stride);
+                    (aIm - bIm).copyToRawArray (outIm + q + stride);
+                }
+            }
+
+            for (; q < stride; ++q)
+            {
+                const auto aRe = re[q],          aIm = im[q];
+                const auto bRe = re[q + stride], bIm = im[q + stride];
+
+                outRe[q] = aRe + bRe;
+                outIm[q] = aIm + bIm;
+                outRe[q + stride] = aRe - bRe;
+                outIm[q + stride] = aIm - bIm;
+            }
+        }
+
+        const int planSize;
+        HeapBlock<float> twiddleStorage;
+        float* twiddles = nullptr;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Plan)
+    };
+
+    //==============================================================================
+    const int size;
+    const Plan fullTransform, halfTransform;
+    SpinLock processLock;
+    HeapBlock<float> workspaceStorage, realTwiddleStorage;
+    float* const workspace;
+    float* const realTwiddles;
+};
+
+FFT::EngineImpl<FFTSIMD> fftSIMD;
+#endif
+
 //==============================================================================
 //==============================================================================
 #if (JUCE_MAC || JUCE_IOS) && JUCE_USE_VDSP_FRAMEWORK
@@ -995,4 +1496,62 @@ void FFT::performFrequencyOnlyForwardTransform (float* inputOutputData, bool ign
     zeromem (inputOutputData + limit, static_cast<size_t> (size * 2 - limit) * sizeof (float));
 }
 
+//==============================================================================
+void FFT::performBatch (const Complex<float>* input, Complex<float>* output,
+                        int numFrames, int frameStride, bool inverse) const noexcept
+{
+    jassert (frameStride >= size);
+
+    if (engine != nullptr)
+        engine->performBatch (input, output, numFrames, frameStride, inverse);
+}
+
+void FFT::performRealOnlyForwardTransformBatch (float* inputOutputData, int numFrames, int frameStride,
+                                                float* scratch, bool ignoreNegativeFreqs) const noexcept
+{
+    jassert (frameStride >= size * 2);
+
+    if (engine != nullptr)
+        engine->performRealOnlyForwardTransformBatch (inputOutputData, numFrames, frameStride, scratch, ignoreNegativeFreqs);
+}
+
+void FFT::performRealOnlyInverseTransformBatch (float* inputOutputData, int numFrames, int frameStride,
+                                                float* scratch) const noexcept
+{
+    jassert (frameStride >= size * 2);
+
+    if (engine != nullptr)
+        engine->performRealOnlyInverseTransformBatch (inputOutputData, numFrames, frameStride, scratch);
+}
+
+int FFT::getBatchScratchSize() const noexcept
+{
+    return engine != nullptr ? engine->getBatchScratchSize() : 0;
+}
+
+void FFT::performTwoDimensional (const FFT& rowFFT, const FFT& columnFFT,
+                                 const Complex<float>* input, Complex<float>* output,
+                                 Complex<float>* scratch, bool inverse) noexcept
+{
+    const auto numColumns = rowFFT.getSize();
+    const auto numRows = columnFFT.getSize();
+
+    const auto transpose = [] (const Complex<float>* source, Complex<float>* dest, int sourceRows, int sourceColumns)
+    {
+        // Work in tiles, so that both the reads and the writes stay in the cache
+        constexpr int tileSize = 16;
+
+        for (int row = 0; row < sourceRows; row += tileSize)
+            for (int column = 0; column < sourceColumns; column += tileSize)
+                for (int r = row; r < jmin (row + tileSize, sourceRows); ++r)
+                    for (int c = column; c < jmin (column + tileSize, sourceColumns); ++c)
+                        dest[c * sourceRows + r] = source[r * sourceColumns + c];
+    };
+
+    rowFFT.performBatch (input, scratch, numRows, numColumns, inverse);
+    transpose (scratch, output, numRows, numColumns);
+    columnFFT.performBatch (output, scratch, numColumns, numRows, inverse);
+    transpose (scratch, output, numColumns, numRows);
+}
+
 } // namespace juce::dsp
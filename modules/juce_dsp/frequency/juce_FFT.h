@@ -29,9 +29,10 @@ namespace juce::dsp
 /**
     Performs a fast fourier transform.
 
-    This is only a simple low-footprint implementation and isn't tuned for speed - it may
-    be useful for simple applications where one of the more complex FFT libraries would be
-    overkill. (But in the future it may end up becoming optimised of course...)
+    The transform is performed by the fastest engine available on the platform: vDSP on
+    Apple platforms, or FFTW, Intel MKL or IPP when they have been enabled. Otherwise a
+    built-in engine is used, which is vectorised with SIMDRegister when JUCE_USE_SIMD is
+    enabled.
 
     The FFT class itself contains lookup tables, so there's some overhead in creating
     one, you should create and cache an FFT object for each size/direction of transform
@@ -105,6 +106,70 @@ public:
     void performFrequencyOnlyForwardTransform (float* inputOutputData,
                                                bool onlyCalculateNonNegativeFrequencies = false) const noexcept;
 
+    //==============================================================================
+    /** Performs out-of-place FFTs on a number of frames, either forward or inverse.
+
+        Each frame starts frameStride elements after the previous one in both the input
+        and output arrays, so frameStride must be at least getSize(). Use getSize() for
+        frames that are packed together.
+
+        This gives the same results as calling perform() on each frame, but avoids
+        some of the overhead of doing so.
+    */
+    void performBatch (const Complex<float>* input,
+                       Complex<float>* output,
+                       int numFrames,
+                       int frameStride,
+                       bool inverse) const noexcept;
+
+    /** Performs in-place forward transforms on a number of frames of real data.
+
+        Each frame is laid out as for performRealOnlyForwardTransform(), and starts
+        frameStride floats after the previous one, so frameStride must be at least
+        2 * getSize().
+
+        If scratch isn't nullptr, it must point to at least getBatchScratchSize() floats,
+        and will be used as working space so that no memory is allocated. If it's nullptr,
+        some engines may need to allocate memory for large transforms.
+
+        @see performRealOnlyForwardTransform, getBatchScratchSize
+    */
+    void performRealOnlyForwardTransformBatch (float* inputOutputData,
+                                               int numFrames,
+                                               int frameStride,
+                                               float* scratch = nullptr,
+                                               bool onlyCalculateNonNegativeFrequencies = false) const noexcept;
+
+    /** Performs in-place inverse transforms on a number of frames of data created by
+        performRealOnlyForwardTransform() or performRealOnlyForwardTransformBatch().
+
+        The frames and the scratch space are laid out as for performRealOnlyForwardTransformBatch().
+
+        @see performRealOnlyInverseTransform, getBatchScratchSize
+    */
+    void performRealOnlyInverseTransformBatch (float* inputOutputData,
+                                               int numFrames,
+                                               int frameStride,
+                                               float* scratch = nullptr) const noexcept;
+
+    /** Returns the number of floats of scratch space that the batch functions need in order
+        to avoid allocating memory. This may be 0.
+    */
+    int getBatchScratchSize() const noexcept;
+
+    /** Performs an out-of-place two-dimensional FFT, either forward or inverse.
+
+        The data is stored in row-major order, with columnFFT.getSize() rows of
+        rowFFT.getSize() elements each. The input, output and scratch arrays must each hold
+        rowFFT.getSize() * columnFFT.getSize() elements, and must not overlap.
+    */
+    static void performTwoDimensional (const FFT& rowFFT,
+                                       const FFT& columnFFT,
+                                       const Complex<float>* input,
+                                       Complex<float>* output,
+                                       Complex<float>* scratch,
+                                       bool inverse) noexcept;
+
     /** Returns the number of data points that this FFT was created to work with. */
     int getSize() const noexcept            { return size; }
 
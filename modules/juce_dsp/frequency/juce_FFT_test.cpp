@@ -194,6 +194,196 @@ struct FFTUnitTest final : public UnitTest
         }
     };
 
+    struct BatchTest
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+            constexpr int numFrames = 5;
+
+            for (int order = 0; order <= 10; ++order)
+            {
+                const auto n = 1 << order;
+                FFT fft (order);
+
+                {
+                    const auto stride = n + 3;
+                    HeapBlock<Complex<float>> input ((size_t) (stride * numFrames)), expected ((size_t) (stride * numFrames), true), output ((size_t) (stride * numFrames), true);
+                    fillRandom (random, input.getData(), (size_t) (stride * numFrames));
+
+                    for (auto inverse : { false, true })
+                    {
+                        for (int i = 0; i < numFrames; ++i)
+                            fft.perform (input + i * stride, expected + i * stride, inverse);
+
+                        fft.performBatch (input, output, numFrames, stride, inverse);
+                        u.expect (checkArrayIsSimilar (expected.getData(), output.getData(), (size_t) (stride * numFrames)));
+                    }
+                }
+
+                const auto stride = n * 2 + 5;
+                std::vector<float> input ((size_t) (stride * numFrames));
+                std::vector<float> scratch ((size_t) fft.getBatchScratchSize());
+                fillRandom (random, input.data(), input.size());
+
+                for (auto* scratchToUse : { static_cast<float*> (nullptr), scratch.data() })
+                {
+                    auto expected = input, output = input;
+
+                    for (int i = 0; i < numFrames; ++i)
+                        fft.performRealOnlyForwardTransform (expected.data() + i * stride);
+
+                    fft.performRealOnlyForwardTransformBatch (output.data(), numFrames, stride, scratchToUse);
+                    u.expect (checkArrayIsSimilar (expected.data(), output.data(), output.size()));
+
+                    fft.performRealOnlyInverseTransformBatch (output.data(), numFrames, stride, scratchToUse);
+
+                    for (int i = 0; i < numFrames; ++i)
+                        u.expect (checkArrayIsSimilar (input.data() + i * stride, output.data() + i * stride, (size_t) n));
+                }
+            }
+        }
+    };
+
+    struct TwoDimensionalTest
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            for (auto [rowOrder, columnOrder] : { std::pair (3, 2), std::pair (2, 5), std::pair (4, 4) })
+            {
+                const auto numColumns = 1 << rowOrder, numRows = 1 << columnOrder;
+                const auto numElements = (size_t) (numColumns * numRows);
+
+                FFT rowFFT (rowOrder), columnFFT (columnOrder);
+
+                HeapBlock<Complex<float>> input (numElements), output (numElements), scratch (numElements),
+                                          reference (numElements), roundTrip (numElements);
+
+                fillRandom (random, input.getData(), numElements);
+
+                for (int row = 0; row < numRows; ++row)
+                {
+                    for (int column = 0; column < numColumns; ++column)
+                    {
+                        Complex<float> sum;
+
+                        for (int r = 0; r < numRows; ++r)
+                        {
+                            for (int c = 0; c < numColumns; ++c)
+                            {
+                                const auto phase = -MathConstants<double>::twoPi * ((double) (row * r) / numRows + (double) (column * c) / numColumns);
+                                sum += input[r * numColumns + c] * Complex<float> ((float) std::cos (phase), (float) std::sin (phase));
+                            }
+                        }
+
+                        reference[row * numColumns + column] = sum;
+                    }
+                }
+
+                FFT::performTwoDimensional (rowFFT, columnFFT, input, output, scratch, false);
+                u.expect (checkArrayIsSimilar (reference.getData(), output.getData(), numElements));
+
+                FFT::performTwoDimensional (rowFFT, columnFFT, output, roundTrip, scratch, true);
+                u.expect (checkArrayIsSimilar (input.getData(), roundTrip.getData(), numElements));
+            }
+        }
+    };
+
+   #if JUCE_USE_SIMD
+    struct SIMDEngineTest
+    {
+        template <typename Type>
+        static float getMaxDifference (const Type* a, const Type* b, size_t n) noexcept
+        {
+            float result = 0.0f;
+
+            for (size_t i = 0; i < n; ++i)
+                result = jmax (result, std::abs (a[i] - b[i]));
+
+            return result;
+        }
+
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            for (int order = 3; order <= 14; ++order)
+            {
+                const auto n = (size_t) 1 << order;
+                const auto tolerance = 1.0e-4f * std::sqrt ((float) n);
+
+                FFTSIMD simd (order);
+                FFTFallback fallback (order);
+
+                HeapBlock<Complex<float>> input (n), expected (n), output (n);
+                fillRandom (random, input.getData(), n);
+
+                for (auto inverse : { false, true })
+                {
+                    fallback.perform (input, expected, inverse);
+                    simd.perform (input, output, inverse);
+                    u.expectLessThan (getMaxDifference (expected.getData(), output.getData(), n), tolerance);
+                }
+
+                std::vector<float> real (n * 2), expectedReal (n * 2), outputReal (n * 2);
+                fillRandom (random, real.data(), n);
+
+                for (auto ignoreNegative : { false, true })
+                {
+                    expectedReal = outputReal = real;
+                    fallback.performRealOnlyForwardTransform (expectedReal.data(), ignoreNegative);
+                    simd.performRealOnlyForwardTransform (outputReal.data(), ignoreNegative);
+
+                    const auto numToCompare = ignoreNegative ? n + 2 : n * 2;
+                    u.expectLessThan (getMaxDifference (expectedReal.data(), outputReal.data(), numToCompare), tolerance);
+                }
+
+                simd.performRealOnlyInverseTransform (outputReal.data());
+                u.expectLessThan (getMaxDifference (real.data(), outputReal.data(), n), 1.0e-5f * (float) order);
+            }
+        }
+    };
+
+    struct SIMDEngineBenchmark
+    {
+        template <typename Engine>
+        static double timeRealTransforms (const Engine& engine, std::vector<float>& data, int numRepeats)
+        {
+            const auto start = Time::getMillisecondCounterHiRes();
+
+            for (int i = 0; i < numRepeats; ++i)
+            {
+                engine.performRealOnlyForwardTransform (data.data(), true);
+                engine.performRealOnlyInverseTransform (data.data());
+            }
+
+            return (Time::getMillisecondCounterHiRes() - start) * 1000.0 / numRepeats;
+        }
+
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            for (auto order : { 6, 9, 12, 15 })
+            {
+                const auto n = (size_t) 1 << order;
+                const auto numRepeats = jmax (10, (1 << 20) >> order);
+
+                std::vector<float> data (n * 2);
+                fillRandom (random, data.data(), n);
+
+                const auto fallbackTime = timeRealTransforms (FFTFallback (order), data, numRepeats);
+                const auto simdTime     = timeRealTransforms (FFTSIMD (order), data, numRepeats);
+
+                u.logMessage ("Real transform pair of size " + String (n) + ": fallback " + String (fallbackTime, 2)
+                                + " us, SIMD " + String (simdTime, 2) + " us");
+            }
+        }
+    };
+   #endif
+
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
     {
@@ -207,6 +397,13 @@ struct FFTUnitTest final : public UnitTest
         runTestForAllTypes<RealTest> ("Real input numbers Test");
         runTestForAllTypes<FrequencyOnlyTest> ("Frequency only Test");
         runTestForAllTypes<ComplexTest> ("Complex input numbers Test");
+        runTestForAllTypes<BatchTest> ("Batch Test");
+        runTestForAllTypes<TwoDimensionalTest> ("Two dimensional Test");
+
+       #if JUCE_USE_SIMD
+        runTestForAllTypes<SIMDEngineTest> ("SIMD engine matches the fallback engine");
+        runTestForAllTypes<SIMDEngineBenchmark> ("SIMD engine benchmark");
+       #endif
     }
 };
 
@@ -0,0 +1,232 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+//==============================================================================
+// Transforms the frames on a background thread. A job is started at the end of each hop,
+// and its output is what gets played during the hop after that.
+class STFTProcessor::Worker  : private Thread
+{
+public:
+    explicit Worker (STFTProcessor& processorToUse)
+        : Thread ("STFT processor"), processor (processorToUse)
+    {
+        startThread (Priority::high);
+    }
+
+    ~Worker() override
+    {
+        signalThreadShouldExit();
+        notify();
+        stopThread (-1);
+    }
+
+    void startJob() noexcept
+    {
+        job.post();
+        notify();
+    }
+
+    void waitForJob() noexcept
+    {
+        job.waitUntilFinished();
+    }
+
+private:
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            wait (-1);
+            job.runIfPending ([this] { processor.transformFrames (processor.pendingOutputs); });
+        }
+    }
+
+    STFTProcessor& processor;
+    BackgroundJob job;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+};
+
+//==============================================================================
+STFTProcessor::STFTProcessor (const Settings& settings, SpectrumCallback callbackToUse)
+    : frameSize (1 << settings.fftOrder),
+      hopSize (frameSize / jlimit (1, frameSize, settings.overlap)),
+      useBackgroundThread (settings.useBackgroundThread),
+      callback (std::move (callbackToUse)),
+      fft (settings.fftOrder),
+      window ((size_t) frameSize),
+      outputGain ((size_t) hopSize)
+{
+    // The overlap must be a power of two, so that the hops fit exactly into each frame
+    jassert (isPowerOfTwo (settings.overlap) && settings.overlap <= frameSize);
+
+    WindowingFunction<float>::fillWindowingTables (window.data(), window.size(), settings.window, false);
+
+    // Each output sample is the sum of the overlapping frames, which have each been
+    // windowed twice. Dividing by the sum of the squared windows undoes this exactly.
+    for (int i = 0; i < hopSize; ++i)
+    {
+        auto sum = 0.0f;
+
+        for (auto offset = i; offset < frameSize; offset += hopSize)
+            sum += window[(size_t) offset] * window[(size_t) offset];
+
+        // If this fails, the window is zero at some point in every frame, so the input
+        // can't be reconstructed. Try using more overlap.
+        jassert (sum > 1.0e-6f);
+
+        outputGain[(size_t) i] = sum > 1.0e-6f ? 1.0f / sum : 0.0f;
+    }
+}
+
+STFTProcessor::~STFTProcessor() = default;
+
+//==============================================================================
+void STFTProcessor::prepare (const ProcessSpec& spec)
+{
+    worker.reset();
+
+    numChannels = (int) spec.numChannels;
+
+    for (auto* buffer : { &inputFrames, &accumulators })
+        buffer->setSize (numChannels, frameSize);
+
+    for (auto* buffer : { &outputs, &pendingOutputs })
+        buffer->setSize (numChannels, hopSize);
+
+    frames.resize ((size_t) (numChannels * frameSize * 2));
+    scratch.resize ((size_t) fft.getBatchScratchSize());
+
+    reset();
+
+    if (useBackgroundThread)
+        worker = std::make_unique<Worker> (*this);
+}
+
+void STFTProcessor::reset() noexcept
+{
+    if (worker != nullptr)
+        worker->waitForJob();
+
+    for (auto* buffer : { &inputFrames, &accumulators, &outputs, &pendingOutputs })
+        buffer->clear();
+
+    position = 0;
+}
+
+//==============================================================================
+void STFTProcessor::processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output, bool isBypassed) noexcept
+{
+    jassert (input.getNumSamples() == output.getNumSamples());
+    jassert (input.getNumChannels() <= (size_t) numChannels && output.getNumChannels() <= (size_t) numChannels);
+
+    const auto numSamples = output.getNumSamples();
+    const auto numChannelsToUse = (int) jmin (input.getNumChannels(), output.getNumChannels(), (size_t) numChannels);
+
+    for (size_t done = 0; done < numSamples;)
+    {
+        const auto num = jmin (numSamples - done, (size_t) (hopSize - position));
+
+        for (int channel = 0; channel < numChannelsToUse; ++channel)
+        {
+            // The input is read before the output is written, in case they're the same block
+            FloatVectorOperations::copy (inputFrames.getWritePointer (channel, frameSize - hopSize + position),
+                                         input.getChannelPointer ((size_t) channel) + done,
+                                         (int) num);
+            FloatVectorOperations::copy (output.getChannelPointer ((size_t) channel) + done,
+                                         outputs.getReadPointer (channel, position),
+                                         (int) num);
+        }
+
+        done += num;
+        position += (int) num;
+
+        if (position == hopSize)
+        {
+            if (worker != nullptr)
+            {
+                worker->waitForJob();
+                std::swap (outputs, pendingOutputs);
+            }
+
+            frameIsBypassed = isBypassed;
+            startFrame();
+            position = 0;
+
+            if (worker != nullptr)
+                worker->startJob();
+            else
+                transformFrames (outputs);
+        }
+    }
+}
+
+void STFTProcessor::startFrame() noexcept
+{
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* frame = frames.data() + channel * frameSize * 2;
+        auto* samples = inputFrames.getWritePointer (channel);
+
+        FloatVectorOperations::multiply (frame, samples, window.data(), frameSize);
+
+        // Make room for the next hop
+        std::memmove (samples, samples + hopSize, (size_t) (frameSize - hopSize) * sizeof (float));
+    }
+}
+
+void STFTProcessor::transformFrames (AudioBuffer<float>& destination) noexcept
+{
+    const auto frameStride = frameSize * 2;
+    auto* scratchData = scratch.empty() ? nullptr : scratch.data();
+
+    fft.performRealOnlyForwardTransformBatch (frames.data(), numChannels, frameStride, scratchData, true);
+
+    if (! frameIsBypassed && callback != nullptr)
+        for (int channel = 0; channel < numChannels; ++channel)
+            callback (channel, reinterpret_cast<Complex<float>*> (frames.data() + channel * frameStride), frameSize / 2 + 1);
+
+    fft.performRealOnlyInverseTransformBatch (frames.data(), numChannels, frameStride, scratchData);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* frame = frames.data() + channel * frameStride;
+        auto* accumulator = accumulators.getWritePointer (channel);
+
+        FloatVectorOperations::multiply (frame, window.data(), frameSize);
+        FloatVectorOperations::add (accumulator, frame, frameSize);
+
+        // The first hop of the accumulator won't receive any more frames, so it's complete
+        FloatVectorOperations::multiply (destination.getWritePointer (channel), accumulator, outputGain.data(), hopSize);
+
+        std::memmove (accumulator, accumulator + hopSize, (size_t) (frameSize - hopSize) * sizeof (float));
+        FloatVectorOperations::clear (accumulator + frameSize - hopSize, hopSize);
+    }
+}
+
+} // namespace juce::dsp
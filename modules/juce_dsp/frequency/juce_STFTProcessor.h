@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+/**
+    Performs short-time Fourier transform processing on a stream of audio.
+
+    The incoming audio is split into overlapping frames, each of which is windowed and
+    transformed into the frequency domain. The spectrum of each frame is passed to a
+    callback, which may modify it, and is then transformed back, windowed again, and
+    overlap-added into the output.
+
+    The window is applied both before and after the callback, and the output is scaled
+    so that if the callback leaves the spectra unchanged, the output is exactly the
+    input delayed by getLatency() samples.
+
+    The callback is called on the audio thread, or on a background thread if
+    Settings::useBackgroundThread is set, and it must not allocate or block. The
+    processor itself doesn't allocate any memory outside of prepare().
+
+    @code
+    STFTProcessor stft ({}, [] (int, Complex<float>* bins, int numBins)
+    {
+        // Remove everything below the fourth bin
+        std::fill (bins, bins + jmin (4, numBins), Complex<float>{});
+    });
+
+    stft.prepare (spec);
+    stft.process (ProcessContextReplacing<float> (block));
+    @endcode
+
+    @tags{DSP}
+*/
+class JUCE_API  STFTProcessor
+{
+public:
+    //==============================================================================
+    /** The configuration of the transform. */
+    struct Settings
+    {
+        /** The size of each frame will be 2 ^ fftOrder. */
+        int fftOrder = 11;
+
+        /** The number of frames that overlap each sample. This must be a power of two,
+            no larger than the frame size, and the hop between frames will be the frame
+            size divided by this. Tapered windows need an overlap of at least 2.
+        */
+        int overlap = 4;
+
+        /** The window applied before and after each transform. */
+        WindowingFunction<float>::WindowingMethod window = WindowingFunction<float>::hann;
+
+        /** If this is true, the frames will be transformed on a background thread,
+            which adds one hop of latency. This can avoid overloading individual audio
+            callbacks when the frames are large compared to the block size.
+        */
+        bool useBackgroundThread = false;
+    };
+
+    /** A function which processes the spectrum of one channel of a frame in place.
+        The spectrum holds numBins = (frame size / 2) + 1 bins, from DC up to Nyquist.
+    */
+    using SpectrumCallback = std::function<void (int channel, Complex<float>* spectrum, int numBins)>;
+
+    //==============================================================================
+    /** Creates a processor with the given settings, which will pass each spectrum to
+        the callback.
+    */
+    STFTProcessor (const Settings& settings, SpectrumCallback callback);
+
+    /** Destructor. */
+    ~STFTProcessor();
+
+    //==============================================================================
+    /** Prepares the processor. This allocates all the memory that will be needed. */
+    void prepare (const ProcessSpec&);
+
+    /** Clears the processor's internal state. */
+    void reset() noexcept;
+
+    /** Processes a block of samples. If the context is bypassed, the spectra will be
+        left unchanged, so the output will be the input delayed by getLatency() samples.
+    */
+    template <typename ProcessContext,
+              std::enable_if_t<std::is_same_v<typename ProcessContext::SampleType, float>, int> = 0>
+    void process (const ProcessContext& context) noexcept
+    {
+        processSamples (context.getInputBlock(), context.getOutputBlock(), context.isBypassed);
+    }
+
+    //==============================================================================
+    /** Returns the number of samples in each frame. */
+    int getFrameSize() const noexcept                   { return frameSize; }
+
+    /** Returns the number of samples between the starts of consecutive frames. */
+    int getHopSize() const noexcept                     { return hopSize; }
+
+    /** Returns the number of samples by which the output is delayed. This is the frame
+        size, plus one hop when a background thread is used.
+    */
+    int getLatency() const noexcept                     { return frameSize + (useBackgroundThread ? hopSize : 0); }
+
+private:
+    //==============================================================================
+    void processSamples (const AudioBlock<const float>&, AudioBlock<float>&, bool isBypassed) noexcept;
+    void startFrame() noexcept;
+    void transformFrames (AudioBuffer<float>& destination) noexcept;
+
+    class Worker;
+
+    const int frameSize, hopSize;
+    const bool useBackgroundThread;
+    const SpectrumCallback callback;
+    const FFT fft;
+
+    std::vector<float> window, outputGain;
+    AudioBuffer<float> inputFrames, accumulators, outputs, pendingOutputs;
+    std::vector<float> frames, scratch;
+    int numChannels = 0, position = 0;
+    bool frameIsBypassed = false;
+    std::unique_ptr<Worker> worker;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (STFTProcessor)
+};
+
+} // namespace juce::dsp
@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_ENABLE_ALLOCATION_HOOKS
+#define JUCE_FAIL_ON_ALLOCATION_IN_SCOPE const UnitTestAllocationChecker checker (*this)
+#else
+#define JUCE_FAIL_ON_ALLOCATION_IN_SCOPE
+#endif
+
+namespace juce::dsp
+{
+
+class STFTProcessorTest final : public UnitTest
+{
+public:
+    STFTProcessorTest()
+        : UnitTest ("STFTProcessor", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        const ProcessSpec spec { 44100.0, 100, 2 };
+
+        AudioBuffer<float> input (2, 8192);
+        Random random (378272);
+
+        for (auto channel = 0; channel < input.getNumChannels(); ++channel)
+            for (auto sample = 0; sample < input.getNumSamples(); ++sample)
+                input.setSample (channel, sample, random.nextFloat() * 2.0f - 1.0f);
+
+        beginTest ("Unchanged spectra reconstruct the delayed input");
+        {
+            for (auto useBackgroundThread : { false, true })
+            {
+                for (auto [order, overlap, window] : { std::tuple (9,  4, WindowingFunction<float>::hann),
+                                                       std::tuple (6,  2, WindowingFunction<float>::hann),
+                                                       std::tuple (10, 8, WindowingFunction<float>::blackmanHarris),
+                                                       std::tuple (8,  1, WindowingFunction<float>::rectangular) })
+                {
+                    STFTProcessor stft ({ order, overlap, window, useBackgroundThread }, nullptr);
+                    const auto output = process (stft, spec, input, false);
+                    expectDelayedCopy (output, input, stft.getLatency());
+                }
+            }
+        }
+
+        beginTest ("Spectra can be modified");
+        {
+            for (auto useBackgroundThread : { false, true })
+            {
+                std::atomic<int> numCalls { 0 };
+
+                STFTProcessor stft ({ 9, 4, WindowingFunction<float>::hann, useBackgroundThread },
+                                    [&] (int channel, Complex<float>* spectrum, int numBins)
+                                    {
+                                        expect (isPositiveAndBelow (channel, 2));
+                                        expectEquals (numBins, 257);
+                                        std::fill (spectrum, spectrum + numBins, Complex<float>{});
+                                        ++numCalls;
+                                    });
+
+                const auto output = process (stft, spec, input, false);
+                expectEquals (output.getMagnitude (0, output.getNumSamples()), 0.0f);
+                expectGreaterThan (numCalls.load(), 0);
+            }
+        }
+
+        beginTest ("Bypassed processing leaves spectra unchanged");
+        {
+            STFTProcessor stft ({}, [] (int, Complex<float>* spectrum, int numBins)
+            {
+                std::fill (spectrum, spectrum + numBins, Complex<float>{});
+            });
+
+            const auto output = process (stft, spec, input, true);
+            expectDelayedCopy (output, input, stft.getLatency());
+        }
+
+        beginTest ("Latency includes a hop when using a background thread");
+        {
+            expectEquals (STFTProcessor ({ 10, 4 }, nullptr).getLatency(), 1024);
+            expectEquals (STFTProcessor ({ 10, 4, WindowingFunction<float>::hann, true }, nullptr).getLatency(), 1024 + 256);
+        }
+    }
+
+private:
+    AudioBuffer<float> process (STFTProcessor& stft, const ProcessSpec& spec, const AudioBuffer<float>& input, bool isBypassed)
+    {
+        stft.prepare (spec);
+
+        auto output = input;
+        const auto blockSize = (int) spec.maximumBlockSize;
+
+        JUCE_FAIL_ON_ALLOCATION_IN_SCOPE;
+
+        for (auto start = 0; start < output.getNumSamples(); start += blockSize)
+        {
+            auto block = AudioBlock<float> (output).getSubBlock ((size_t) start, (size_t) jmin (blockSize, output.getNumSamples() - start));
+            ProcessContextReplacing<float> context (block);
+            context.isBypassed = isBypassed;
+            stft.process (context);
+        }
+
+        return output;
+    }
+
+    void expectDelayedCopy (const AudioBuffer<float>& output, const AudioBuffer<float>& input, int latency)
+    {
+        auto maxError = 0.0f;
+
+        for (auto channel = 0; channel < output.getNumChannels(); ++channel)
+        {
+            for (auto sample = 0; sample < output.getNumSamples(); ++sample)
+            {
+                const auto expected = sample >= latency ? input.getSample (channel, sample - latency) : 0.0f;
+                maxError = jmax (maxError, std::abs (output.getSample (channel, sample) - expected));
+            }
+        }
+
+        expectLessThan (maxError, 1.0e-4f);
+    }
+};
+
+static STFTProcessorTest stftProcessorTest;
+
+} // namespace juce::dsp
+
+#undef JUCE_FAIL_ON_ALLOCATION_IN_SCOPE
@@ -56,9 +56,11 @@
 
 #include "processors/juce_FIRFilter.cpp"
 #include "processors/juce_IIRFilter.cpp"
+#include "processors/juce_IIRMultiChannelCascade.cpp"
 #include "processors/juce_FirstOrderTPTFilter.cpp"
 #include "processors/juce_Panner.cpp"
 #include "processors/juce_Oversampling.cpp"
+#include "processors/juce_PolyphaseResampler.cpp"
 #include "processors/juce_BallisticsFilter.cpp"
 #include "processors/juce_LinkwitzRileyFilter.cpp"
 #include "processors/juce_DelayLine.cpp"
@@ -67,9 +69,11 @@
 #include "maths/juce_SpecialFunctions.cpp"
 #include "maths/juce_Matrix.cpp"
 #include "maths/juce_LookupTable.cpp"
+#include "frequency/juce_BackgroundJob.h"
 #include "frequency/juce_FFT.cpp"
 #include "frequency/juce_Convolution.cpp"
 #include "frequency/juce_Windowing.cpp"
+#include "frequency/juce_STFTProcessor.cpp"
 #include "filter_design/juce_FilterDesign.cpp"
 #include "widgets/juce_LadderFilter.cpp"
 #include "widgets/juce_Compressor.cpp"
@@ -103,6 +107,11 @@
  #include "containers/juce_AudioBlock_test.cpp"
  #include "frequency/juce_Convolution_test.cpp"
  #include "frequency/juce_FFT_test.cpp"
+ #include "frequency/juce_STFTProcessor_test.cpp"
+ #include "processors/juce_DelayLine_test.cpp"
  #include "processors/juce_FIRFilter_test.cpp"
+ #include "processors/juce_IIRMultiChannelCascade_test.cpp"
+ #include "processors/juce_Oversampling_test.cpp"
+ #include "processors/juce_PolyphaseResampler_test.cpp"
  #include "processors/juce_ProcessorChain_test.cpp"
 #endif
@@ -255,12 +255,14 @@ namespace util
 #include "processors/juce_ProcessorDuplicator.h"
 #include "processors/juce_IIRFilter.h"
 #include "processors/juce_IIRFilter_Impl.h"
+#include "processors/juce_IIRMultiChannelCascade.h"
 #include "processors/juce_FIRFilter.h"
 #include "processors/juce_StateVariableFilter.h"
 #include "processors/juce_FirstOrderTPTFilter.h"
 #include "processors/juce_Panner.h"
 #include "processors/juce_DelayLine.h"
 #include "processors/juce_Oversampling.h"
+#include "processors/juce_PolyphaseResampler.h"
 #include "processors/juce_BallisticsFilter.h"
 #include "processors/juce_LinkwitzRileyFilter.h"
 #include "processors/juce_DryWetMixer.h"
@@ -268,6 +270,7 @@ namespace util
 #include "frequency/juce_FFT.h"
 #include "frequency/juce_Convolution.h"
 #include "frequency/juce_Windowing.h"
+#include "frequency/juce_STFTProcessor.h"
 #include "filter_design/juce_FilterDesign.h"
 #include "widgets/juce_Reverb.h"
 #include "widgets/juce_Bias.h"
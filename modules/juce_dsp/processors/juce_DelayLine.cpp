@@ -69,7 +69,10 @@ void DelayLine<SampleType, InterpolationType>::prepare (const ProcessSpec& spec)
 {
     jassert (spec.numChannels > 0);
 
-    bufferData.setSize ((int) spec.numChannels, totalSize, false, false, true);
+    maximumBlockSize = jmax (1, (int) spec.maximumBlockSize);
+    updateBufferSize();
+
+    bufferData.setSize ((int) spec.numChannels, 2 * bufferSize, false, false, true);
 
     writePos.resize (spec.numChannels);
     readPos.resize  (spec.numChannels);
@@ -85,10 +88,20 @@ void DelayLine<SampleType, InterpolationType>::setMaximumDelayInSamples (int max
 {
     jassert (maxDelayInSamples >= 0);
     totalSize = jmax (4, maxDelayInSamples + 2);
-    bufferData.setSize ((int) bufferData.getNumChannels(), totalSize, false, false, true);
+    updateBufferSize();
+    bufferData.setSize ((int) bufferData.getNumChannels(), 2 * bufferSize, false, false, true);
     reset();
 }
 
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::updateBufferSize()
+{
+    // The oldest sample that can be interpolated is totalSize samples behind the read
+    // position, and a whole block can be pushed before it is read.
+    bufferSize = nextPowerOfTwo (totalSize + maximumBlockSize + 4);
+    bufferMask = bufferSize - 1;
+}
+
 template <typename SampleType, typename InterpolationType>
 void DelayLine<SampleType, InterpolationType>::reset()
 {
@@ -104,8 +117,11 @@ void DelayLine<SampleType, InterpolationType>::reset()
 template <typename SampleType, typename InterpolationType>
 void DelayLine<SampleType, InterpolationType>::pushSample (int channel, SampleType sample)
 {
-    bufferData.setSample (channel, writePos[(size_t) channel], sample);
-    writePos[(size_t) channel] = (writePos[(size_t) channel] + totalSize - 1) % totalSize;
+    auto& position = writePos[(size_t) channel];
+
+    bufferData.setSample (channel, position, sample);
+    bufferData.setSample (channel, position + bufferSize, sample);
+    position = (position + 1) & bufferMask;
 }
 
 template <typename SampleType, typename InterpolationType>
@@ -117,11 +133,151 @@ SampleType DelayLine<SampleType, InterpolationType>::popSample (int channel, Sam
     auto result = interpolateSample (channel);
 
     if (updateReadPointer)
-        readPos[(size_t) channel] = (readPos[(size_t) channel] + totalSize - 1) % totalSize;
+        readPos[(size_t) channel] = (readPos[(size_t) channel] + 1) & bufferMask;
 
     return result;
 }
 
+//==============================================================================
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::pushBlock (int channel, const SampleType* samples, int numSamples)
+{
+    jassert (isPositiveAndNotGreaterThan (numSamples, maximumBlockSize));
+
+    auto* destination = bufferData.getWritePointer (channel);
+    auto& position = writePos[(size_t) channel];
+
+    const auto numBeforeWrap = jmin (numSamples, bufferSize - position);
+    const auto numAfterWrap = numSamples - numBeforeWrap;
+
+    FloatVectorOperations::copy (destination + position, samples, numBeforeWrap);
+    FloatVectorOperations::copy (destination + position + bufferSize, samples, numBeforeWrap);
+    FloatVectorOperations::copy (destination, samples + numBeforeWrap, numAfterWrap);
+    FloatVectorOperations::copy (destination + bufferSize, samples + numBeforeWrap, numAfterWrap);
+
+    position = (position + numSamples) & bufferMask;
+}
+
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::popBlock (int channel, SampleType* destination, int numSamples, bool updateReadPointer)
+{
+    jassert (isPositiveAndNotGreaterThan (numSamples, maximumBlockSize));
+
+    auto* samples = bufferData.getReadPointer (channel);
+    const auto position = readPos[(size_t) channel];
+
+    // Since the mirrored buffer keeps the whole block contiguous, these loops don't
+    // need to wrap any indices and can be vectorised by the compiler.
+    if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::None>)
+    {
+        FloatVectorOperations::copy (destination, samples + ((position - delayInt) & bufferMask), numSamples);
+    }
+    else if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Linear>)
+    {
+        auto* source = samples + ((position - delayInt - 1) & bufferMask);
+        const auto frac = delayFrac;
+
+        for (int i = 0; i < numSamples; ++i)
+            destination[i] = source[i + 1] + frac * (source[i] - source[i + 1]);
+    }
+    else if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Lagrange3rd>)
+    {
+        auto* source = samples + ((position - delayInt - 3) & bufferMask);
+
+        const auto d1 = delayFrac - 1.f;
+        const auto d2 = delayFrac - 2.f;
+        const auto d3 = delayFrac - 3.f;
+
+        const auto c1 = -d1 * d2 * d3 / 6.f;
+        const auto c2 = delayFrac * d2 * d3 * 0.5f;
+        const auto c3 = -delayFrac * d1 * d3 * 0.5f;
+        const auto c4 = delayFrac * d1 * d2 / 6.f;
+
+        for (int i = 0; i < numSamples; ++i)
+            destination[i] = source[i + 3] * c1 + source[i + 2] * c2 + source[i + 1] * c3 + source[i] * c4;
+    }
+    else if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Thiran>)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            destination[i] = interpolateSample (channel);
+            readPos[(size_t) channel] = (readPos[(size_t) channel] + 1) & bufferMask;
+        }
+
+        readPos[(size_t) channel] = position;
+    }
+
+    if (updateReadPointer)
+        readPos[(size_t) channel] = (position + numSamples) & bufferMask;
+}
+
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::popBlock (int channel, SampleType* destination, const SampleType* delaysInSamples,
+                                                         int numSamples, bool updateReadPointer)
+{
+    jassert (isPositiveAndNotGreaterThan (numSamples, maximumBlockSize));
+
+    if (numSamples <= 0)
+        return;
+
+    auto* samples = bufferData.getReadPointer (channel);
+    const auto position = readPos[(size_t) channel];
+    const auto upperLimit = (SampleType) getMaximumDelayInSamples();
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        jassert (isPositiveAndNotGreaterThan (delaysInSamples[i], upperLimit));
+
+        const auto delayInSamples = jlimit ((SampleType) 0, upperLimit, delaysInSamples[i]);
+        auto sampleDelayInt = (int) delayInSamples;
+        auto sampleDelayFrac = delayInSamples - (SampleType) sampleDelayInt;
+
+        if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::None>)
+        {
+            destination[i] = samples[(position + i - sampleDelayInt) & bufferMask];
+        }
+        else if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Linear>)
+        {
+            auto* source = samples + ((position + i - sampleDelayInt - 1) & bufferMask);
+            destination[i] = source[1] + sampleDelayFrac * (source[0] - source[1]);
+        }
+        else if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Lagrange3rd>)
+        {
+            if (sampleDelayInt >= 1)
+            {
+                sampleDelayFrac++;
+                sampleDelayInt--;
+            }
+
+            auto* source = samples + ((position + i - sampleDelayInt - 3) & bufferMask);
+
+            auto d1 = sampleDelayFrac - 1.f;
+            auto d2 = sampleDelayFrac - 2.f;
+            auto d3 = sampleDelayFrac - 3.f;
+
+            auto c1 = -d1 * d2 * d3 / 6.f;
+            auto c2 = d2 * d3 * 0.5f;
+            auto c3 = -d1 * d3 * 0.5f;
+            auto c4 = d1 * d2 / 6.f;
+
+            destination[i] = source[3] * c1 + sampleDelayFrac * (source[2] * c2 + source[1] * c3 + source[0] * c4);
+        }
+        else if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Thiran>)
+        {
+            delayInt = sampleDelayInt;
+            delayFrac = sampleDelayFrac;
+            updateInternalVariables();
+
+            readPos[(size_t) channel] = (position + i) & bufferMask;
+            destination[i] = interpolateSample (channel);
+        }
+    }
+
+    setDelay (delaysInSamples[numSamples - 1]);
+
+    readPos[(size_t) channel] = updateReadPointer ? (position + numSamples) & bufferMask : position;
+}
+
 //==============================================================================
 template class DelayLine<float,  DelayLineInterpolationTypes::None>;
 template class DelayLine<double, DelayLineInterpolationTypes::None>;
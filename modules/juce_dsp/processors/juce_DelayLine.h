@@ -158,6 +158,72 @@ public:
     */
     SampleType popSample (int channel, SampleType delayInSamples = -1, bool updateReadPointer = true);
 
+    //==============================================================================
+    /** Pushes a block of samples into one channel of the delay line.
+
+        This is equivalent to calling pushSample for each sample, but is much faster.
+        The number of samples must not be greater than the maximumBlockSize of the
+        ProcessSpec that was passed to prepare.
+
+        @see popBlock, pushSample
+    */
+    void pushBlock (int channel, const SampleType* samples, int numSamples);
+
+    /** Pops a block of samples from one channel of the delay line, using the delay
+        set with setDelay.
+
+        This is equivalent to calling popSample for each sample, but is much faster.
+        The samples are read relative to the ones pushed since the last time the read
+        pointer was updated, so you'll usually call pushBlock with the same number of
+        samples first.
+
+        @param channel              the target channel for the delay line.
+
+        @param destination          where the delayed samples will be written.
+
+        @param numSamples           the number of samples to pop, which must not be greater
+                                    than the maximumBlockSize of the ProcessSpec that was
+                                    passed to prepare.
+
+        @param updateReadPointer    should be set to true if this is the last tap read for
+                                    this block, or false if you need multi-tap delay
+                                    capabilities and will read more taps from the same block.
+
+        @see setDelay, pushBlock, popSample
+    */
+    void popBlock (int channel, SampleType* destination, int numSamples, bool updateReadPointer = true);
+
+    /** Pops a block of samples from one channel of the delay line, using a different
+        fractional delay for each sample.
+
+        This is equivalent to calling popSample with each of the delays, but is much
+        faster. It can be used to modulate the delay in real time, for example in a
+        chorus or a flanger, and leaves the delay set to the last value in the block.
+
+        The samples are read relative to the ones pushed since the last time the read
+        pointer was updated. If you need to pop samples before pushing them, for example
+        to process a feedback loop, then each delay must be greater than the index of
+        its sample in the block.
+
+        @param channel              the target channel for the delay line.
+
+        @param destination          where the delayed samples will be written.
+
+        @param delaysInSamples      the fractional delay in samples for each sample.
+
+        @param numSamples           the number of samples to pop, which must not be greater
+                                    than the maximumBlockSize of the ProcessSpec that was
+                                    passed to prepare.
+
+        @param updateReadPointer    should be set to true if this is the last tap read for
+                                    this block, or false if you need multi-tap delay
+                                    capabilities and will read more taps from the same block.
+
+        @see pushBlock, popSample
+    */
+    void popBlock (int channel, SampleType* destination, const SampleType* delaysInSamples,
+                   int numSamples, bool updateReadPointer = true);
+
     //==============================================================================
     /** Processes the input and output samples supplied in the processing context.
 
@@ -189,60 +255,49 @@ public:
             auto* inputSamples = inputBlock.getChannelPointer (channel);
             auto* outputSamples = outputBlock.getChannelPointer (channel);
 
-            for (size_t i = 0; i < numSamples; ++i)
+            for (size_t start = 0; start < numSamples; start += (size_t) maximumBlockSize)
             {
-                pushSample ((int) channel, inputSamples[i]);
-                outputSamples[i] = popSample ((int) channel);
+                const auto numToDo = (int) jmin ((size_t) maximumBlockSize, numSamples - start);
+
+                pushBlock ((int) channel, inputSamples + start, numToDo);
+                popBlock ((int) channel, outputSamples + start, numToDo);
             }
         }
     }
 
 private:
     //==============================================================================
+    /*  The samples of each channel are stored in a circular buffer with a power of two
+        size, so that positions can be wrapped with a mask. Every sample is written
+        twice, bufferSize samples apart, so the samples that are needed to interpolate
+        any delayed sample, or a whole block of them, are always contiguous in memory.
+    */
     SampleType interpolateSample (int channel)
     {
+        auto* samples = bufferData.getReadPointer (channel);
+        auto position = readPos[(size_t) channel];
+
         if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::None>)
         {
-            auto index = (readPos[(size_t) channel] + delayInt) % totalSize;
-            return bufferData.getSample (channel, index);
+            return samples[(position - delayInt) & bufferMask];
         }
         else if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Linear>)
         {
-            auto index1 = readPos[(size_t) channel] + delayInt;
-            auto index2 = index1 + 1;
+            auto index = (position - delayInt - 1) & bufferMask;
 
-            if (index2 >= totalSize)
-            {
-                index1 %= totalSize;
-                index2 %= totalSize;
-            }
-
-            auto value1 = bufferData.getSample (channel, index1);
-            auto value2 = bufferData.getSample (channel, index2);
+            auto value1 = samples[index + 1];
+            auto value2 = samples[index];
 
             return value1 + delayFrac * (value2 - value1);
         }
         else if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Lagrange3rd>)
         {
-            auto index1 = readPos[(size_t) channel] + delayInt;
-            auto index2 = index1 + 1;
-            auto index3 = index2 + 1;
-            auto index4 = index3 + 1;
-
-            if (index4 >= totalSize)
-            {
-                index1 %= totalSize;
-                index2 %= totalSize;
-                index3 %= totalSize;
-                index4 %= totalSize;
-            }
-
-            auto* samples = bufferData.getReadPointer (channel);
+            auto index = (position - delayInt - 3) & bufferMask;
 
-            auto value1 = samples[index1];
-            auto value2 = samples[index2];
-            auto value3 = samples[index3];
-            auto value4 = samples[index4];
+            auto value1 = samples[index + 3];
+            auto value2 = samples[index + 2];
+            auto value3 = samples[index + 1];
+            auto value4 = samples[index];
 
             auto d1 = delayFrac - 1.f;
             auto d2 = delayFrac - 2.f;
@@ -257,17 +312,10 @@ private:
         }
         else if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Thiran>)
         {
-            auto index1 = readPos[(size_t) channel] + delayInt;
-            auto index2 = index1 + 1;
+            auto index = (position - delayInt - 1) & bufferMask;
 
-            if (index2 >= totalSize)
-            {
-                index1 %= totalSize;
-                index2 %= totalSize;
-            }
-
-            auto value1 = bufferData.getSample (channel, index1);
-            auto value2 = bufferData.getSample (channel, index2);
+            auto value1 = samples[index + 1];
+            auto value2 = samples[index];
 
             auto output = approximatelyEqual (delayFrac, (SampleType) 0) ? value1 : value2 + alpha * (value1 - v[(size_t) channel]);
             v[(size_t) channel] = output;
@@ -299,6 +347,8 @@ private:
         }
     }
 
+    void updateBufferSize();
+
     //==============================================================================
     double sampleRate;
 
@@ -307,7 +357,7 @@ private:
     std::vector<SampleType> v;
     std::vector<int> writePos, readPos;
     SampleType delay = 0.0, delayFrac = 0.0;
-    int delayInt = 0, totalSize = 4;
+    int delayInt = 0, totalSize = 4, bufferSize = 8, bufferMask = 7, maximumBlockSize = 1;
     SampleType alpha = 0.0;
 };
 
@@ -0,0 +1,338 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+#if JUCE_ENABLE_ALLOCATION_HOOKS
+#define JUCE_FAIL_ON_ALLOCATION_IN_SCOPE const UnitTestAllocationChecker checker (*this)
+#else
+#define JUCE_FAIL_ON_ALLOCATION_IN_SCOPE
+#endif
+
+class DelayLineTest final : public UnitTest
+{
+public:
+    DelayLineTest()
+        : UnitTest ("DelayLine", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Block processing with a constant delay matches sample processing");
+        {
+            runForEachInterpolationType ([this] (auto type) { expectConstantDelayMatches (type); });
+        }
+
+        beginTest ("Block processing with a modulated delay matches sample processing");
+        {
+            runForEachInterpolationType ([this] (auto type) { expectModulatedDelayMatches (type); });
+        }
+
+        beginTest ("Multi-tap block reads match sample reads");
+        {
+            // The Thiran interpolation keeps a filter state per channel, so it can't be
+            // used for multi-tap reads
+            expectMultiTapMatches (DelayLineInterpolationTypes::None{});
+            expectMultiTapMatches (DelayLineInterpolationTypes::Linear{});
+            expectMultiTapMatches (DelayLineInterpolationTypes::Lagrange3rd{});
+        }
+
+        beginTest ("Process matches sample processing");
+        {
+            runForEachInterpolationType ([this] (auto type) { expectProcessMatches (type); });
+        }
+
+        beginTest ("Block processing doesn't allocate");
+        {
+            DelayLine<float, DelayLineInterpolationTypes::Lagrange3rd> delayLine (100);
+            delayLine.prepare ({ 44100.0, (uint32) blockSize, 1 });
+
+            std::vector<float> input ((size_t) blockSize, 0.5f), output ((size_t) blockSize), delays ((size_t) blockSize, 10.5f);
+
+            {
+                JUCE_FAIL_ON_ALLOCATION_IN_SCOPE;
+
+                delayLine.pushBlock (0, input.data(), blockSize);
+                delayLine.popBlock (0, output.data(), delays.data(), blockSize, false);
+                delayLine.popBlock (0, output.data(), blockSize);
+            }
+        }
+
+        beginTest ("Benchmark");
+        {
+            runForEachInterpolationType ([this] (auto type) { benchmark (type); });
+        }
+    }
+
+private:
+    static constexpr int blockSize = 64, numBlocks = 20, maximumDelay = 300;
+
+    template <typename Callback>
+    static void runForEachInterpolationType (Callback&& callback)
+    {
+        callback (DelayLineInterpolationTypes::None{});
+        callback (DelayLineInterpolationTypes::Linear{});
+        callback (DelayLineInterpolationTypes::Lagrange3rd{});
+        callback (DelayLineInterpolationTypes::Thiran{});
+    }
+
+    static String getName (DelayLineInterpolationTypes::None)        { return "None"; }
+    static String getName (DelayLineInterpolationTypes::Linear)      { return "Linear"; }
+    static String getName (DelayLineInterpolationTypes::Lagrange3rd) { return "Lagrange3rd"; }
+    static String getName (DelayLineInterpolationTypes::Thiran)      { return "Thiran"; }
+
+    static std::vector<float> makeInput (int numSamples)
+    {
+        std::vector<float> input ((size_t) numSamples);
+        Random random (1234);
+
+        for (auto& sample : input)
+            sample = random.nextFloat() * 2.0f - 1.0f;
+
+        return input;
+    }
+
+    static std::vector<float> makeModulatedDelays (int numSamples, float minimum, float maximum)
+    {
+        std::vector<float> delays ((size_t) numSamples);
+
+        for (size_t i = 0; i < delays.size(); ++i)
+            delays[i] = minimum + (maximum - minimum) * 0.5f * (1.0f + std::sin ((float) i * 0.013f));
+
+        return delays;
+    }
+
+    template <typename Type>
+    void expectConstantDelayMatches (Type)
+    {
+        const auto input = makeInput (blockSize * numBlocks);
+
+        for (auto delay : { 0.0f, 1.0f, 2.5f, 17.25f, 63.9f, 64.0f, 150.7f, (float) maximumDelay })
+        {
+            DelayLine<float, Type> reference (maximumDelay), delayLine (maximumDelay);
+
+            for (auto* line : { &reference, &delayLine })
+            {
+                line->prepare ({ 44100.0, (uint32) blockSize, 1 });
+                line->setDelay (delay);
+            }
+
+            std::vector<float> output ((size_t) blockSize);
+            auto maxError = 0.0f;
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                const auto* blockInput = input.data() + block * blockSize;
+
+                delayLine.pushBlock (0, blockInput, blockSize);
+                delayLine.popBlock (0, output.data(), blockSize);
+
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    reference.pushSample (0, blockInput[i]);
+                    maxError = jmax (maxError, std::abs (reference.popSample (0) - output[(size_t) i]));
+                }
+            }
+
+            expectLessThan (maxError, 1.0e-5f);
+        }
+    }
+
+    template <typename Type>
+    void expectModulatedDelayMatches (Type)
+    {
+        const auto numSamples = blockSize * numBlocks;
+        const auto input = makeInput (numSamples);
+        const auto delays = makeModulatedDelays (numSamples, 0.0f, (float) maximumDelay);
+
+        DelayLine<float, Type> reference (maximumDelay), delayLine (maximumDelay);
+        reference.prepare ({ 44100.0, (uint32) blockSize, 1 });
+        delayLine.prepare ({ 44100.0, (uint32) blockSize, 1 });
+
+        std::vector<float> output ((size_t) blockSize);
+        auto maxError = 0.0f;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            const auto offset = block * blockSize;
+
+            delayLine.pushBlock (0, input.data() + offset, blockSize);
+            delayLine.popBlock (0, output.data(), delays.data() + offset, blockSize);
+
+            for (int i = 0; i < blockSize; ++i)
+            {
+                reference.pushSample (0, input[(size_t) (offset + i)]);
+                maxError = jmax (maxError, std::abs (reference.popSample (0, delays[(size_t) (offset + i)]) - output[(size_t) i]));
+            }
+        }
+
+        expectLessThan (maxError, 1.0e-5f);
+        expectEquals (delayLine.getDelay(), reference.getDelay());
+    }
+
+    template <typename Type>
+    void expectMultiTapMatches (Type)
+    {
+        const auto numSamples = blockSize * numBlocks;
+        const auto input = makeInput (numSamples);
+        const auto delays = makeModulatedDelays (numSamples, 20.0f, 40.0f);
+        constexpr float fixedTap = 100.5f;
+
+        DelayLine<float, Type> reference (maximumDelay), delayLine (maximumDelay);
+        reference.prepare ({ 44100.0, (uint32) blockSize, 1 });
+        delayLine.prepare ({ 44100.0, (uint32) blockSize, 1 });
+
+        std::vector<float> modulatedOutput ((size_t) blockSize), fixedOutput ((size_t) blockSize);
+        auto maxError = 0.0f;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            const auto offset = block * blockSize;
+
+            delayLine.pushBlock (0, input.data() + offset, blockSize);
+            delayLine.popBlock (0, modulatedOutput.data(), delays.data() + offset, blockSize, false);
+            delayLine.setDelay (fixedTap);
+            delayLine.popBlock (0, fixedOutput.data(), blockSize);
+
+            for (int i = 0; i < blockSize; ++i)
+            {
+                reference.pushSample (0, input[(size_t) (offset + i)]);
+
+                const auto modulated = reference.popSample (0, delays[(size_t) (offset + i)], false);
+                const auto fixed = reference.popSample (0, fixedTap);
+
+                maxError = jmax (maxError, std::abs (modulated - modulatedOutput[(size_t) i]));
+                maxError = jmax (maxError, std::abs (fixed - fixedOutput[(size_t) i]));
+            }
+        }
+
+        expectLessThan (maxError, 1.0e-5f);
+    }
+
+    template <typename Type>
+    void expectProcessMatches (Type)
+    {
+        constexpr int numChannels = 3;
+        const auto numSamples = blockSize * numBlocks;
+        const auto input = makeInput (numSamples);
+
+        DelayLine<float, Type> reference (maximumDelay), delayLine (maximumDelay);
+        reference.prepare ({ 44100.0, (uint32) blockSize, (uint32) numChannels });
+        delayLine.prepare ({ 44100.0, (uint32) blockSize, (uint32) numChannels });
+        reference.setDelay (123.4f);
+        delayLine.setDelay (123.4f);
+
+        AudioBuffer<float> buffer (numChannels, blockSize);
+        auto maxError = 0.0f;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            const auto* blockInput = input.data() + block * blockSize;
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                buffer.copyFrom (channel, 0, blockInput, blockSize, (float) (channel + 1));
+
+            AudioBlock<float> audioBlock (buffer);
+            delayLine.process (ProcessContextReplacing<float> (audioBlock));
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    reference.pushSample (channel, blockInput[i] * (float) (channel + 1));
+                    maxError = jmax (maxError, std::abs (reference.popSample (channel) - buffer.getSample (channel, i)));
+                }
+            }
+        }
+
+        expectLessThan (maxError, 1.0e-5f);
+    }
+
+    template <typename Type>
+    void benchmark (Type)
+    {
+        constexpr int benchmarkBlockSize = 512, numBenchmarkBlocks = 2000, delayInSamples = 2000;
+
+        const auto delays = makeModulatedDelays (benchmarkBlockSize, 300.0f, 1500.0f);
+        std::vector<float> input ((size_t) benchmarkBlockSize, 0.25f), output ((size_t) benchmarkBlockSize);
+
+        DelayLine<float, Type> delayLine (delayInSamples);
+        delayLine.prepare ({ 44100.0, (uint32) benchmarkBlockSize, 1 });
+
+        auto measure = [&] (auto&& processBlock)
+        {
+            delayLine.reset();
+            delayLine.setDelay (1000.5f);
+
+            const auto start = Time::getHighResolutionTicks();
+
+            for (int block = 0; block < numBenchmarkBlocks; ++block)
+                processBlock();
+
+            return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start) * 1000.0;
+        };
+
+        const auto sampleConstant = measure ([&]
+        {
+            for (int i = 0; i < benchmarkBlockSize; ++i)
+            {
+                delayLine.pushSample (0, input[(size_t) i]);
+                output[(size_t) i] = delayLine.popSample (0);
+            }
+        });
+
+        const auto blockConstant = measure ([&]
+        {
+            delayLine.pushBlock (0, input.data(), benchmarkBlockSize);
+            delayLine.popBlock (0, output.data(), benchmarkBlockSize);
+        });
+
+        const auto sampleModulated = measure ([&]
+        {
+            for (int i = 0; i < benchmarkBlockSize; ++i)
+            {
+                delayLine.pushSample (0, input[(size_t) i]);
+                output[(size_t) i] = delayLine.popSample (0, delays[(size_t) i]);
+            }
+        });
+
+        const auto blockModulated = measure ([&]
+        {
+            delayLine.pushBlock (0, input.data(), benchmarkBlockSize);
+            delayLine.popBlock (0, output.data(), delays.data(), benchmarkBlockSize);
+        });
+
+        logMessage (getName (Type{}) + ": constant delay " + String (sampleConstant, 2) + " ms per sample, "
+                    + String (blockConstant, 2) + " ms per block; modulated delay " + String (sampleModulated, 2)
+                    + " ms per sample, " + String (blockModulated, 2) + " ms per block");
+    }
+};
+
+static DelayLineTest delayLineTest;
+
+#undef JUCE_FAIL_ON_ALLOCATION_IN_SCOPE
+
+} // namespace juce::dsp
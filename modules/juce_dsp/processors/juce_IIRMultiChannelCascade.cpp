@@ -0,0 +1,304 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp::IIR
+{
+
+template <typename SampleType>
+MultiChannelCascade<SampleType>::MultiChannelCascade (size_t initialNumSections)
+{
+    setNumSections (initialNumSections);
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::setNumSections (size_t newNumSections)
+{
+    const SectionCoefficients passThrough { { 1, 0, 0, 0, 0 } };
+
+    std::vector<SectionCoefficients> newChannelCoefficients (numChannels * newNumSections, passThrough);
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+        for (size_t section = 0; section < jmin (numSections, newNumSections); ++section)
+            newChannelCoefficients[channel * newNumSections + section] = channelCoefficients[channel * numSections + section];
+
+    defaultCoefficients.resize (newNumSections, passThrough);
+    channelCoefficients = std::move (newChannelCoefficients);
+    numSections = newNumSections;
+
+    laneCoefficients.assign (numGroups * numSections * numCoefficients, Lanes());
+    state.assign (numGroups * numSections * 2, Lanes());
+
+    for (size_t channel = 0; channel < numGroups * numLanes; ++channel)
+        for (size_t section = 0; section < numSections; ++section)
+            updateLanes (section, channel);
+}
+
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::setCoefficients (size_t sectionIndex, const Coefficients<SampleType>& newCoefficients)
+{
+    jassert (sectionIndex < numSections);
+
+    defaultCoefficients[sectionIndex] = getSectionCoefficients (newCoefficients);
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        channelCoefficients[channel * numSections + sectionIndex] = defaultCoefficients[sectionIndex];
+        updateLanes (sectionIndex, channel);
+    }
+}
+
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::setCoefficients (size_t sectionIndex, size_t channel,
+                                                       const Coefficients<SampleType>& newCoefficients)
+{
+    jassert (sectionIndex < numSections);
+
+    // The cascade must be prepared with enough channels before setting per-channel coefficients!
+    jassert (channel < numChannels);
+
+    if (channel < numChannels)
+    {
+        channelCoefficients[channel * numSections + sectionIndex] = getSectionCoefficients (newCoefficients);
+        updateLanes (sectionIndex, channel);
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.numChannels > 0);
+    jassert (spec.maximumBlockSize > 0);
+
+    std::vector<SectionCoefficients> newChannelCoefficients;
+    newChannelCoefficients.reserve (spec.numChannels * numSections);
+
+    for (size_t channel = 0; channel < spec.numChannels; ++channel)
+        for (size_t section = 0; section < numSections; ++section)
+            newChannelCoefficients.push_back (channel < numChannels ? channelCoefficients[channel * numSections + section]
+                                                                    : defaultCoefficients[section]);
+
+    channelCoefficients = std::move (newChannelCoefficients);
+    numChannels = spec.numChannels;
+    numGroups = (numChannels + numLanes - 1) / numLanes;
+    maximumBlockSize = spec.maximumBlockSize;
+
+    interleaved.assign (maximumBlockSize * groupsPerPass, Lanes());
+    setNumSections (numSections);
+}
+
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::reset() noexcept
+{
+    std::fill (state.begin(), state.end(), Lanes());
+}
+
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::snapToZero() noexcept
+{
+    for (auto& lanes : state)
+    {
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            auto value = getLane (lanes, lane);
+            util::snapToZero (value);
+            setLane (lanes, lane, value);
+        }
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::processBlock (const AudioBlock<const SampleType>& input,
+                                                    AudioBlock<SampleType>& output) noexcept
+{
+    const auto numSamples = output.getNumSamples();
+    const auto numChannelsToProcess = output.getNumChannels();
+
+    // The cascade must be prepared with at least as many channels as it processes!
+    jassert (numChannelsToProcess <= numChannels);
+
+    const auto numGroupsToProcess = (numChannelsToProcess + numLanes - 1) / numLanes;
+    auto* samples = reinterpret_cast<SampleType*> (interleaved.data());
+
+    for (size_t start = 0; start < numSamples; start += maximumBlockSize)
+    {
+        const auto numToDo = jmin (maximumBlockSize, numSamples - start);
+
+        // Several groups are filtered together, so that their independent recursions
+        // can hide each other's latency.
+        for (size_t firstGroup = 0; firstGroup < numGroupsToProcess; firstGroup += groupsPerPass)
+        {
+            const auto numGroupsInPass = jmin (groupsPerPass, numGroupsToProcess - firstGroup);
+            const auto stride = numGroupsInPass * numLanes;
+            const auto firstChannel = firstGroup * numLanes;
+            const auto numActiveLanes = jmin (stride, numChannelsToProcess - firstChannel);
+
+            for (size_t lane = 0; lane < numActiveLanes; ++lane)
+            {
+                auto* src = input.getChannelPointer (firstChannel + lane) + start;
+
+                for (size_t i = 0; i < numToDo; ++i)
+                    samples[i * stride + lane] = src[i];
+            }
+
+            for (size_t lane = numActiveLanes; lane < stride; ++lane)
+                for (size_t i = 0; i < numToDo; ++i)
+                    samples[i * stride + lane] = 0;
+
+            switch (numGroupsInPass)
+            {
+                case 4:  processGroups<4> (firstGroup, numToDo); break;
+                case 3:  processGroups<3> (firstGroup, numToDo); break;
+                case 2:  processGroups<2> (firstGroup, numToDo); break;
+                default: processGroups<1> (firstGroup, numToDo); break;
+            }
+
+            for (size_t lane = 0; lane < numActiveLanes; ++lane)
+            {
+                auto* dst = output.getChannelPointer (firstChannel + lane) + start;
+
+                for (size_t i = 0; i < numToDo; ++i)
+                    dst[i] = samples[i * stride + lane];
+            }
+        }
+    }
+
+   #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+    snapToZero();
+   #endif
+}
+
+template <typename SampleType>
+template <size_t numGroupsInPass>
+void MultiChannelCascade<SampleType>::processGroups (size_t firstGroup, size_t numSamples) noexcept
+{
+    auto* x = interleaved.data();
+
+    for (size_t section = 0; section < numSections; ++section)
+    {
+        std::array<Lanes, numGroupsInPass> b0, b1, b2, a1, a2, lv1, lv2;
+
+        for (size_t g = 0; g < numGroupsInPass; ++g)
+        {
+            const auto index = (firstGroup + g) * numSections + section;
+            const auto* c = laneCoefficients.data() + index * numCoefficients;
+
+            b0[g] = c[0];
+            b1[g] = c[1];
+            b2[g] = c[2];
+            a1[g] = c[3];
+            a2[g] = c[4];
+
+            lv1[g] = state[index * 2];
+            lv2[g] = state[index * 2 + 1];
+        }
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            for (size_t g = 0; g < numGroupsInPass; ++g)
+            {
+                auto& sample = x[i * numGroupsInPass + g];
+
+                const auto input = sample;
+                const auto output = (input * b0[g]) + lv1[g];
+                sample = output;
+
+                // This matches the order of operations in IIR::Filter, so that both give identical results
+                lv1[g] = (input * b1[g]) - (output * a1[g]) + lv2[g];
+                lv2[g] = (input * b2[g]) - (output * a2[g]);
+            }
+        }
+
+        for (size_t g = 0; g < numGroupsInPass; ++g)
+        {
+            const auto index = (firstGroup + g) * numSections + section;
+
+            state[index * 2]     = lv1[g];
+            state[index * 2 + 1] = lv2[g];
+        }
+    }
+}
+
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::updateLanes (size_t sectionIndex, size_t channel)
+{
+    const SectionCoefficients passThrough { { 1, 0, 0, 0, 0 } };
+
+    const auto& values = channel < numChannels ? channelCoefficients[channel * numSections + sectionIndex]
+                                               : passThrough;
+
+    const auto group = channel / numLanes;
+    auto* lanes = laneCoefficients.data() + (group * numSections + sectionIndex) * numCoefficients;
+
+    for (size_t i = 0; i < numCoefficients; ++i)
+        setLane (lanes[i], channel % numLanes, values[i]);
+}
+
+//==============================================================================
+template <typename SampleType>
+typename MultiChannelCascade<SampleType>::SectionCoefficients
+    MultiChannelCascade<SampleType>::getSectionCoefficients (const Coefficients<SampleType>& c)
+{
+    const auto* raw = c.getRawCoefficients();
+
+    switch (c.getFilterOrder())
+    {
+        case 1:  return { { raw[0], raw[1], 0, raw[2], 0 } };
+        case 2:  return { { raw[0], raw[1], raw[2], raw[3], raw[4] } };
+        default: break;
+    }
+
+    // Each section of the cascade must be a first or second order filter!
+    jassertfalse;
+    return { { 1, 0, 0, 0, 0 } };
+}
+
+template <typename SampleType>
+void MultiChannelCascade<SampleType>::setLane (Lanes& lanes, [[maybe_unused]] size_t lane, SampleType value) noexcept
+{
+   #if JUCE_USE_SIMD
+    lanes.set (lane, value);
+   #else
+    lanes = value;
+   #endif
+}
+
+template <typename SampleType>
+SampleType MultiChannelCascade<SampleType>::getLane (const Lanes& lanes, [[maybe_unused]] size_t lane) noexcept
+{
+   #if JUCE_USE_SIMD
+    return lanes.get (lane);
+   #else
+    return lanes;
+   #endif
+}
+
+//==============================================================================
+template class MultiChannelCascade<float>;
+template class MultiChannelCascade<double>;
+
+} // namespace juce::dsp::IIR
@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp::IIR
+{
+
+/**
+    A cascade of first and second order IIR sections that processes every channel
+    of a multi-channel block at once.
+
+    Using an IIR::Filter for each section and each channel means that a 16 channel
+    equaliser with 8 bands runs 128 separate scalar filters. This class instead
+    interleaves groups of channels into the lanes of a SIMDRegister, so that each
+    section of the cascade processes a whole group of channels with every
+    instruction. Each section can have the same coefficients on every channel, or
+    different coefficients per channel.
+
+    The sections use the same Transposed Direct Form II structure as IIR::Filter, and
+    produce the same output. Sections whose coefficients have never been set pass
+    their input through unchanged.
+
+    Like IIR::Filter, it's up to the caller to make sure the coefficients aren't
+    changed while the cascade is processing audio.
+
+    @see Filter, ProcessorDuplicator
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class MultiChannelCascade
+{
+public:
+    //==============================================================================
+    /** Creates a cascade with the given number of sections. */
+    explicit MultiChannelCascade (size_t numSections = 1);
+
+    //==============================================================================
+    /** Changes the number of sections in the cascade.
+
+        The coefficients of the existing sections are kept, and any new sections
+        will pass their input through unchanged. This allocates memory, so shouldn't
+        be called while the cascade is processing audio.
+    */
+    void setNumSections (size_t newNumSections);
+
+    /** Returns the number of sections in the cascade. */
+    size_t getNumSections() const noexcept         { return numSections; }
+
+    /** Sets the coefficients of one section on all channels.
+
+        The coefficients must describe a first or second order filter.
+    */
+    void setCoefficients (size_t sectionIndex, const Coefficients<SampleType>& newCoefficients);
+
+    /** Sets the coefficients of one section on a single channel.
+
+        The coefficients must describe a first or second order filter. The channel must
+        be less than the number of channels that the cascade was prepared with.
+    */
+    void setCoefficients (size_t sectionIndex, size_t channel, const Coefficients<SampleType>& newCoefficients);
+
+    //==============================================================================
+    /** Initialises the cascade for the given number of channels and block size. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Clears the state of every section on every channel. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Processes the input and output samples supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        static_assert (std::is_same_v<typename ProcessContext::SampleType, SampleType>,
+                       "The sample-type of the cascade must match the sample-type supplied to this process callback");
+
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom (inputBlock);
+
+            return;
+        }
+
+        processBlock (inputBlock, outputBlock);
+    }
+
+    /** Ensure that the state variables are rounded to zero if the state
+        variables are denormals.
+    */
+    void snapToZero() noexcept;
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using Lanes = SIMDRegister<SampleType>;
+   #else
+    using Lanes = SampleType;
+   #endif
+
+    static constexpr size_t numLanes = sizeof (Lanes) / sizeof (SampleType);
+    static constexpr size_t numCoefficients = 5, groupsPerPass = 4;
+
+    using SectionCoefficients = std::array<SampleType, numCoefficients>;
+
+    void processBlock (const AudioBlock<const SampleType>& input, AudioBlock<SampleType>& output) noexcept;
+    void updateLanes (size_t sectionIndex, size_t channel);
+
+    template <size_t numGroupsInPass>
+    void processGroups (size_t firstGroup, size_t numSamples) noexcept;
+
+    static SectionCoefficients getSectionCoefficients (const Coefficients<SampleType>&);
+    static void setLane (Lanes& lanes, size_t lane, SampleType value) noexcept;
+    static SampleType getLane (const Lanes& lanes, size_t lane) noexcept;
+
+    //==============================================================================
+    size_t numSections = 0, numChannels = 0, numGroups = 0, maximumBlockSize = 0;
+
+    std::vector<SectionCoefficients> defaultCoefficients, channelCoefficients;
+    std::vector<Lanes> laneCoefficients, state, interleaved;
+
+    JUCE_LEAK_DETECTOR (MultiChannelCascade)
+};
+
+} // namespace juce::dsp::IIR
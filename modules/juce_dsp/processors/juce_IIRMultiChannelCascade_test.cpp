@@ -0,0 +1,236 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_ENABLE_ALLOCATION_HOOKS
+#define JUCE_FAIL_ON_ALLOCATION_IN_SCOPE const UnitTestAllocationChecker checker (*this)
+#else
+#define JUCE_FAIL_ON_ALLOCATION_IN_SCOPE
+#endif
+
+namespace juce::dsp::IIR
+{
+
+class MultiChannelCascadeTest final : public UnitTest
+{
+public:
+    MultiChannelCascadeTest()
+        : UnitTest ("IIR MultiChannelCascade", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Shared coefficients match a cascade of IIR::Filters");
+        {
+            for (auto numChannels : { 1, 2, 3, 8, 13, 16 })
+                expectMatchesFilters (numChannels, 512, false);
+        }
+
+        beginTest ("Per-channel coefficients match a cascade of IIR::Filters");
+        {
+            for (auto numChannels : { 1, 5, 16 })
+                expectMatchesFilters (numChannels, 256, true);
+        }
+
+        beginTest ("Blocks larger than the maximum block size are processed correctly");
+        {
+            expectMatchesFilters (6, 1000, false, 64);
+        }
+
+        beginTest ("Bypassed contexts copy their input");
+        {
+            MultiChannelCascade<float> cascade (2);
+            cascade.setCoefficients (0, *Coefficients<float>::makeLowPass (sampleRate, 500.0f));
+            cascade.setCoefficients (1, *Coefficients<float>::makeFirstOrderHighPass (sampleRate, 50.0f));
+            cascade.prepare ({ sampleRate, 128, 3 });
+
+            const auto input = makeNoise (3, 128);
+            AudioBuffer<float> output (3, 128);
+            AudioBlock<const float> inputBlock (input);
+            AudioBlock<float> outputBlock (output);
+
+            ProcessContextNonReplacing<float> context (inputBlock, outputBlock);
+            context.isBypassed = true;
+            cascade.process (context);
+
+            for (int channel = 0; channel < 3; ++channel)
+                for (int i = 0; i < 128; ++i)
+                    expectEquals (output.getSample (channel, i), input.getSample (channel, i));
+        }
+
+        beginTest ("Processing doesn't allocate");
+        {
+            MultiChannelCascade<double> cascade (4);
+
+            for (size_t section = 0; section < 4; ++section)
+                cascade.setCoefficients (section, *Coefficients<double>::makePeakFilter (sampleRate, 200.0 * (double) (section + 1), 1.0, 2.0));
+
+            cascade.prepare ({ sampleRate, 256, 5 });
+
+            AudioBuffer<double> buffer (5, 256);
+            buffer.clear();
+            AudioBlock<double> block (buffer);
+
+            JUCE_FAIL_ON_ALLOCATION_IN_SCOPE;
+            cascade.process (ProcessContextReplacing<double> (block));
+        }
+
+        beginTest ("Benchmark against a ProcessorDuplicator per band");
+        {
+            constexpr int numChannels = 16, numBands = 8, blockSize = 512, numBlocks = 400;
+
+            const auto bandCoefficients = [] (int band)
+            {
+                return Coefficients<float>::makePeakFilter (sampleRate, 60.0f * std::pow (2.0f, (float) band), 0.7f, band % 2 == 0 ? 1.5f : 1.0f / 1.5f);
+            };
+
+            ProcessSpec spec { sampleRate, (uint32) blockSize, (uint32) numChannels };
+
+            std::vector<ProcessorDuplicator<Filter<float>, Coefficients<float>>> duplicators (numBands);
+
+            for (int band = 0; band < numBands; ++band)
+            {
+                *duplicators[(size_t) band].state = *bandCoefficients (band);
+                duplicators[(size_t) band].prepare (spec);
+            }
+
+            MultiChannelCascade<float> cascade (numBands);
+
+            for (int band = 0; band < numBands; ++band)
+                cascade.setCoefficients ((size_t) band, *bandCoefficients (band));
+
+            cascade.prepare (spec);
+
+            auto buffer = makeNoise (numChannels, blockSize);
+            AudioBlock<float> block (buffer);
+            ProcessContextReplacing<float> context (block);
+
+            const auto time = [&] (auto&& processBlock)
+            {
+                const auto start = Time::getHighResolutionTicks();
+
+                for (int i = 0; i < numBlocks; ++i)
+                    processBlock();
+
+                return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start) * 1000.0;
+            };
+
+            const auto duplicatorTime = time ([&] { for (auto& d : duplicators) d.process (context); });
+            const auto cascadeTime    = time ([&] { cascade.process (context); });
+
+            logMessage ("16 channels, 8 bands, " + String (numBlocks) + " blocks of " + String (blockSize) + " samples: "
+                        + "ProcessorDuplicator " + String (duplicatorTime, 2) + " ms, "
+                        + "MultiChannelCascade " + String (cascadeTime, 2) + " ms");
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+
+    static AudioBuffer<float> makeNoise (int numChannels, int numSamples)
+    {
+        Random random (0x1234);
+        AudioBuffer<float> buffer (numChannels, numSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        return buffer;
+    }
+
+    static std::vector<Coefficients<float>::Ptr> makeSections (int channel, bool perChannel)
+    {
+        const auto offset = perChannel ? (float) channel * 37.0f : 0.0f;
+
+        return { Coefficients<float>::makeHighPass   (sampleRate, 40.0f + offset),
+                 Coefficients<float>::makeLowShelf   (sampleRate, 150.0f + offset, 0.7f, 1.8f),
+                 Coefficients<float>::makePeakFilter (sampleRate, 1000.0f + offset, 2.0f, 0.5f),
+                 Coefficients<float>::makeFirstOrderLowPass (sampleRate, 8000.0f - offset) };
+    }
+
+    void expectMatchesFilters (int numChannels, int numSamples, bool perChannel, int maximumBlockSize = 512)
+    {
+        const auto numSections = makeSections (0, false).size();
+        const ProcessSpec spec { sampleRate, (uint32) maximumBlockSize, (uint32) numChannels };
+
+        MultiChannelCascade<float> cascade (numSections);
+
+        if (! perChannel)
+        {
+            const auto sections = makeSections (0, false);
+
+            for (size_t section = 0; section < numSections; ++section)
+                cascade.setCoefficients (section, *sections[section]);
+        }
+
+        cascade.prepare (spec);
+
+        std::vector<std::vector<Filter<float>>> filters ((size_t) numChannels);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const auto sections = makeSections (channel, perChannel);
+
+            for (size_t section = 0; section < numSections; ++section)
+            {
+                filters[(size_t) channel].emplace_back (sections[section]);
+
+                if (perChannel)
+                    cascade.setCoefficients (section, (size_t) channel, *sections[section]);
+            }
+        }
+
+        const auto input = makeNoise (numChannels, numSamples);
+        auto expected = input;
+        AudioBuffer<float> output (numChannels, numSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            AudioBlock<float> channelBlock (expected.getArrayOfWritePointers() + channel, 1, (size_t) numSamples);
+
+            for (auto& filter : filters[(size_t) channel])
+                filter.process (ProcessContextReplacing<float> (channelBlock));
+        }
+
+        for (int repeat = 0; repeat < 2; ++repeat)
+        {
+            AudioBlock<const float> inputBlock (input);
+            AudioBlock<float> outputBlock (output);
+            cascade.process (ProcessContextNonReplacing<float> (inputBlock, outputBlock));
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    expectWithinAbsoluteError (output.getSample (channel, i), expected.getSample (channel, i), 1.0e-5f);
+
+            cascade.reset();
+        }
+    }
+};
+
+static MultiChannelCascadeTest multiChannelCascadeTest;
+
+} // namespace juce::dsp::IIR
+
+#undef JUCE_FAIL_ON_ALLOCATION_IN_SCOPE
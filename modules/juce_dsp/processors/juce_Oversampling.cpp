@@ -101,16 +101,117 @@ struct OversamplingDummy final : public Oversampling<SampleType>::OversamplingSt
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OversamplingDummy)
 };
 
+//==============================================================================
+/** Helpers for the FIR oversampling stages, which filter groups of channels at
+    once by interleaving them into the lanes of a SIMDRegister.
+*/
+template <typename SampleType>
+struct OversamplingChannelGroups
+{
+   #if JUCE_USE_SIMD
+    using Lanes = SIMDRegister<SampleType>;
+   #else
+    using Lanes = SampleType;
+   #endif
+
+    static constexpr size_t numLanes = sizeof (Lanes) / sizeof (SampleType);
+
+    static size_t getNumGroups (size_t numChannels) noexcept
+    {
+        return (numChannels + numLanes - 1) / numLanes;
+    }
+
+    static void interleave (const AudioBlock<const SampleType>& block, size_t group, Lanes* dest) noexcept
+    {
+        auto* samples = reinterpret_cast<SampleType*> (dest);
+        const auto numSamples = block.getNumSamples();
+        const auto firstChannel = group * numLanes;
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            if (firstChannel + lane < block.getNumChannels())
+            {
+                auto* src = block.getChannelPointer (firstChannel + lane);
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    samples[i * numLanes + lane] = src[i];
+            }
+            else
+            {
+                for (size_t i = 0; i < numSamples; ++i)
+                    samples[i * numLanes + lane] = 0;
+            }
+        }
+    }
+
+    static void deinterleave (const Lanes* source, const AudioBlock<SampleType>& block, size_t group) noexcept
+    {
+        auto* samples = reinterpret_cast<const SampleType*> (source);
+        const auto numSamples = block.getNumSamples();
+        const auto firstChannel = group * numLanes;
+
+        for (size_t lane = 0; lane < numLanes && firstChannel + lane < block.getNumChannels(); ++lane)
+        {
+            auto* dst = block.getChannelPointer (firstChannel + lane);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                dst[i] = samples[i * numLanes + lane];
+        }
+    }
+
+    /** The most recent samples of each group of channels. Every sample is stored
+        twice, so that the window of samples is always contiguous in memory.
+    */
+    struct History
+    {
+        void setSize (size_t numGroups, size_t newLength)
+        {
+            length = newLength;
+            data.assign (numGroups * length * 2, Lanes());
+            positions.assign (numGroups, 0);
+        }
+
+        void clear() noexcept
+        {
+            std::fill (data.begin(), data.end(), Lanes());
+            std::fill (positions.begin(), positions.end(), (size_t) 0);
+        }
+
+        /** Adds a sample, and returns the window of samples with the newest one first. */
+        const Lanes* push (size_t group, Lanes value) noexcept
+        {
+            auto& position = positions[group];
+            position = (position == 0 ? length : position) - 1;
+
+            auto* window = data.data() + group * length * 2 + position;
+            window[0] = value;
+            window[length] = value;
+
+            return window;
+        }
+
+        std::vector<Lanes> data;
+        std::vector<size_t> positions;
+        size_t length = 0;
+    };
+};
+
 //==============================================================================
 /** Oversampling stage class performing 2 times oversampling using the Filter
     Design FIR Equiripple method. The resulting filter is linear phase,
     symmetric, and has every two samples but the middle one equal to zero,
     leading to specific processing optimizations.
+
+    The filter is split into its two polyphase components, so each one runs at
+    the lower sample rate. The zero taps are skipped, the symmetric taps are
+    paired up, and groups of channels are filtered together in SIMD lanes.
 */
 template <typename SampleType>
 struct Oversampling2TimesEquirippleFIR final : public Oversampling<SampleType>::OversamplingStage
 {
     using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+    using Groups = OversamplingChannelGroups<SampleType>;
+    using Lanes = typename Groups::Lanes;
 
     Oversampling2TimesEquirippleFIR (size_t numChans,
                                      SampleType normalisedTransitionWidthUp,
@@ -122,17 +223,15 @@ struct Oversampling2TimesEquirippleFIR final : public Oversampling<SampleType>::
         coefficientsUp   = *FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthUp,   stopbandAmplitudedBUp);
         coefficientsDown = *FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthDown, stopbandAmplitudedBDown);
 
-        auto N = coefficientsUp.getFilterOrder() + 1;
-        stateUp.setSize (static_cast<int> (this->numChannels), static_cast<int> (N));
-
-        N = coefficientsDown.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
-        auto Ndiv4 = Ndiv2 / 2;
+        // The upsampled signal has every other sample equal to zero, so the
+        // upsampling filter gets a gain of two
+        initFilter (coefficientsUp, 2, tapsUp, centreUp);
+        initFilter (coefficientsDown, 1, tapsDown, centreDown);
 
-        stateDown.setSize  (static_cast<int> (this->numChannels), static_cast<int> (N));
-        stateDown2.setSize (static_cast<int> (this->numChannels), static_cast<int> (Ndiv4 + 1));
-
-        position.resize (static_cast<int> (this->numChannels));
+        auto numGroups = Groups::getNumGroups (this->numChannels);
+        historyUp.setSize (numGroups, coefficientsUp.getFilterOrder() / 2 + 1);
+        historyDown.setSize (numGroups, coefficientsDown.getFilterOrder() / 2 + 1);
+        historyDownOdd.setSize (numGroups, tapsDown.size() + 1);
     }
 
     //==============================================================================
@@ -141,15 +240,21 @@ struct Oversampling2TimesEquirippleFIR final : public Oversampling<SampleType>::
         return static_cast<SampleType> (coefficientsUp.getFilterOrder() + coefficientsDown.getFilterOrder()) * 0.5f;
     }
 
+    void initProcessing (size_t maximumNumberOfSamplesBeforeOversampling) override
+    {
+        ParentType::initProcessing (maximumNumberOfSamplesBeforeOversampling);
+
+        scratchIn .assign (maximumNumberOfSamplesBeforeOversampling * 2, Lanes());
+        scratchOut.assign (maximumNumberOfSamplesBeforeOversampling * 2, Lanes());
+    }
+
     void reset() override
     {
         ParentType::reset();
 
-        stateUp.clear();
-        stateDown.clear();
-        stateDown2.clear();
-
-        position.fill (0);
+        historyUp.clear();
+        historyDown.clear();
+        historyDownOdd.clear();
     }
 
     void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
@@ -158,37 +263,33 @@ struct Oversampling2TimesEquirippleFIR final : public Oversampling<SampleType>::
         jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
 
         // Initialization
-        auto fir = coefficientsUp.getRawCoefficients();
-        auto N = coefficientsUp.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
+        auto* taps = tapsUp.data();
+        auto numPairs = tapsUp.size();
+        auto last = historyUp.length - 1;
         auto numSamples = inputBlock.getNumSamples();
+        auto outputBlock = ParentType::getProcessedSamples (numSamples * 2).getSubsetChannelBlock (0, inputBlock.getNumChannels());
 
         // Processing
-        for (size_t channel = 0; channel < inputBlock.getNumChannels(); ++channel)
+        for (size_t group = 0; group < Groups::getNumGroups (inputBlock.getNumChannels()); ++group)
         {
-            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto buf = stateUp.getWritePointer (static_cast<int> (channel));
-            auto samples = inputBlock.getChannelPointer (channel);
+            Groups::interleave (inputBlock, group, scratchIn.data());
 
             for (size_t i = 0; i < numSamples; ++i)
             {
-                // Input
-                buf[N - 1] = 2 * samples[i];
+                auto* window = historyUp.push (group, scratchIn[i]);
 
-                // Convolution
-                auto out = static_cast<SampleType> (0.0);
+                // Convolution with the symmetric taps
+                auto out = (window[0] + window[last]) * taps[0];
 
-                for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
+                for (size_t k = 1; k < numPairs; ++k)
+                    out += (window[k] + window[last - k]) * taps[k];
 
                 // Outputs
-                bufferSamples[i << 1] = out;
-                bufferSamples[(i << 1) + 1] = buf[Ndiv2 + 1] * fir[Ndiv2];
-
-                // Shift data
-                for (size_t k = 0; k < N - 2; k += 2)
-                    buf[k] = buf[k + 2];
+                scratchOut[i << 1] = out;
+                scratchOut[(i << 1) + 1] = window[numPairs - 1] * centreUp;
             }
+
+            Groups::deinterleave (scratchOut.data(), outputBlock, group);
         }
     }
 
@@ -198,59 +299,225 @@ struct Oversampling2TimesEquirippleFIR final : public Oversampling<SampleType>::
         jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
 
         // Initialization
-        auto fir = coefficientsDown.getRawCoefficients();
-        auto N = coefficientsDown.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
-        auto Ndiv4 = Ndiv2 / 2;
+        auto* taps = tapsDown.data();
+        auto numPairs = tapsDown.size();
+        auto last = historyDown.length - 1;
         auto numSamples = outputBlock.getNumSamples();
+        auto inputBlock = AudioBlock<const SampleType> (ParentType::getProcessedSamples (numSamples * 2))
+                              .getSubsetChannelBlock (0, outputBlock.getNumChannels());
 
         // Processing
-        for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
+        for (size_t group = 0; group < Groups::getNumGroups (outputBlock.getNumChannels()); ++group)
         {
-            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto buf = stateDown.getWritePointer (static_cast<int> (channel));
-            auto buf2 = stateDown2.getWritePointer (static_cast<int> (channel));
-            auto samples = outputBlock.getChannelPointer (channel);
-            auto pos = position.getUnchecked (static_cast<int> (channel));
+            Groups::interleave (inputBlock, group, scratchIn.data());
 
             for (size_t i = 0; i < numSamples; ++i)
             {
-                // Input
-                buf[N - 1] = bufferSamples[i << 1];
+                auto* window = historyDown.push (group, scratchIn[i << 1]);
+                auto* delayed = historyDownOdd.push (group, scratchIn[(i << 1) + 1]);
 
-                // Convolution
-                auto out = static_cast<SampleType> (0.0);
+                // Convolution with the symmetric taps on the even samples
+                auto out = (window[0] + window[last]) * taps[0];
 
-                for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
+                for (size_t k = 1; k < numPairs; ++k)
+                    out += (window[k] + window[last - k]) * taps[k];
 
-                // Output
-                out += buf2[pos] * fir[Ndiv2];
-                buf2[pos] = bufferSamples[(i << 1) + 1];
+                // The odd samples only meet the centre tap
+                scratchOut[i] = out + delayed[numPairs] * centreDown;
+            }
+
+            Groups::deinterleave (scratchOut.data(), outputBlock, group);
+        }
+    }
+
+private:
+    //==============================================================================
+    static void initFilter (const FIR::Coefficients<SampleType>& coefficients, SampleType gain,
+                            std::vector<SampleType>& taps, SampleType& centre)
+    {
+        auto* fir = coefficients.getRawCoefficients();
+        auto Ndiv2 = (coefficients.getFilterOrder() + 1) / 2;
+
+        taps.clear();
+
+        for (size_t k = 0; k < Ndiv2; k += 2)
+            taps.push_back (fir[k] * gain);
 
-                samples[i] = out;
+        centre = fir[Ndiv2] * gain;
+    }
+
+    //==============================================================================
+    FIR::Coefficients<SampleType> coefficientsUp, coefficientsDown;
+    std::vector<SampleType> tapsUp, tapsDown;
+    SampleType centreUp = 0, centreDown = 0;
+
+    typename Groups::History historyUp, historyDown, historyDownOdd;
+    std::vector<Lanes> scratchIn, scratchOut;
 
-                // Shift data
-                for (size_t k = 0; k < N - 2; ++k)
-                    buf[k] = buf[k + 2];
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesEquirippleFIR)
+};
 
-                // Circular buffer
-                pos = (pos == 0 ? Ndiv4 : pos - 1);
+
+//==============================================================================
+/** Oversampling stage class performing 2 times oversampling using the Filter
+    Design FIR Minimum Phase method. The resulting filter has the same magnitude
+    response as the equiripple one, but a much lower latency.
+
+    There are no zero taps in a minimum phase filter, but it is still split into
+    its two polyphase components, and groups of channels are filtered together
+    in SIMD lanes.
+*/
+template <typename SampleType>
+struct Oversampling2TimesMinimumPhaseFIR final : public Oversampling<SampleType>::OversamplingStage
+{
+    using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+    using Groups = OversamplingChannelGroups<SampleType>;
+    using Lanes = typename Groups::Lanes;
+
+    Oversampling2TimesMinimumPhaseFIR (size_t numChans,
+                                       SampleType normalisedTransitionWidthUp,
+                                       SampleType stopbandAmplitudedBUp,
+                                       SampleType normalisedTransitionWidthDown,
+                                       SampleType stopbandAmplitudedBDown)
+        : ParentType (numChans, 2)
+    {
+        auto coefficientsUp   = FilterDesign<SampleType>::designFIRLowpassHalfBandMinimumPhaseMethod (normalisedTransitionWidthUp,   stopbandAmplitudedBUp);
+        auto coefficientsDown = FilterDesign<SampleType>::designFIRLowpassHalfBandMinimumPhaseMethod (normalisedTransitionWidthDown, stopbandAmplitudedBDown);
+
+        latency = getGroupDelayAtDC (*coefficientsUp) + getGroupDelayAtDC (*coefficientsDown);
+
+        splitPhases (*coefficientsUp, 2, evenTapsUp, oddTapsUp);
+        splitPhases (*coefficientsDown, 1, evenTapsDown, oddTapsDown);
+
+        auto numGroups = Groups::getNumGroups (this->numChannels);
+        historyUp.setSize (numGroups, evenTapsUp.size());
+        historyDown.setSize (numGroups, evenTapsDown.size());
+        historyDownOdd.setSize (numGroups, oddTapsDown.size() + 1);
+    }
+
+    //==============================================================================
+    SampleType getLatencyInSamples() const override
+    {
+        return latency;
+    }
+
+    void initProcessing (size_t maximumNumberOfSamplesBeforeOversampling) override
+    {
+        ParentType::initProcessing (maximumNumberOfSamplesBeforeOversampling);
+
+        scratchIn .assign (maximumNumberOfSamplesBeforeOversampling * 2, Lanes());
+        scratchOut.assign (maximumNumberOfSamplesBeforeOversampling * 2, Lanes());
+    }
+
+    void reset() override
+    {
+        ParentType::reset();
+
+        historyUp.clear();
+        historyDown.clear();
+        historyDownOdd.clear();
+    }
+
+    void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
+    {
+        jassert (inputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        auto numSamples = inputBlock.getNumSamples();
+        auto outputBlock = ParentType::getProcessedSamples (numSamples * 2).getSubsetChannelBlock (0, inputBlock.getNumChannels());
+
+        for (size_t group = 0; group < Groups::getNumGroups (inputBlock.getNumChannels()); ++group)
+        {
+            Groups::interleave (inputBlock, group, scratchIn.data());
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                auto* window = historyUp.push (group, scratchIn[i]);
+
+                scratchOut[i << 1]       = convolve (window, evenTapsUp);
+                scratchOut[(i << 1) + 1] = convolve (window, oddTapsUp);
             }
 
-            position.setUnchecked (static_cast<int> (channel), pos);
+            Groups::deinterleave (scratchOut.data(), outputBlock, group);
         }
+    }
+
+    void processSamplesDown (AudioBlock<SampleType>& outputBlock) override
+    {
+        jassert (outputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        auto numSamples = outputBlock.getNumSamples();
+        auto inputBlock = AudioBlock<const SampleType> (ParentType::getProcessedSamples (numSamples * 2))
+                              .getSubsetChannelBlock (0, outputBlock.getNumChannels());
+
+        for (size_t group = 0; group < Groups::getNumGroups (outputBlock.getNumChannels()); ++group)
+        {
+            Groups::interleave (inputBlock, group, scratchIn.data());
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                auto* window = historyDown.push (group, scratchIn[i << 1]);
+                auto* delayed = historyDownOdd.push (group, scratchIn[(i << 1) + 1]);
+
+                // The odd samples are one sample older than the even samples at the lower rate
+                scratchOut[i] = convolve (window, evenTapsDown) + convolve (delayed + 1, oddTapsDown);
+            }
 
+            Groups::deinterleave (scratchOut.data(), outputBlock, group);
+        }
     }
 
 private:
     //==============================================================================
-    FIR::Coefficients<SampleType> coefficientsUp, coefficientsDown;
-    AudioBuffer<SampleType> stateUp, stateDown, stateDown2;
-    Array<size_t> position;
+    static Lanes convolve (const Lanes* window, const std::vector<SampleType>& taps) noexcept
+    {
+        auto out = window[0] * taps[0];
+
+        for (size_t k = 1; k < taps.size(); ++k)
+            out += window[k] * taps[k];
+
+        return out;
+    }
+
+    static void splitPhases (const FIR::Coefficients<SampleType>& coefficients, SampleType gain,
+                             std::vector<SampleType>& evenTaps, std::vector<SampleType>& oddTaps)
+    {
+        auto* fir = coefficients.getRawCoefficients();
+        auto N = coefficients.getFilterOrder() + 1;
+
+        for (size_t k = 0; k < N; ++k)
+            (k % 2 == 0 ? evenTaps : oddTaps).push_back (fir[k] * gain);
+
+        if (oddTaps.empty())
+            oddTaps.push_back (0);
+    }
+
+    static SampleType getGroupDelayAtDC (const FIR::Coefficients<SampleType>& coefficients)
+    {
+        auto* fir = coefficients.getRawCoefficients();
+        auto N = coefficients.getFilterOrder() + 1;
+        double weightedSum = 0.0, sum = 0.0;
+
+        for (size_t k = 0; k < N; ++k)
+        {
+            weightedSum += (double) k * (double) fir[k];
+            sum += (double) fir[k];
+        }
+
+        return static_cast<SampleType> (weightedSum / sum);
+    }
 
     //==============================================================================
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesEquirippleFIR)
+    std::vector<SampleType> evenTapsUp, oddTapsUp, evenTapsDown, oddTapsDown;
+    SampleType latency = 0;
+
+    typename Groups::History historyUp, historyDown, historyDownOdd;
+    std::vector<Lanes> scratchIn, scratchOut;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesMinimumPhaseFIR)
 };
 
 
@@ -565,7 +832,8 @@ Oversampling<SampleType>::Oversampling (size_t newNumChannels, size_t newFactor,
                                   twDown, gaindBStartDown + gaindBFactorDown * (float) n);
         }
     }
-    else if (newType == FilterType::filterHalfBandFIREquiripple)
+    else if (newType == FilterType::filterHalfBandFIREquiripple
+             || newType == FilterType::filterHalfBandFIRMinimumPhase)
     {
         for (size_t n = 0; n < newFactor; ++n)
         {
@@ -577,7 +845,7 @@ Oversampling<SampleType>::Oversampling (size_t newNumChannels, size_t newFactor,
             auto gaindBFactorUp   = (isMaximumQuality ? 10.0f  : 8.0f);
             auto gaindBFactorDown = (isMaximumQuality ? 10.0f  : 8.0f);
 
-            addOversamplingStage (FilterType::filterHalfBandFIREquiripple,
+            addOversamplingStage (newType,
                                   twUp, gaindBStartUp + gaindBFactorUp * (float) n,
                                   twDown, gaindBStartDown + gaindBFactorDown * (float) n);
         }
@@ -610,6 +878,12 @@ void Oversampling<SampleType>::addOversamplingStage (FilterType type,
                                                                     normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
                                                                     normalisedTransitionWidthDown, stopbandAmplitudedBDown));
     }
+    else if (type == FilterType::filterHalfBandFIRMinimumPhase)
+    {
+        stages.add (new Oversampling2TimesMinimumPhaseFIR<SampleType> (numChannels,
+                                                                       normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
+                                                                       normalisedTransitionWidthDown, stopbandAmplitudedBDown));
+    }
     else
     {
         stages.add (new Oversampling2TimesEquirippleFIR<SampleType> (numChannels,
@@ -43,7 +43,9 @@ namespace juce::dsp
     Choose between FIR or IIR filtering depending on your needs in terms of
     latency and phase distortion. With FIR filters the phase is linear but the
     latency is maximised. With IIR filtering the phase is compromised around the
-    Nyquist frequency but the latency is minimised.
+    Nyquist frequency but the latency is minimised. The minimum phase FIR filters
+    have the same magnitude response as the linear phase ones, with a latency
+    close to that of the IIR filters, at a higher CPU cost.
 
     @see FilterDesign.
 
@@ -58,6 +60,7 @@ public:
     {
         filterHalfBandFIREquiripple = 0,
         filterHalfBandPolyphaseIIR,
+        filterHalfBandFIRMinimumPhase,
         numFilterTypes
     };
 
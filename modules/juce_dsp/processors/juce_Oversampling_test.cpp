@@ -0,0 +1,245 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+class OversamplingTest final : public UnitTest
+{
+public:
+    OversamplingTest()
+        : UnitTest ("Oversampling", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        using FilterType = Oversampling<float>::FilterType;
+
+        beginTest ("Equiripple FIR stage matches a direct convolution");
+        {
+            auto coefficients = FilterDesign<float>::designFIRLowpassHalfBandEquirippleMethod (0.1f, -70.0f);
+            expectStageMatchesConvolution (FilterType::filterHalfBandFIREquiripple, *coefficients, 3);
+            expectStageMatchesConvolution (FilterType::filterHalfBandFIREquiripple, *coefficients, 9);
+        }
+
+        beginTest ("Minimum phase FIR stage matches a direct convolution");
+        {
+            auto coefficients = FilterDesign<float>::designFIRLowpassHalfBandMinimumPhaseMethod (0.1f, -70.0f);
+            expectStageMatchesConvolution (FilterType::filterHalfBandFIRMinimumPhase, *coefficients, 3);
+            expectStageMatchesConvolution (FilterType::filterHalfBandFIRMinimumPhase, *coefficients, 9);
+        }
+
+        beginTest ("Minimum phase FIR design keeps the stop band attenuation");
+        {
+            auto linearPhase  = FilterDesign<float>::designFIRLowpassHalfBandEquirippleMethod  (0.1f, -80.0f);
+            auto minimumPhase = FilterDesign<float>::designFIRLowpassHalfBandMinimumPhaseMethod (0.1f, -80.0f);
+
+            for (auto frequency : { 0.0, 0.1, 0.2, 0.35 })
+                expectWithinAbsoluteError (minimumPhase->getMagnitudeForFrequency (frequency, 1.0),
+                                           linearPhase ->getMagnitudeForFrequency (frequency, 1.0),
+                                           1.0e-3);
+
+            for (auto frequency = 0.31; frequency < 0.5; frequency += 0.01)
+                expectLessThan (Decibels::gainToDecibels (minimumPhase->getMagnitudeForFrequency (frequency, 1.0)), -75.0);
+        }
+
+        beginTest ("Minimum phase FIR filtering has a lower latency");
+        {
+            Oversampling<float> linearPhase  (2, 2, FilterType::filterHalfBandFIREquiripple);
+            Oversampling<float> minimumPhase (2, 2, FilterType::filterHalfBandFIRMinimumPhase);
+
+            expectLessThan (minimumPhase.getLatencyInSamples(), linearPhase.getLatencyInSamples() * 0.25f);
+        }
+
+        beginTest ("Low frequencies pass through with the reported latency");
+        {
+            for (auto type : { FilterType::filterHalfBandFIREquiripple,
+                               FilterType::filterHalfBandPolyphaseIIR,
+                               FilterType::filterHalfBandFIRMinimumPhase })
+            {
+                for (size_t factor = 1; factor <= 3; ++factor)
+                {
+                    Oversampling<float> oversampling (2, factor, type, true, true);
+                    oversampling.initProcessing (256);
+
+                    const auto latency = roundToInt (oversampling.getLatencyInSamples());
+                    const auto frequency = 0.005;
+                    const auto sine = [&] (int i) { return (float) std::sin (MathConstants<double>::twoPi * frequency * i); };
+
+                    AudioBuffer<float> buffer (2, 256);
+                    auto maxError = 0.0f;
+
+                    for (int block = 0; block < 16; ++block)
+                    {
+                        for (int channel = 0; channel < 2; ++channel)
+                            for (int i = 0; i < 256; ++i)
+                                buffer.setSample (channel, i, sine (block * 256 + i));
+
+                        AudioBlock<float> audioBlock (buffer);
+                        oversampling.processSamplesUp (audioBlock);
+                        oversampling.processSamplesDown (audioBlock);
+
+                        if (block > 4)
+                            for (int channel = 0; channel < 2; ++channel)
+                                for (int i = 0; i < 256; ++i)
+                                    maxError = jmax (maxError, std::abs (buffer.getSample (channel, i) - sine (block * 256 + i - latency)));
+                    }
+
+                    expectLessThan (maxError, 0.01f);
+                }
+            }
+        }
+
+        beginTest ("Benchmark");
+        {
+            constexpr int blockSize = 512, numBlocks = 50;
+
+            for (auto [type, typeName] : { std::pair (FilterType::filterHalfBandFIREquiripple,   "FIR equiripple"),
+                                       std::pair (FilterType::filterHalfBandPolyphaseIIR,    "IIR polyphase"),
+                                       std::pair (FilterType::filterHalfBandFIRMinimumPhase, "FIR minimum phase") })
+            {
+                for (auto numChannels : { 2, 8 })
+                {
+                    String message;
+                    message << typeName << ", " << numChannels << " channels:";
+                    double previousTime = 0.0;
+
+                    for (size_t factor = 1; factor <= 3; ++factor)
+                    {
+                        Oversampling<float> oversampling ((size_t) numChannels, factor, type);
+                        oversampling.initProcessing (blockSize);
+
+                        AudioBuffer<float> buffer (numChannels, blockSize);
+                        buffer.clear();
+                        AudioBlock<float> audioBlock (buffer);
+
+                        auto time = std::numeric_limits<double>::max();
+
+                        for (int repeat = 0; repeat < 5; ++repeat)
+                        {
+                            const auto start = Time::getHighResolutionTicks();
+
+                            for (int i = 0; i < numBlocks; ++i)
+                            {
+                                oversampling.processSamplesUp (audioBlock);
+                                oversampling.processSamplesDown (audioBlock);
+                            }
+
+                            time = jmin (time, Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start) * 1000.0);
+                        }
+                        message << " stage " << (int) factor << " " << String (time - previousTime, 2) << " ms,";
+                        previousTime = time;
+                    }
+
+                    logMessage (message.dropLastCharacters (1));
+                }
+            }
+        }
+    }
+
+private:
+    void expectStageMatchesConvolution (Oversampling<float>::FilterType type,
+                                        const FIR::Coefficients<float>& coefficients,
+                                        int numChannels)
+    {
+        constexpr int blockSize = 100, numBlocks = 3, numSamples = blockSize * numBlocks;
+
+        Oversampling<float> oversampling ((size_t) numChannels);
+        oversampling.clearOversamplingStages();
+        oversampling.addOversamplingStage (type, 0.1f, -70.0f, 0.1f, -70.0f);
+        oversampling.initProcessing (blockSize);
+
+        const auto* fir = coefficients.getRawCoefficients();
+        const auto numTaps = (int) coefficients.getFilterOrder() + 1;
+
+        Random random (0x5eed);
+        AudioBuffer<float> input (numChannels, numSamples), upsampled (numChannels, numSamples * 2), downsampled (numChannels, numSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        auto maxErrorUp = 0.0, maxErrorDown = 0.0;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            const auto offset = block * blockSize;
+            auto inputBlock = AudioBlock<float> (input).getSubBlock ((size_t) offset, (size_t) blockSize);
+            auto output = oversampling.processSamplesUp (inputBlock);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                for (int i = 0; i < blockSize * 2; ++i)
+                {
+                    // The input is upsampled by inserting zeros, and filtered with a gain of two
+                    auto expected = 0.0;
+
+                    for (int k = 0; k < numTaps; ++k)
+                    {
+                        const auto index = 2 * offset + i - k;
+
+                        if (index >= 0 && index % 2 == 0)
+                            expected += 2.0 * fir[k] * input.getSample (channel, index / 2);
+                    }
+
+                    maxErrorUp = jmax (maxErrorUp, std::abs (expected - output.getSample ((size_t) channel, (size_t) i)));
+
+                    // Replace the upsampled signal with noise, to test the downsampling filter
+                    const auto sample = random.nextFloat() * 2.0f - 1.0f;
+                    upsampled.setSample (channel, 2 * offset + i, sample);
+                    output.setSample ((int) channel, i, sample);
+                }
+            }
+
+            auto outputBlock = AudioBlock<float> (downsampled).getSubBlock ((size_t) offset, (size_t) blockSize);
+            oversampling.processSamplesDown (outputBlock);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    auto expected = 0.0;
+
+                    for (int k = 0; k < numTaps; ++k)
+                    {
+                        const auto index = 2 * (offset + i) - k;
+
+                        if (index >= 0)
+                            expected += fir[k] * upsampled.getSample (channel, index);
+                    }
+
+                    maxErrorDown = jmax (maxErrorDown, std::abs (expected - downsampled.getSample (channel, offset + i)));
+                }
+            }
+        }
+
+        expectLessThan (maxErrorUp, 1.0e-5);
+        expectLessThan (maxErrorDown, 1.0e-5);
+    }
+};
+
+static OversamplingTest oversamplingTest;
+
+} // namespace juce::dsp
@@ -0,0 +1,370 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+namespace PolyphaseResamplerHelpers
+{
+   #if JUCE_USE_SIMD
+    using Register = SIMDRegister<float>;
+    static constexpr int vectorSize = (int) Register::SIMDNumElements;
+   #else
+    static constexpr int vectorSize = 1;
+   #endif
+
+    // Finds the fraction L / M closest to outputRate / inputRate, with L no larger than the
+    // maximum number of phases, using its continued fraction expansion
+    static std::pair<int, int> findRatio (double inputSampleRate, double outputSampleRate)
+    {
+        const auto target = outputSampleRate / inputSampleRate;
+        auto x = target;
+
+        int64 h0 = 0, h1 = 1, k0 = 1, k1 = 0;
+        std::pair<int, int> result { 1, jmax (1, roundToInt (1.0 / target)) };
+
+        for (int i = 0; i < 64; ++i)
+        {
+            const auto a = (int64) std::floor (x);
+            const auto h2 = a * h1 + h0;
+            const auto k2 = a * k1 + k0;
+
+            if (h2 > PolyphaseResampler::maximumNumPhases || k2 > (1 << 24))
+                break;
+
+            if (h2 > 0)
+                result = { (int) h2, (int) k2 };
+
+            h0 = h1; h1 = h2;
+            k0 = k1; k1 = k2;
+
+            const auto remainder = x - (double) a;
+
+            if (h2 > 0 && std::abs ((double) h2 / (double) k2 - target) <= target * 1.0e-12)
+                break;
+
+            if (remainder < 1.0e-12)
+                break;
+
+            x = 1.0 / remainder;
+        }
+
+        return result;
+    }
+
+    static float dotProduct (const float* taps, const float* samples, int numTaps) noexcept
+    {
+       #if JUCE_USE_SIMD
+        auto sumA = Register::expand (0.0f);
+        auto sumB = Register::expand (0.0f);
+
+        for (int i = 0; i < numTaps; i += 2 * vectorSize)
+        {
+            sumA = Register::multiplyAdd (sumA, Register::fromRawArray (taps + i), Register::fromRawArray (samples + i));
+            sumB = Register::multiplyAdd (sumB, Register::fromRawArray (taps + i + vectorSize), Register::fromRawArray (samples + i + vectorSize));
+        }
+
+        return (sumA + sumB).sum();
+       #else
+        auto sum = 0.0f;
+
+        for (int i = 0; i < numTaps; ++i)
+            sum += taps[i] * samples[i];
+
+        return sum;
+       #endif
+    }
+}
+
+//==============================================================================
+PolyphaseResampler::PolyphaseResampler (double inputSampleRate, double outputSampleRate, Quality quality)
+{
+    jassert (inputSampleRate > 0 && outputSampleRate > 0);
+
+    std::tie (upsampling, downsampling) = PolyphaseResamplerHelpers::findRatio (inputSampleRate, outputSampleRate);
+    stepSamples = downsampling / upsampling;
+    stepPhase = downsampling % upsampling;
+    designFilter (quality);
+}
+
+PolyphaseResampler::~PolyphaseResampler() = default;
+
+void PolyphaseResampler::designFilter (Quality quality)
+{
+    const auto [taps, beta, passband] = [&]
+    {
+        switch (quality)
+        {
+            case Quality::low:      return std::tuple (16, 5.7, 0.80);
+            case Quality::high:     return std::tuple (64, 12.3, 0.92);
+            case Quality::medium:   break;
+        }
+
+        return std::tuple (32, 9.0, 0.87);
+    }();
+
+    // The taps span a fixed number of input samples, so when downsampling by M / L the filter
+    // has to be that much longer, to keep its transition band the same width relative to
+    // the output rate. The number of taps is rounded up to suit the vectorised dot product.
+    numTaps = ((int) std::ceil (taps * jmax (1.0, (double) downsampling / upsampling)) + 15) & ~15;
+
+    // The prototype runs at the upsampled rate, and must remove everything above the
+    // lower of the two Nyquist frequencies
+    const auto length = (size_t) (numTaps * upsampling);
+    const auto cutoff = 0.5 * passband / jmax (upsampling, downsampling);
+    const auto centre = (double) (length - 1) * 0.5;
+
+    std::vector<double> prototype (length);
+    WindowingFunction<double>::fillWindowingTables (prototype.data(), length, WindowingFunction<double>::kaiser, false, beta);
+
+    auto sum = 0.0;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        const auto t = 2.0 * cutoff * ((double) i - centre);
+        const auto sinc = approximatelyEqual (t, 0.0) ? 1.0 : std::sin (MathConstants<double>::pi * t) / (MathConstants<double>::pi * t);
+        prototype[i] *= 2.0 * cutoff * sinc;
+        sum += prototype[i];
+    }
+
+    // Each phase is applied to one in every L samples of the zero-stuffed input, so the
+    // overall gain has to be L
+    const auto gain = upsampling / sum;
+
+    phases = AudioBlock<float> (phaseStorage, (size_t) upsampling, (size_t) numTaps);
+
+    for (int phase = 0; phase < upsampling; ++phase)
+    {
+        auto* row = phases.getChannelPointer ((size_t) phase);
+
+        for (int tap = 0; tap < numTaps; ++tap)
+            row[numTaps - 1 - tap] = (float) (prototype[(size_t) (phase + tap * upsampling)] * gain);
+    }
+}
+
+//==============================================================================
+void PolyphaseResampler::prepare (const ProcessSpec& spec)
+{
+    using namespace PolyphaseResamplerHelpers;
+
+    numChannels = (int) spec.numChannels;
+    maxChunkSize = jmax (1, (int) spec.maximumBlockSize);
+
+    // The history holds one more sample than the filter needs, for outputs that fall just
+    // before the start of a chunk. Padding each copy to a multiple of 16 samples keeps every
+    // copy aligned.
+    historySize = (numTaps + maxChunkSize + vectorSize + 15) & ~15;
+    history = AudioBlock<float> (historyStorage, (size_t) (numChannels * vectorSize), (size_t) historySize);
+
+    reset();
+}
+
+void PolyphaseResampler::reset() noexcept
+{
+    history.clear();
+    position = 0;
+}
+
+//==============================================================================
+int PolyphaseResampler::process (const AudioBlock<const float>& input, AudioBlock<float>& output) noexcept
+{
+    using namespace PolyphaseResamplerHelpers;
+
+    jassert ((int) output.getNumSamples() >= getNumOutputSamplesFor ((int) input.getNumSamples()));
+
+    const auto numChannelsToUse = (int) jmin (input.getNumChannels(), output.getNumChannels(), (size_t) numChannels);
+    const auto numInput = (int) input.getNumSamples();
+    const auto maxOutput = (int) output.getNumSamples();
+    int numRead = 0, numWritten = 0;
+
+    // This runs at least once, because there may be outputs left over from the previous
+    // call which don't need any more input
+    do
+    {
+        const auto num = jmin (numInput - numRead, maxChunkSize);
+
+        for (int channel = 0; channel < numChannelsToUse; ++channel)
+        {
+            auto* samples = history.getChannelPointer ((size_t) (channel * vectorSize));
+
+            FloatVectorOperations::copy (samples + numTaps, input.getChannelPointer ((size_t) channel) + numRead, num);
+
+            for (int shift = 1; shift < vectorSize; ++shift)
+                FloatVectorOperations::copy (history.getChannelPointer ((size_t) (channel * vectorSize + shift)),
+                                             samples + shift,
+                                             numTaps + num - shift);
+        }
+
+        const auto end = (int64) num * upsampling;
+
+        // The position can be up to one input sample before the start of this chunk, in
+        // which case the dot product uses the extra sample at the start of the history.
+        // The position is split into a start sample and a phase, to avoid dividing for
+        // every output.
+        auto start = (int) ((position + upsampling) / upsampling);
+        auto phase = (int) ((position + upsampling) % upsampling);
+
+        for (; start <= num && numWritten < maxOutput; ++numWritten)
+        {
+            const auto* taps = phases.getChannelPointer ((size_t) phase);
+            const auto shift = start % vectorSize;
+
+            for (int channel = 0; channel < numChannelsToUse; ++channel)
+            {
+                const auto* samples = history.getChannelPointer ((size_t) (channel * vectorSize + shift)) + (start - shift);
+                output.setSample (channel, numWritten, dotProduct (taps, samples, numTaps));
+            }
+
+            start += stepSamples;
+            phase += stepPhase;
+
+            if (phase >= upsampling)
+            {
+                phase -= upsampling;
+                ++start;
+            }
+        }
+
+        position = (int64) (start - 1) * upsampling + phase;
+
+        // If the output block was too small, some output will have been skipped
+        jassert (position >= end - upsampling);
+        position = jmax (position - end, (int64) -upsampling);
+
+        // Keep the most recent samples as the history for the next chunk
+        for (int channel = 0; channel < numChannelsToUse; ++channel)
+        {
+            auto* samples = history.getChannelPointer ((size_t) (channel * vectorSize));
+            std::memmove (samples, samples + num, (size_t) numTaps * sizeof (float));
+        }
+
+        numRead += num;
+    }
+    while (numRead < numInput);
+
+    return numWritten;
+}
+
+int PolyphaseResampler::getNumOutputSamplesFor (int numInputSamples) const noexcept
+{
+    const auto end = (int64) numInputSamples * upsampling;
+    return position < end ? (int) ((end - position + downsampling - 1) / downsampling) : 0;
+}
+
+int PolyphaseResampler::getNumInputSamplesNeededFor (int numOutputSamples) const noexcept
+{
+    const auto lastPosition = position + (int64) (numOutputSamples - 1) * downsampling;
+    return numOutputSamples > 0 && lastPosition >= 0 ? (int) (lastPosition / upsampling) + 1 : 0;
+}
+
+double PolyphaseResampler::getLatencyInInputSamples() const noexcept
+{
+    return (double) (numTaps * upsampling - 1) / (2.0 * upsampling);
+}
+
+//==============================================================================
+PolyphaseResamplingAudioSource::PolyphaseResamplingAudioSource (AudioSource* inputSource,
+                                                                bool deleteInputWhenDeleted,
+                                                                double inputRate,
+                                                                int channels,
+                                                                PolyphaseResampler::Quality qualityToUse)
+    : input (inputSource, deleteInputWhenDeleted),
+      inputSampleRate (inputRate),
+      numChannels (channels),
+      quality (qualityToUse)
+{
+    jassert (input != nullptr);
+}
+
+PolyphaseResamplingAudioSource::~PolyphaseResamplingAudioSource() = default;
+
+void PolyphaseResamplingAudioSource::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
+{
+    const ScopedLock sl (callbackLock);
+
+    resampler = std::make_unique<PolyphaseResampler> (inputSampleRate, sampleRate, quality);
+    maxOutputChunkSize = jmax (1, samplesPerBlockExpected);
+
+    // The resampler's position is always less than M, so this is the most input that a
+    // chunk of output can need
+    const auto maxInputChunkSize = (int) ((int64) maxOutputChunkSize * resampler->getDownsamplingFactor()
+                                            / resampler->getUpsamplingFactor()) + 2;
+
+    resampler->prepare ({ sampleRate, (uint32) maxInputChunkSize, (uint32) numChannels });
+    buffer.setSize (numChannels, maxInputChunkSize);
+
+    input->prepareToPlay (maxInputChunkSize, inputSampleRate);
+}
+
+void PolyphaseResamplingAudioSource::releaseResources()
+{
+    input->releaseResources();
+    buffer.setSize (numChannels, 0);
+}
+
+void PolyphaseResamplingAudioSource::flushBuffers()
+{
+    const ScopedLock sl (callbackLock);
+
+    if (resampler != nullptr)
+        resampler->reset();
+}
+
+void PolyphaseResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
+{
+    const ScopedLock sl (callbackLock);
+
+    // prepareToPlay() must be called first!
+    jassert (resampler != nullptr);
+
+    const auto numChannelsToUse = jmin (numChannels, info.buffer->getNumChannels());
+    auto outputBlock = AudioBlock<float> (*info.buffer).getSubsetChannelBlock (0, (size_t) numChannelsToUse);
+
+    for (int done = 0; done < info.numSamples;)
+    {
+        const auto numOutput = jmin (info.numSamples - done, maxOutputChunkSize);
+        const auto numInput = resampler->getNumInputSamplesNeededFor (numOutput);
+
+        jassert (numInput <= buffer.getNumSamples());
+
+        if (numInput > 0)
+        {
+            AudioSourceChannelInfo inputInfo (&buffer, 0, numInput);
+            input->getNextAudioBlock (inputInfo);
+        }
+
+        auto outputChunk = outputBlock.getSubBlock ((size_t) (info.startSample + done), (size_t) numOutput);
+        [[maybe_unused]] const auto numWritten = resampler->process (AudioBlock<const float> (buffer).getSubBlock (0, (size_t) numInput),
+                                                                     outputChunk);
+        jassert (numWritten == numOutput);
+
+        done += numOutput;
+    }
+
+    for (int channel = numChannelsToUse; channel < info.buffer->getNumChannels(); ++channel)
+        info.buffer->clear (channel, info.startSample, info.numSamples);
+}
+
+} // namespace juce::dsp
@@ -0,0 +1,188 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+//==============================================================================
+/**
+    Converts a stream of audio from one sample rate to another, using a polyphase
+    FIR filter bank.
+
+    The ratio between the rates is expressed as a fraction L / M, and the input is
+    conceptually upsampled by L, low-pass filtered and downsampled by M. Only the filter
+    taps that are needed for each output sample are evaluated, using one of L precomputed
+    phases of the filter, and the dot products are vectorised with SIMDRegister.
+
+    Ratios between integer sample rates are represented exactly. Other ratios are
+    approximated by the closest fraction with no more than maximumNumPhases phases.
+
+    @see PolyphaseResamplingAudioSource, Oversampling
+
+    @tags{DSP}
+*/
+class JUCE_API  PolyphaseResampler
+{
+public:
+    /** The quality of the anti-aliasing filter. Higher qualities use more taps per
+        output sample, giving more stop-band attenuation and a wider pass band.
+
+        The stop band starts just above the lower of the two Nyquist frequencies. The
+        numbers of taps below are for upsampling; when downsampling by a factor of M / L,
+        the filter is made M / L times longer so that the attenuation is the same.
+    */
+    enum class Quality
+    {
+        low,    /**< 16 taps per output sample, giving about 60 dB of attenuation. */
+        medium, /**< 32 taps per output sample, giving about 90 dB of attenuation. */
+        high    /**< 64 taps per output sample, giving about 120 dB of attenuation. */
+    };
+
+    /** The largest number of filter phases that will be used. */
+    static constexpr int maximumNumPhases = 4096;
+
+    //==============================================================================
+    /** Creates a resampler that converts from one sample rate to another. */
+    PolyphaseResampler (double inputSampleRate, double outputSampleRate, Quality quality = Quality::medium);
+
+    /** Destructor. */
+    ~PolyphaseResampler();
+
+    //==============================================================================
+    /** Prepares the resampler. The number of channels is taken from the spec, and its
+        maximumBlockSize sets the number of input samples that are processed at a time.
+        Larger input blocks are split up internally.
+    */
+    void prepare (const ProcessSpec&);
+
+    /** Clears the resampler's history. */
+    void reset() noexcept;
+
+    /** Resamples a block of input.
+
+        All of the input will be consumed. The output block must have room for at
+        least getNumOutputSamplesFor (input.getNumSamples()) samples, and the number of
+        samples that were written is returned.
+    */
+    int process (const AudioBlock<const float>& input, AudioBlock<float>& output) noexcept;
+
+    //==============================================================================
+    /** Returns the number of output samples that process() will produce from the given
+        number of input samples, given the resampler's current state.
+    */
+    int getNumOutputSamplesFor (int numInputSamples) const noexcept;
+
+    /** Returns the number of input samples that need to be passed to process() for it to
+        produce exactly the given number of output samples, given the resampler's current state.
+    */
+    int getNumInputSamplesNeededFor (int numOutputSamples) const noexcept;
+
+    /** Returns the upsampling factor L. */
+    int getUpsamplingFactor() const noexcept                    { return upsampling; }
+
+    /** Returns the downsampling factor M. */
+    int getDownsamplingFactor() const noexcept                  { return downsampling; }
+
+    /** Returns the delay introduced by the filter, measured in input samples. */
+    double getLatencyInInputSamples() const noexcept;
+
+private:
+    //==============================================================================
+    void designFilter (Quality);
+
+    int upsampling = 1, downsampling = 1, stepSamples = 0, stepPhase = 0;
+    int numTaps = 0, maxChunkSize = 0, numChannels = 0;
+    int64 position = 0;
+
+    // One row of taps for each phase, reversed so that they line up with the input history
+    HeapBlock<char> phaseStorage;
+    AudioBlock<float> phases;
+
+    // For each channel, copies of the input history shifted by 0 to (SIMD width - 1) samples,
+    // so that every dot product can start at an aligned address
+    HeapBlock<char> historyStorage;
+    AudioBlock<float> history;
+    int historySize = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PolyphaseResampler)
+};
+
+//==============================================================================
+/**
+    An AudioSource that resamples the output of another source using a
+    PolyphaseResampler.
+
+    The source's sample rate is given to the constructor, and its output is converted to
+    the sample rate passed to prepareToPlay().
+
+    @see PolyphaseResampler, ResamplingAudioSource
+
+    @tags{DSP}
+*/
+class JUCE_API  PolyphaseResamplingAudioSource  : public AudioSource
+{
+public:
+    //==============================================================================
+    /** Creates a PolyphaseResamplingAudioSource for a given input source.
+
+        @param inputSource              the input source to read from
+        @param deleteInputWhenDeleted   if true, the input source will be deleted when
+                                        this object is deleted
+        @param inputSampleRate          the sample rate of the input source
+        @param numChannels              the number of channels to process
+        @param quality                  the quality of the resampling filter
+    */
+    PolyphaseResamplingAudioSource (AudioSource* inputSource,
+                                    bool deleteInputWhenDeleted,
+                                    double inputSampleRate,
+                                    int numChannels = 2,
+                                    PolyphaseResampler::Quality quality = PolyphaseResampler::Quality::medium);
+
+    /** Destructor. */
+    ~PolyphaseResamplingAudioSource() override;
+
+    /** Clears the resampler's history. */
+    void flushBuffers();
+
+    //==============================================================================
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock (const AudioSourceChannelInfo&) override;
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<AudioSource> input;
+    const double inputSampleRate;
+    const int numChannels;
+    const PolyphaseResampler::Quality quality;
+    std::unique_ptr<PolyphaseResampler> resampler;
+    AudioBuffer<float> buffer;
+    int maxOutputChunkSize = 0;
+    CriticalSection callbackLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PolyphaseResamplingAudioSource)
+};
+
+} // namespace juce::dsp
@@ -0,0 +1,223 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+class PolyphaseResamplerTest final : public UnitTest
+{
+public:
+    PolyphaseResamplerTest()
+        : UnitTest ("PolyphaseResampler", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Ratios between sample rates are found");
+        {
+            const auto expectRatio = [this] (double inputRate, double outputRate, int upsampling, int downsampling)
+            {
+                PolyphaseResampler resampler (inputRate, outputRate, PolyphaseResampler::Quality::low);
+                expectEquals (resampler.getUpsamplingFactor(), upsampling);
+                expectEquals (resampler.getDownsamplingFactor(), downsampling);
+            };
+
+            expectRatio (44100.0, 48000.0, 160, 147);
+            expectRatio (48000.0, 44100.0, 147, 160);
+            expectRatio (48000.0, 96000.0, 2, 1);
+            expectRatio (96000.0, 32000.0, 1, 3);
+            expectRatio (22050.0, 22050.0, 1, 1);
+        }
+
+        beginTest ("Sine waves are resampled accurately");
+        {
+            for (auto [inputRate, outputRate] : { std::pair (44100.0, 48000.0), std::pair (48000.0, 44100.0), std::pair (96000.0, 44100.0) })
+            {
+                for (auto [quality, maxErrorDecibels] : { std::pair (PolyphaseResampler::Quality::low,    -45.0f),
+                                                          std::pair (PolyphaseResampler::Quality::medium, -75.0f),
+                                                          std::pair (PolyphaseResampler::Quality::high,   -95.0f) })
+                {
+                    PolyphaseResampler resampler (inputRate, outputRate, quality);
+                    const auto input = makeSine (2, 8192, 1000.0 / inputRate);
+
+                    resampler.prepare ({ inputRate, 512, 2 });
+                    AudioBuffer<float> output (2, resampler.getNumOutputSamplesFor (input.getNumSamples()));
+                    AudioBlock<float> outputBlock (output);
+                    expectEquals (resampler.process (AudioBlock<const float> (input), outputBlock), output.getNumSamples());
+
+                    const auto step = (double) resampler.getDownsamplingFactor() / resampler.getUpsamplingFactor();
+                    const auto latency = resampler.getLatencyInInputSamples();
+                    auto maxError = 0.0f;
+
+                    for (auto i = (int) (128.0 / step); i < output.getNumSamples(); ++i)
+                    {
+                        const auto expected = 0.5f * (float) std::sin (MathConstants<double>::twoPi * 1000.0 / inputRate * (i * step - latency));
+
+                        for (auto channel = 0; channel < 2; ++channel)
+                            maxError = jmax (maxError, std::abs (output.getSample (channel, i) - expected));
+                    }
+
+                    expectLessThan (Decibels::gainToDecibels (maxError / 0.5f), maxErrorDecibels);
+                }
+            }
+        }
+
+        beginTest ("Frequencies above the output Nyquist frequency are removed when downsampling");
+        {
+            for (auto [inputRate, outputRate, frequency] : { std::tuple (192000.0, 48000.0, 33600.0),
+                                                             std::tuple (96000.0, 44100.0, 24300.0),
+                                                             std::tuple (48000.0, 44100.0, 24300.0),
+                                                             std::tuple (96000.0, 32000.0, 18000.0) })
+            {
+                for (auto [quality, minAttenuationDecibels] : { std::pair (PolyphaseResampler::Quality::low,    60.0f),
+                                                                std::pair (PolyphaseResampler::Quality::medium, 90.0f),
+                                                                std::pair (PolyphaseResampler::Quality::high,   110.0f) })
+                {
+                    PolyphaseResampler resampler (inputRate, outputRate, quality);
+                    const auto input = makeSine (1, 32768, frequency / inputRate);
+
+                    resampler.prepare ({ inputRate, 4096, 1 });
+                    AudioBuffer<float> output (1, resampler.getNumOutputSamplesFor (input.getNumSamples()));
+                    AudioBlock<float> outputBlock (output);
+                    resampler.process (AudioBlock<const float> (input), outputBlock);
+
+                    // Skip the output that depends on the silence before the input started
+                    const auto start = (int) std::ceil (2.0 * resampler.getLatencyInInputSamples() * outputRate / inputRate);
+                    const auto level = output.getMagnitude (0, start, output.getNumSamples() - start);
+                    const auto attenuation = -Decibels::gainToDecibels (level / 0.5f, -200.0f);
+
+                    expectGreaterThan (attenuation, minAttenuationDecibels);
+                }
+            }
+        }
+
+        beginTest ("Output doesn't depend on the input block sizes");
+        {
+            const auto input = makeSine (1, 5000, 0.013);
+
+            PolyphaseResampler whole (44100.0, 48000.0), chunked (44100.0, 48000.0);
+            whole.prepare ({ 44100.0, 5000, 1 });
+            chunked.prepare ({ 44100.0, 64, 1 });
+
+            AudioBuffer<float> expected (1, whole.getNumOutputSamplesFor (input.getNumSamples()));
+            AudioBlock<float> expectedBlock (expected);
+            whole.process (AudioBlock<const float> (input), expectedBlock);
+
+            AudioBuffer<float> output (1, expected.getNumSamples());
+            Random random (1234);
+            int numRead = 0, numWritten = 0;
+
+            while (numRead < input.getNumSamples())
+            {
+                const auto numToRead = jmin (input.getNumSamples() - numRead, random.nextInt ({ 1, 300 }));
+                auto outputBlock = AudioBlock<float> (output).getSubBlock ((size_t) numWritten);
+                numWritten += chunked.process (AudioBlock<const float> (input).getSubBlock ((size_t) numRead, (size_t) numToRead), outputBlock);
+                numRead += numToRead;
+            }
+
+            expectEquals (numWritten, expected.getNumSamples());
+
+            for (auto i = 0; i < numWritten; ++i)
+                expectEquals (output.getSample (0, i), expected.getSample (0, i));
+        }
+
+        beginTest ("Audio source produces the requested number of samples");
+        {
+            const auto input = makeSine (2, 44100, 1000.0 / 44100.0);
+
+            PolyphaseResamplingAudioSource source (new MemoryAudioSource (const_cast<AudioBuffer<float>&> (input), true, true), true, 44100.0);
+            source.prepareToPlay (480, 48000.0);
+
+            AudioBuffer<float> output (2, 48000);
+
+            for (auto start = 0; start < output.getNumSamples();)
+            {
+                // Blocks that are larger than expected should be split up
+                const auto numSamples = jmin (output.getNumSamples() - start, start % 3 == 0 ? 1000 : 333);
+                source.getNextAudioBlock ({ &output, start, numSamples });
+                start += numSamples;
+            }
+
+            const auto latency = 48000.0 / 44100.0 * PolyphaseResampler (44100.0, 48000.0).getLatencyInInputSamples();
+            auto maxError = 0.0f;
+
+            for (auto i = 200; i < output.getNumSamples(); ++i)
+                maxError = jmax (maxError, std::abs (output.getSample (1, i) - 0.5f * (float) std::sin (MathConstants<double>::twoPi * 1000.0 / 48000.0 * (i - latency))));
+
+            expectLessThan (maxError, 1.0e-3f);
+        }
+
+        beginTest ("Throughput compared to ResamplingAudioSource");
+        {
+            const auto input = makeSine (2, 44100, 1000.0 / 44100.0);
+            constexpr int blockSize = 512, numSeconds = 10;
+
+            const auto timeSource = [&] (AudioSource& source)
+            {
+                source.prepareToPlay (blockSize, 48000.0);
+                AudioBuffer<float> output (2, blockSize);
+
+                const auto start = Time::getMillisecondCounterHiRes();
+
+                for (auto done = 0; done < 48000 * numSeconds; done += blockSize)
+                    source.getNextAudioBlock ({ &output, 0, blockSize });
+
+                source.releaseResources();
+                return (Time::getMillisecondCounterHiRes() - start) / numSeconds;
+            };
+
+            ResamplingAudioSource interpolating (new MemoryAudioSource (const_cast<AudioBuffer<float>&> (input), true, true), true, 2);
+            interpolating.setResamplingRatio (44100.0 / 48000.0);
+
+            const auto interpolatingTime = timeSource (interpolating);
+            String times;
+
+            for (auto quality : { PolyphaseResampler::Quality::low, PolyphaseResampler::Quality::medium, PolyphaseResampler::Quality::high })
+            {
+                PolyphaseResamplingAudioSource polyphase (new MemoryAudioSource (const_cast<AudioBuffer<float>&> (input), true, true), true, 44100.0, 2, quality);
+                times << " " << String (timeSource (polyphase), 2);
+            }
+
+            logMessage ("44.1 kHz to 48 kHz stereo, ms per second of audio: ResamplingAudioSource "
+                          + String (interpolatingTime, 2) + ", PolyphaseResamplingAudioSource (low, medium, high)" + times);
+        }
+    }
+
+private:
+    static AudioBuffer<float> makeSine (int numChannels, int numSamples, double cyclesPerSample)
+    {
+        AudioBuffer<float> result (numChannels, numSamples);
+
+        for (auto channel = 0; channel < numChannels; ++channel)
+            for (auto i = 0; i < numSamples; ++i)
+                result.setSample (channel, i, 0.5f * (float) std::sin (MathConstants<double>::twoPi * cyclesPerSample * i));
+
+        return result;
+    }
+};
+
+static PolyphaseResamplerTest polyphaseResamplerTest;
+
+} // namespace juce::dsp
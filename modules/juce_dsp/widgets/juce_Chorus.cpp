@@ -100,6 +100,7 @@ void Chorus<SampleType>::prepare (const ProcessSpec& spec)
 
     osc.prepare (spec);
     bufferDelayTimes.setSize (1, (int) spec.maximumBlockSize, false, false, true);
+    bufferDelayedSamples.setSize (1, (int) spec.maximumBlockSize, false, false, true);
 
     update();
     reset();
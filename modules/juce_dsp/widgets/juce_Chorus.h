@@ -118,22 +118,30 @@ public:
 
         dryWet.pushDrySamples (inputBlock);
 
+        // The modulated delay is never shorter than 1 ms, so within a chunk of that
+        // length all the delayed samples can be read before the feedback is pushed.
+        const auto chunkSize = (size_t) jmax (1, (int) (sampleRate / 1000.0));
+        auto* delayedSamples = bufferDelayedSamples.getWritePointer (0);
+
         for (size_t channel = 0; channel < numChannels; ++channel)
         {
             auto* inputSamples  = inputBlock .getChannelPointer (channel);
             auto* outputSamples = outputBlock.getChannelPointer (channel);
 
-            for (size_t i = 0; i < numSamples; ++i)
+            for (size_t start = 0; start < numSamples; start += chunkSize)
             {
-                auto input = inputSamples[i];
-                auto output = input - lastOutput[channel];
+                const auto numToDo = jmin (chunkSize, numSamples - start);
+
+                delay.popBlock ((int) channel, delayedSamples + start, delaySamples + start, (int) numToDo);
 
-                delay.pushSample ((int) channel, output);
-                delay.setDelay (delaySamples[i]);
-                output = delay.popSample ((int) channel);
+                for (size_t i = start; i < start + numToDo; ++i)
+                {
+                    delay.pushSample ((int) channel, inputSamples[i] - lastOutput[channel]);
 
-                outputSamples[i] = output;
-                lastOutput[channel] = output * feedbackVolume[channel].getNextValue();
+                    auto output = delayedSamples[i];
+                    outputSamples[i] = output;
+                    lastOutput[channel] = output * feedbackVolume[channel].getNextValue();
+                }
             }
         }
 
@@ -151,7 +159,7 @@ private:
     std::vector<SmoothedValue<SampleType, ValueSmoothingTypes::Linear>> feedbackVolume { 2 };
     DryWetMixer<SampleType> dryWet;
     std::vector<SampleType> lastOutput { 2 };
-    AudioBuffer<SampleType> bufferDelayTimes;
+    AudioBuffer<SampleType> bufferDelayTimes, bufferDelayedSamples;
 
     double sampleRate = 44100.0;
     SampleType rate = 1.0, depth = 0.25, feedback = 0.0, mix = 0.5,